@@ -42,17 +42,52 @@ def extract_list(file_path, list_name):
         return words
 
 
-def write_header(data_map, output_file):
+def write_string_array(f, name, items):
+    f.write(f"static const char *{name}[] = {{\n")
+    for item in items:
+        f.write(f'    "{item}",\n')
+    f.write("};\n\n")
+    f.write(f"static const int {name}_count = {len(items)};\n\n")
+
+
+def write_packed_array(f, name, items):
+    # Words are concatenated into one blob (no separators) with parallel
+    # offset and length tables, so callers can memcpy without strlen.
+    # The blob is a char initializer list because a single string literal
+    # would exceed the 4095 characters C99 compilers must support.
+    blob = "".join(items)
+    f.write(f"static const char {name}_blob[] = {{\n")
+    for i in range(0, len(blob), 16):
+        chars = ", ".join(f"'{c}'" for c in blob[i : i + 16])
+        f.write(f"    {chars},\n")
+    f.write("};\n\n")
+
+    f.write(f"static const unsigned int {name}_offsets[] = {{\n")
+    offset = 0
+    for item in items:
+        f.write(f"    {offset},\n")
+        offset += len(item)
+    f.write("};\n\n")
+
+    f.write(f"static const unsigned char {name}_len[] = {{\n")
+    for item in items:
+        f.write(f"    {len(item)},\n")
+    f.write("};\n\n")
+
+    f.write(f"static const int {name}_count = {len(items)};\n\n")
+    f.write(f"#define {name.upper()}_MAX_LEN {max(len(i) for i in items)}\n\n")
+
+
+def write_header(data_map, packed_map, output_file):
     with open(output_file, "w") as f:
         f.write("#ifndef FAKER_DATA_H\n")
         f.write("#define FAKER_DATA_H\n\n")
 
         for name, items in data_map.items():
-            f.write(f"static const char *{name}[] = {{\n")
-            for item in items:
-                f.write(f'    "{item}",\n')
-            f.write("};\n\n")
-            f.write(f"static const int {name}_count = {len(items)};\n\n")
+            write_string_array(f, name, items)
+
+        for name, items in packed_map.items():
+            write_packed_array(f, name, items)
 
         f.write("#endif // FAKER_DATA_H\n")
 
@@ -70,11 +105,13 @@ if __name__ == "__main__":
         "faker_first_names_male": first_names_male,
         "faker_first_names_female": first_names_female,
         "faker_last_names": last_names,
+    }
+    packed = {
         "faker_words": words,
     }
 
     output_path = "src/faker_data.h"
-    write_header(data, output_path)
+    write_header(data, packed, output_path)
     print(
         f"Generated {output_path} with {len(first_names_male)} male names, {len(first_names_female)} female names, {len(last_names)} last names, and {len(words)} words."
     )
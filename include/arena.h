@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Chunked bump allocator for message text.
+// Strings are carved out of large chunks and released all at once.
+typedef struct ArenaChunk ArenaChunk;
+
+typedef struct {
+    ArenaChunk *head;      // Current chunk (chunks are linked newest first)
+    size_t chunk_size;     // Default size of new chunks
+    int node;              // NUMA node for new chunks, -1 for any
+} TextArena;
+
+// Initialize an empty arena. chunk_size of 0 selects a default.
+void text_arena_init(TextArena *arena, size_t chunk_size);
+
+// Return a buffer with at least max_len writable bytes. The space is not
+// claimed until text_arena_commit is called with the number of bytes used.
+char *text_arena_reserve(TextArena *arena, size_t max_len);
+void text_arena_commit(TextArena *arena, size_t used);
+
+// Move every chunk of src into arena, leaving src empty. Strings keep
+// their addresses, so per-thread arenas can be joined after a parallel pass.
+void text_arena_merge(TextArena *arena, TextArena *src);
+
+// Forget all strings but keep the newest chunk for reuse
+void text_arena_reset(TextArena *arena);
+
+// Release every chunk
+void text_arena_free(TextArena *arena);
+
+// Chunk capacity held by all arenas together
+size_t text_arena_total_bytes(void);
+
+#endif // ARENA_H
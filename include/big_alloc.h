@@ -0,0 +1,45 @@
+#ifndef BIG_ALLOC_H
+#define BIG_ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocation layer for the large per-message arrays (messages, sort keys
+// and permutations, thread index, text arena chunks).
+// Blocks of BIG_ALLOC_MIN_BYTES or more are anonymous mmap regions aligned
+// to huge pages, so the random-access threading and sort passes take far
+// fewer TLB misses. If anonymous memory cannot be mapped, the block is
+// backed by an unlinked temporary file instead and the kernel pages it to
+// disk. Smaller blocks use malloc. Failure is fatal.
+// Under --numa, mapped blocks are interleaved over the nodes unless a node
+// is given (see numa.h).
+
+#define BIG_ALLOC_MIN_BYTES (2u << 20)
+#define BIG_ALLOC_PAGE_SIZE ((size_t)2 << 20)
+
+typedef enum {
+    BIG_PAGES_TRANSPARENT,  // madvise(MADV_HUGEPAGE) on mapped blocks (default)
+    BIG_PAGES_EXPLICIT,     // MAP_HUGETLB from the reserved pool, else transparent
+    BIG_PAGES_OFF           // Plain mappings with base pages
+} BigPages;
+
+// Select the page mode and the directory for file-backed fallbacks.
+// Call before the first allocation; dir must outlive all allocations.
+void big_alloc_configure(BigPages mode, const char *fallback_dir);
+
+// Parse "transparent", "explicit" or "off". Returns 0 on success.
+int big_pages_parse(const char *arg, BigPages *mode);
+
+// count elements of size bytes; at least one element is allocated
+void *big_alloc(int64_t count, size_t size);
+
+// big_alloc with the mapped pages placed on a NUMA node
+void *big_alloc_on_node(int64_t count, size_t size, int node);
+
+// Zeroed counterpart of big_alloc
+void *big_calloc(int64_t count, size_t size);
+
+// Release a block from big_alloc or big_calloc (NULL is ignored)
+void big_free(void *ptr);
+
+#endif // BIG_ALLOC_H
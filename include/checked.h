@@ -0,0 +1,59 @@
+#ifndef CHECKED_H
+#define CHECKED_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Overflow-checked size arithmetic for allocations sized by entity counts.
+// Overflow and allocation failure are fatal, as everywhere else in syngen.
+
+static inline size_t checked_mul(size_t a, size_t b) {
+    if (b != 0 && a > SIZE_MAX / b) {
+        fprintf(stderr, "Error: Size overflow (%zu * %zu)\n", a, b);
+        exit(1);
+    }
+    return a * b;
+}
+
+static inline size_t checked_add(size_t a, size_t b) {
+    if (a > SIZE_MAX - b) {
+        fprintf(stderr, "Error: Size overflow (%zu + %zu)\n", a, b);
+        exit(1);
+    }
+    return a + b;
+}
+
+// Convert a non-negative entity count to size_t
+static inline size_t checked_count(int64_t count) {
+    if (count < 0 || (uint64_t)count > SIZE_MAX) {
+        fprintf(stderr, "Error: Invalid count %lld\n", (long long)count);
+        exit(1);
+    }
+    return (size_t)count;
+}
+
+// malloc for count elements of size bytes. At least one element is
+// allocated, so a zero count still yields a valid pointer.
+static inline void *checked_alloc(int64_t count, size_t size) {
+    size_t n = checked_count(count);
+    void *p = malloc(checked_mul(n > 0 ? n : 1, size));
+    if (!p) {
+        fprintf(stderr, "Error: Out of memory allocating %zu x %zu bytes\n", n, size);
+        exit(1);
+    }
+    return p;
+}
+
+// calloc counterpart of checked_alloc
+static inline void *checked_calloc(int64_t count, size_t size) {
+    size_t n = checked_count(count);
+    void *p = calloc(n > 0 ? n : 1, size);
+    if (!p) {
+        fprintf(stderr, "Error: Out of memory allocating %zu x %zu bytes\n", n, size);
+        exit(1);
+    }
+    return p;
+}
+
+#endif // CHECKED_H
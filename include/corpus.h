@@ -0,0 +1,34 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Longest text slice taken from a corpus unit (Slack's own message limit)
+#define CORPUS_MAX_UNIT_LEN 40000
+
+// How the corpus is split into message bodies
+typedef enum {
+    CORPUS_LINES,      // One message per non-empty line
+    CORPUS_SENTENCES   // One message per sentence (split after . ! ? or newline)
+} CorpusUnit;
+
+// Memory-mapped text corpus with an index of its units.
+// Samples are slices into the mapping: not NUL-terminated, never copied.
+typedef struct {
+    const char *data;      // Read-only mapping of the whole file
+    size_t size;
+    uint64_t *starts;      // Byte offset of each unit
+    uint32_t *lengths;     // Byte length of each unit
+    uint64_t count;
+} Corpus;
+
+// Map path and index it. Returns 0 on success, -1 on error (reported on stderr).
+int corpus_open(Corpus *corpus, const char *path, CorpusUnit unit);
+
+// Return unit idx (idx < count) as a slice of the mapping
+const char *corpus_unit(const Corpus *corpus, uint64_t idx, size_t *len);
+
+void corpus_close(Corpus *corpus);
+
+#endif // CORPUS_H
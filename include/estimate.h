@@ -0,0 +1,39 @@
+#ifndef ESTIMATE_H
+#define ESTIMATE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "generator.h"
+#include "export_manager.h"
+
+// Dry-run prediction of a run's output and resources (--estimate).
+// A scaled-down sample keeps the messages per channel of the real run and
+// goes through the real generator and export pipeline, measuring instead
+// of writing. It calibrates bytes per user, channel and message, the
+// compression ratios and the generation and export rates. File counts
+// follow analytically from the Gaussian channel choice and the calendar
+// days in the time window; channel sizes from the member count model.
+
+typedef struct {
+    int64_t users;
+    int64_t channels;
+    int64_t messages;
+    const ConversationModel *model;
+    size_t max_memory;          // Spill budget as given to --max-memory, 0 for none
+    bool unpacked;
+    unsigned long long seed;
+    FILE *log;                  // Where to note each sample taken (NULL = nowhere)
+} EstimateParams;
+
+// Run the sample and print the estimate to out
+void estimate_print(const EstimateParams *params, FILE *out);
+
+// Messages for an output of target->bytes: uncompressed JSON, or the
+// archive if target->archive is set. params->messages is the first guess.
+// Fills in target->message_bytes and target->profile. Returns -1 if the
+// users and channels alone take more.
+int64_t estimate_messages_for(const EstimateParams *params, ExportTarget *target);
+
+#endif // ESTIMATE_H
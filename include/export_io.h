@@ -0,0 +1,74 @@
+#ifndef EXPORT_IO_H
+#define EXPORT_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// File output for the exporter.
+// The export root is held open as a directory descriptor and every file is
+// created relative to an open directory with openat, so the kernel resolves
+// one path component per file instead of the whole path.
+// Writes are copied into a fixed pool of EXPORT_IO_SLOTS staging buffers
+// and completed asynchronously, so the serialising thread only waits when
+// every buffer is in flight. Closes are deferred until a file's writes are
+// done.
+
+// Size of one staging buffer; streamed files are handed over in pieces of
+// about this size
+#define EXPORT_IO_BUFFER (64 * 1024)
+// Staging buffers, and so the bound on writes in flight
+#define EXPORT_IO_SLOTS 64
+// Workers in the pwrite pool
+#define EXPORT_IO_WORKERS 4
+
+typedef enum {
+    EXPORT_IO_AUTO,     // io_uring when the kernel supports it, else threads
+    EXPORT_IO_URING,    // io_uring with registered buffers
+    EXPORT_IO_THREADS,  // pwrite on a pool of worker threads
+    EXPORT_IO_SYNC      // write and close on the calling thread
+} ExportIoBackend;
+
+typedef struct ExportWriter ExportWriter;
+typedef struct ExportFile ExportFile;
+
+typedef struct {
+    const char *path;       // Root path as given, used by the archive step
+    int fd;                 // O_DIRECTORY descriptor of the root
+    bool sync;              // fsync files and directories before closing them
+    ExportWriter *writer;
+} ExportDir;
+
+// Create (if needed) and open the export root. EXPORT_IO_AUTO and
+// EXPORT_IO_URING fall back to the thread pool if io_uring is unavailable.
+// Returns 0 on success.
+int export_dir_open(ExportDir *dir, const char *path, bool sync, ExportIoBackend backend);
+// Wait for every outstanding write and close, then close the root.
+// Returns 0, or the errno of the first file creation, write, fsync or
+// close that failed; later writes are dropped once one has.
+int export_dir_close(ExportDir *dir);
+
+// Backend in use after export_dir_open ("io_uring", "threads" or "sync")
+const char *export_io_backend_name(const ExportDir *dir);
+
+// Parse "auto", "uring", "threads" or "sync". Returns 0 on success.
+int export_io_backend_parse(const char *arg, ExportIoBackend *backend);
+
+// Create a directory under dir_fd; an existing one is kept
+void export_mkdir(int dir_fd, const char *name);
+
+// Open the directory name under dir_fd. Returns -1 on failure.
+int export_subdir_open(int dir_fd, const char *name);
+void export_subdir_close(const ExportDir *dir, int fd);
+
+// Create or truncate name under dir_fd for writing. Returns NULL on
+// failure, which export_dir_close reports.
+ExportFile *export_file_create(ExportDir *dir, int dir_fd, const char *name);
+
+// Append data to the file. The bytes are copied, so the caller may reuse
+// its buffer at once. A NULL file is ignored.
+void export_file_write(ExportDir *dir, ExportFile *file, const char *data, size_t len);
+
+// Close the file once its writes have completed. A NULL file is ignored.
+void export_file_close(ExportDir *dir, ExportFile *file);
+
+#endif // EXPORT_IO_H
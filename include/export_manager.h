@@ -1,21 +1,102 @@
 #ifndef EXPORT_MANAGER_H
 #define EXPORT_MANAGER_H
 
+#include <stdio.h>
 #include "models.h"
+#include "ids.h"
+#include "export_io.h"
 
-// Initialize the export directory
-void export_init(const char *base_path);
+// Points on the size profile of a run, at even shares of its messages
+#define EXPORT_PROFILE_POINTS 64
 
-// Write users.json
-void export_write_users(const char *base_path, const User *users, int count);
+// What a dry run would have written (see ExportOptions.measure)
+typedef struct {
+    int64_t files;              // Files, not counting channel directories
+    uint64_t user_bytes;        // Uncompressed users.json
+    uint64_t channel_bytes;     // Uncompressed channels.json
+    uint64_t message_bytes;     // Uncompressed channel-day files
+    uint64_t user_packed;       // Deflated sizes of the same (0 when unpacked)
+    uint64_t channel_packed;
+    uint64_t message_packed;
+    size_t buffer_bytes;        // Piece buffers the pipeline grew to
+    size_t pieces;              // Pieces in flight at most
+    int64_t piece_channels;     // Channels rendered per channels.json piece
+    // Channel-day file bytes, uncompressed and as archive members with
+    // their headers, once share i / EXPORT_PROFILE_POINTS of the messages
+    // is stored. Files are written channel by channel, and a channel's
+    // cost per message depends on how busy its days are.
+    double raw_profile[EXPORT_PROFILE_POINTS + 1];
+    double packed_profile[EXPORT_PROFILE_POINTS + 1];
+} ExportSizes;
 
-// Write channels.json
-void export_write_channels(const char *base_path, const Channel *channels, int count);
+// Output size to land on (see ExportOptions.target). The source yields
+// somewhat more messages than needed; whole threads are dropped as they
+// stream past, at a rate steered by the sizes the writer has stored.
+typedef struct {
+    uint64_t bytes;             // Size to reach
+    bool archive;               // bytes is the ZIP file, not the JSON inside
+    double keep;                // Share of messages to keep until sizes come back
+    double message_bytes;       // Channel-day file bytes if every message is kept
+    // Share of message_bytes reached at each share of the messages read,
+    // as in ExportSizes
+    double profile[EXPORT_PROFILE_POINTS + 1];
+    uint64_t reached;           // Set by export_write: the size written
+} ExportTarget;
 
-// Write messages to channel/YYYY-MM-DD.json
-void export_write_messages(const char *base_path, const Message *messages, int count, const Channel *channels, int channel_count);
+// Receiver of the rendered files in place of the disk (see
+// ExportOptions.files). Files arrive one after another in output order,
+// each as one or more chunks of uncompressed JSON; paths are relative to
+// the export root, e.g. "general/2024-05-01.json". A non-zero return
+// stops the export.
+typedef struct {
+    void *ctx;
+    int (*begin)(void *ctx, const char *path);
+    int (*data)(void *ctx, const char *data, size_t len);
+    int (*end)(void *ctx);
+} ExportFileSink;
 
-// Create the ZIP archive
-void export_finalize(const char *base_path, const char *output_filename);
+typedef struct {
+    const char *output;         // Archive path, or the directory when unpacked
+    bool unpacked;              // Write the files into a directory, not a ZIP
+    bool sync;                  // fsync every file written
+    ExportIoBackend io;         // How files are written (see export_io.h)
+    int workers;                // Serialising and compressing threads each
+    int64_t message_count;      // Messages the source yields, for progress
+    ExportSizes *measure;       // If set, count sizes here and write nothing
+    const ExportFileSink *files; // If set, hand the files here instead of output
+    ExportTarget *target;       // If set, thin the messages to reach a size
+    FILE *log;                  // Where to announce the export (NULL = nowhere)
+} ExportOptions;
+
+// Source of messages already in (channel, day, ts) order. Fills *out and
+// returns true, or returns false once the messages are exhausted.
+// out and the memory it points to need only stay valid until the next call.
+typedef bool (*MessageSource)(void *source, StreamedMessage *out);
+
+// Write users.json, channels.json and one channel/YYYY-MM-DD.json file per
+// channel and day, reading the messages from next. User IDs are derived
+// from user indices on the fly.
+// The work runs as a pipeline: this thread cuts the messages into batches,
+// serialiser threads render them to JSON, compressor threads deflate them
+// and a writer thread appends them to the archive in order. Memory stays
+// bounded by a fixed pool of batches. Returns 0 on success, -1 if the
+// output cannot be opened or written, or the file sink stopped the export.
+int export_write(const ExportOptions *opts, const User *users, int64_t user_count, const Channel *channels, int64_t channel_count, const IdKeys *ids, MessageSource next, void *source);
+
+// In-memory messages as a MessageSource
+typedef struct {
+    const Message *messages;
+    const ThreadIndex *threads;
+    int64_t *order;             // Message indices in (channel, ts) order
+    int64_t count;
+    int64_t next;
+    ReplyRef *replies;          // Reply list of the last message returned
+    size_t reply_capacity;
+} SortedMessages;
+
+// Sort messages by channel, then timestamp, using workers threads
+void sorted_messages_init(SortedMessages *sorted, const Message *messages, int64_t count, const ThreadIndex *threads, int workers);
+bool sorted_messages_next(void *sorted, StreamedMessage *out);
+void sorted_messages_free(SortedMessages *sorted);
 
 #endif // EXPORT_MANAGER_H
@@ -4,26 +4,56 @@
 #include <stdlib.h>
 #include <time.h>
 #include "models.h"
+#include "arena.h"
+#include "vocab.h"
+#include "corpus.h"
+#include "rng.h"
 
-// Initialize random seed
-void faker_init();
+// All generators draw from an explicit Rng, so callers control seeding and
+// can give each thread its own stream.
 
-// ID Generation
-void faker_get_id(char *buffer, const char *prefix); // Generates U... or C...
-void faker_get_uuid(char *buffer); // Generates a full UUID if needed (or just long random string)
+// ID Generation (user and channel IDs come from ids.h)
+void faker_get_uuid(Rng *rng, char *buffer); // Generates a UUID v4 (buffer of 37 bytes)
+
+// Where message text comes from. Both must outlive all messages.
+typedef struct {
+    const Vocabulary *vocab;    // Words for sentences (NULL = built-in list)
+    const Corpus *corpus;       // Bodies to sample instead (NULL = sentences)
+} TextSource;
 
 // Text Generation
-char *faker_lorem_word();
-char *faker_lorem_sentence(int min_words, int max_words);
-char *faker_lorem_paragraph(int min_sentences, int max_sentences);
+char *faker_lorem_word(Rng *rng);
+char *faker_lorem_sentence(Rng *rng, int min_words, int max_words);
+char *faker_lorem_paragraph(Rng *rng, int min_sentences, int max_sentences);
+
+// Buffer size (including NUL) that always fits a sentence or paragraph
+size_t faker_lorem_sentence_max_len(int max_words);
+size_t faker_lorem_paragraph_max_len(int max_sentences);
+
+// Assemble text into a caller-provided buffer. Output is truncated at a word
+// boundary to fit capacity. Returns the length written, excluding the NUL.
+size_t faker_lorem_sentence_into(Rng *rng, char *buffer, size_t capacity, int min_words, int max_words);
+size_t faker_lorem_paragraph_into(Rng *rng, char *buffer, size_t capacity, int min_sentences, int max_sentences);
+
+// Assemble a sentence directly into arena memory
+char *faker_lorem_sentence_arena(Rng *rng, TextArena *arena, int min_words, int max_words);
+
+// Text for one message: a zero-copy corpus slice (not NUL-terminated) when
+// source has a corpus, otherwise a sentence of source's words assembled
+// into the arena.
+const char *faker_message_text(Rng *rng, const TextSource *source, TextArena *arena, int min_words, int max_words, size_t *len);
+
+// User Generation (everything but the ID). The username is first.last and
+// is not guaranteed unique; generate_users resolves duplicates.
+void faker_create_user(Rng *rng, User *user);
 
-// User Generation
-void faker_create_user(User *user);
+// Derive the email address from the username
+void faker_set_user_email(User *user);
 
-// Channel Generation
-void faker_create_channel(Channel *channel, const char *creator_id);
+// Channel Generation (everything but the ID and members)
+void faker_create_channel(Rng *rng, Channel *channel, int64_t creator_idx);
 
 // Timestamp Generation
-double faker_get_timestamp(time_t start_time, time_t end_time);
+double faker_get_timestamp(Rng *rng, time_t start_time, time_t end_time);
 
 #endif // FAKER_H
@@ -2,21 +2,106 @@
 #define GENERATOR_H
 
 #include "models.h"
+#include "arena.h"
+#include "rng.h"
+#include "ids.h"
+#include "faker.h"
 
-// Generate N users
-User *generate_users(int count);
+// Thread size distributions
+typedef enum {
+    THREAD_SIZE_POWERLAW,   // Pareto tail with exponent size_alpha
+    THREAD_SIZE_LOGNORMAL   // exp(N(size_mu, size_sigma))
+} ThreadSizeDist;
+
+// Delay between consecutive replies in a thread
+typedef enum {
+    REPLY_DELAY_EXPONENTIAL, // Mean delay_mean seconds
+    REPLY_DELAY_LOGNORMAL    // exp(N(delay_mu, delay_sigma)) seconds
+} ReplyDelayDist;
+
+// Conversation model used by the threading pass
+typedef struct {
+    double reply_prob;        // Chance a message replies to a due open thread
+    double start_prob;        // Chance a top-level message opens a thread
+    int max_open_threads;     // Concurrent open threads per channel
+    ThreadSizeDist size_dist;
+    double size_alpha;
+    double size_mu;
+    double size_sigma;
+    int max_thread_size;      // Upper bound on drawn thread sizes
+    ReplyDelayDist delay_dist;
+    double delay_mean;
+    double delay_mu;
+    double delay_sigma;
+    double max_idle;          // Seconds without a reply before a thread closes
+    double starter_bias;      // Zipf exponent favouring low-index users as thread starters (0 = uniform)
+    int workers;              // Threads used for the per-channel pass
+    TextSource text;          // What the messages say
+} ConversationModel;
+
+// Fill in the default conversation model
+void conversation_model_defaults(ConversationModel *model);
+
+// Target number of replies for a newly opened thread
+int conversation_thread_size(const ConversationModel *model, Rng *rng);
+
+// Seconds until a thread is ready for its next reply
+double conversation_reply_delay(const ConversationModel *model, Rng *rng);
+
+// Thread-starter bias: weight user k by (k + 1)^-bias, normalised so the
+// average weight is 1 and start_prob keeps its meaning. The caller frees
+// the array.
+double *conversation_starter_weights(const ConversationModel *model, int64_t user_count);
+
+// Generate N users; user i gets the ID derived from index i
+User *generate_users(Rng *rng, int64_t count, const IdKeys *ids);
 
 // Generate N channels, assigning creators and members from the user list
-Channel *generate_channels(int count, const User *users, int user_count);
+Channel *generate_channels(Rng *rng, int64_t count, int64_t user_count, const IdKeys *ids);
 
 // Generate M messages, distributed across channels and users
 // Returns an array of messages. The caller must free it.
 // The messages are sorted by timestamp if possible, or we sort later.
-Message *generate_messages(int count, const Channel *channels, int channel_count, const User *users, int user_count, double thread_prob);
+// Message text is allocated from text_arena, which the caller releases, or
+// points into model->text.corpus.
+Message *generate_messages(Rng *rng, int64_t count, const Channel *channels, int64_t channel_count, int64_t user_count, const ConversationModel *model, TextArena *text_arena);
+
+// Rough peak bytes per message of generate_messages plus the export sort,
+// text included, for deciding when to spill
+#define GENERATOR_BYTES_PER_MESSAGE 224
+
+// Messages generated under a memory budget
+typedef struct MessageSpill MessageSpill;
+
+// Generate M messages without holding them all in memory. Compact records
+// are spilled to sorted runs in spill_dir and merged in (channel, ts) order,
+// threading each channel as it streams past; replies are spilled again
+// keyed by their parent. Text is regenerated from a per-message seed when
+// read back. memory bounds the sort buffers. Returns NULL on failure.
+MessageSpill *generate_messages_spilled(Rng *rng, int64_t count, const Channel *channels, int64_t channel_count, int64_t user_count, const ConversationModel *model, size_t memory, const char *spill_dir);
+
+// Read the next message in (channel, day, ts) order. The message, its text
+// and its replies stay valid until the next call. Returns false at the end.
+bool message_spill_next(MessageSpill *spill, StreamedMessage *out);
+
+// Number of sorted runs written to disk
+size_t message_spill_runs(const MessageSpill *spill);
+
+// Peak disk space generate_messages_spilled takes for this many messages
+// and replies, reached when the threading pass ends
+uint64_t message_spill_disk_bytes(int64_t messages, int64_t replies);
+
+void message_spill_free(MessageSpill *spill);
+
+// Build the compressed sparse row thread index from the parent_idx links
+// set by generate_messages. Release it with free_thread_index.
+void generate_thread_index(const Message *messages, int64_t count, ThreadIndex *threads);
+
+void free_thread_index(ThreadIndex *threads);
 
-void free_users(User *users, int count);
-void free_channels(Channel *channels, int count);
-// Messages array is a single block, but text is dynamic
-void free_messages(Message *messages, int count);
+void free_users(User *users, int64_t count);
+void free_channels(Channel *channels, int64_t count);
+// Messages array is a single block; text is freed with its arena
+void free_messages(Message *messages, int64_t count);
 
 #endif // GENERATOR_H
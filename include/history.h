@@ -0,0 +1,81 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include <time.h>
+#include "models.h"
+#include "generator.h"
+#include "arena.h"
+
+// Channel histories addressable by position, for the API emulator.
+// Nothing is stored per message. Each channel's top-level messages are cut
+// into blocks of HISTORY_BLOCK, and each block owns an even share of the
+// time window. A block's timestamps come from its own seed. Everything
+// else about a message comes from a seed derived from its position: the
+// author, the text and the whole thread. A thread is drawn from the
+// model's size and delay distributions, and ends early when a delay
+// exceeds max_idle or passes the end of the window. Any message can be
+// produced at any time, whatever the message count.
+//
+// Unlike the export generator, threads are not interleaved with
+// top-level traffic. So reply_prob plays no part, and max_open_threads
+// only matters if it is 0.
+
+#define HISTORY_BLOCK 256
+
+typedef struct {
+    const Channel *channels;
+    int64_t channel_count;
+    const ConversationModel *model;
+    uint64_t block_seed;        // Timestamps of each block
+    uint64_t message_seed;      // Author, text and thread of each message
+    int64_t start_us, end_us;   // Time window in microseconds
+    int64_t *offsets;           // Top-level messages before each channel, channel_count + 1
+    double *starter_weight;     // By user
+    double replies_per_message; // Expected replies per top-level message
+} History;
+
+// One top-level message with its thread
+typedef struct {
+    Message msg;                // Text in the reader's arena
+    const ReplyRef *replies;    // msg.reply_count replies in timestamp order
+    const uint64_t *reply_seeds; // Text seed of each reply
+} HistoryMessage;
+
+// Per-thread scratch state. Pages read consecutive positions, so the last
+// block's timestamps are kept.
+typedef struct {
+    int64_t channel;
+    int64_t block;              // -1 when nothing is cached
+    int64_t ts[HISTORY_BLOCK];
+    ReplyRef *replies;
+    uint64_t *reply_seeds;
+    size_t reply_capacity;
+    TextArena arena;            // Message text, until the caller resets it
+} HistoryReader;
+
+// Lay out about messages messages, replies included, over the channels in
+// the 30 days before now. The split between top-level messages and replies
+// is calibrated by drawing sample threads.
+void history_init(History *h, uint64_t seed, int64_t messages, const Channel *channels, int64_t channel_count,
+                  int64_t user_count, const ConversationModel *model, time_t now);
+void history_free(History *h);
+
+// Top-level messages of a channel, and of all channels
+int64_t history_count(const History *h, int64_t channel);
+int64_t history_total(const History *h);
+
+void history_reader_init(HistoryReader *r);
+void history_reader_free(HistoryReader *r);
+
+// Number of the channel's messages timestamped before ts_us
+int64_t history_rank(const History *h, HistoryReader *r, int64_t channel, int64_t ts_us);
+
+// The message at pos (0 is the oldest) with its thread. The replies stay
+// valid until the next call.
+void history_get(const History *h, HistoryReader *r, int64_t channel, int64_t pos, HistoryMessage *out);
+
+// Reply k of a thread from history_get, as a message
+void history_reply(const History *h, HistoryReader *r, const HistoryMessage *parent, int64_t k, Message *out);
+
+#endif // HISTORY_H
@@ -0,0 +1,40 @@
+#ifndef IDS_H
+#define IDS_H
+
+#include <stdint.h>
+
+// Slack-style IDs: a one-letter prefix plus 10 base-36 characters
+#define ID_SUFFIX_LEN 10
+#define ID_SPACE 3656158440062976ULL // 36^10
+#define ID_FEISTEL_ROUNDS 8
+
+// Key for one ID namespace (users, channels, ...).
+// IDs are the entity index passed through a keyed Feistel permutation of
+// [0, 36^10), so they look random, are unique by construction, and can be
+// recomputed from the index at any time.
+typedef struct {
+    uint64_t round_keys[ID_FEISTEL_ROUNDS];
+} IdKey;
+
+typedef struct {
+    IdKey user;
+    IdKey channel;
+} IdKeys;
+
+void id_key_init(IdKey *key, uint64_t seed, uint64_t tweak);
+void id_keys_init(IdKeys *keys, uint64_t seed);
+
+// Permute index (< ID_SPACE) within [0, ID_SPACE)
+uint64_t id_permute(const IdKey *key, uint64_t index);
+
+// Inverse of id_permute
+uint64_t id_unpermute(const IdKey *key, uint64_t value);
+
+// Index of the entity whose ID is id (prefix + 10 characters + NUL), or -1
+// if id is not in key's format. The index may exceed the entity count.
+int64_t id_parse(const IdKey *key, char prefix, const char *id);
+
+// Write prefix + 10 characters + NUL (12 bytes) for the entity at index
+void id_format(const IdKey *key, char prefix, uint64_t index, char *out);
+
+#endif // IDS_H
@@ -0,0 +1,51 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define JSON_WRITER_MAX_DEPTH 32
+
+// Streaming JSON serialiser into a growable buffer.
+// Output is byte-for-byte identical to cJSON_Print: objects put one member
+// per line indented with tabs, and array elements are separated by ", ".
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    int depth;
+    bool is_array[JSON_WRITER_MAX_DEPTH];  // Container kind per nesting level
+    bool is_empty[JSON_WRITER_MAX_DEPTH];  // No member written yet at this level
+} JsonWriter;
+
+void json_writer_init(JsonWriter *w, size_t initial_cap);
+// Drop the contents but keep the buffer for reuse
+void json_writer_reset(JsonWriter *w);
+// Drop the contents but keep the nesting state, so a long document can be
+// written out in pieces
+void json_writer_drain(JsonWriter *w);
+void json_writer_free(JsonWriter *w);
+
+void json_begin_object(JsonWriter *w);
+void json_end_object(JsonWriter *w);
+void json_begin_array(JsonWriter *w);
+// Reopen an array whose opening bracket and first elements were written
+// to an earlier buffer, so the next element starts with a separator
+void json_continue_array(JsonWriter *w);
+void json_end_array(JsonWriter *w);
+
+// Start an object member; the next call writes its value
+void json_key(JsonWriter *w, const char *key);
+
+// Values (object member values or array elements)
+void json_string(JsonWriter *w, const char *s, size_t len);
+void json_cstring(JsonWriter *w, const char *s);
+void json_int(JsonWriter *w, long long value);
+void json_bool(JsonWriter *w, bool value);
+
+// Offset of the first byte in s[0..len) that needs escaping in a JSON
+// string (quote, backslash or control byte), or len if there is none.
+// Uses AVX2 or SSE2 when the CPU supports them.
+size_t json_escape_scan(const char *s, size_t len);
+
+#endif // JSON_WRITER_H
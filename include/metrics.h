@@ -0,0 +1,45 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+
+// Prometheus text-format metrics for long-running jobs.
+// Counters come from the progress counters (progress.h); gauges are read
+// when metrics are rendered, from callbacks that modules register while
+// the thing they measure exists; histograms are filled with atomic adds.
+// A metrics thread rewrites a file every second (through a temporary file
+// and rename, as the node_exporter textfile collector expects) and/or
+// answers HTTP scrapes on a loopback port.
+
+typedef enum {
+    METRICS_FILE_BYTES,         // Uncompressed size of each exported file
+    METRICS_SERIALISE_NS,       // Time to serialise one piece
+    METRICS_HISTOGRAMS
+} MetricsHistogram;
+
+// Gauge reader, called from the metrics thread with the registered ctx
+typedef int64_t (*MetricsGaugeFn)(void *ctx);
+
+// Start the metrics thread. path (or NULL) is rewritten periodically;
+// port (or 0) is served on 127.0.0.1. Call after progress_start. Returns
+// 0 on success, -1 if the file or the port cannot be used.
+int metrics_start(const char *path, int port);
+
+// Write the file one last time and stop the thread
+void metrics_stop(void);
+
+// Add a gauge named name with labels, e.g. "queue=\"render\"" (or "").
+// Both strings are copied.
+void metrics_gauge_add(const char *name, const char *labels, MetricsGaugeFn read, void *ctx);
+
+// Remove every gauge registered with ctx
+void metrics_gauge_remove(const void *ctx);
+
+// Timestamp in nanoseconds for METRICS_SERIALISE_NS, 0 while metrics are
+// off or progress is paused
+int64_t metrics_clock(void);
+
+// Count value in histogram, unless progress is paused
+void metrics_observe(MetricsHistogram histogram, int64_t value);
+
+#endif // METRICS_H
@@ -2,6 +2,8 @@
 #define MODELS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <time.h>
 
 // User Model
@@ -20,33 +22,50 @@ typedef struct {
     char id[12];           // C02TZQX58FJ
     char name[64];         // general
     long created;          // timestamp
-    char creator[12];      // User ID
-    char **members;        // Array of User IDs
-    int member_count;
+    int64_t creator_idx;   // Index into the users array
+    int64_t *member_idx;   // Indices into the users array (creator first)
+    int64_t member_count;
 } Channel;
 
 // Message Model
+// Users and channels are referenced by index; their IDs are derived from
+// the index when the message is written (see ids.h).
 typedef struct {
-    char user[12];
-    double ts;
-} ReplyInfo;
-
-typedef struct {
-    char user[12];         // User ID
-    char channel[12];      // Channel ID (Internal use for grouping)
-    char type[16];         // message
     double ts;             // 1756191830.368749
-    char *text;            // Dynamic text content
+    const char *text;      // Text content, not necessarily NUL-terminated
+    size_t text_len;       // Length of text in bytes
+    int64_t user_idx;      // Index into the users array
+    int64_t channel_idx;   // Index into the channels array
     
     // Threading
     double thread_ts;      // Parent timestamp (if 0, not a thread/reply)
-    char parent_user_id[12]; // Only for replies
+    int64_t parent_idx;    // Index of the parent message (-1 if not a reply)
     
     // Parent metadata (if this message is a parent)
-    int reply_count;
-    ReplyInfo *replies;    // Dynamic array of replies
-    int replies_capacity;  // Internal use for realloc
+    int64_t reply_count;
     double latest_reply;
 } Message;
 
+// One reply as listed under its parent
+typedef struct {
+    double ts;
+    int64_t user_idx;
+} ReplyRef;
+
+// A message with its thread resolved, as read from a streaming source.
+// msg.parent_idx is not meaningful; the parent's author is given instead.
+typedef struct {
+    Message msg;
+    int64_t parent_user_idx;   // Author of the parent (-1 if not a reply)
+    const ReplyRef *replies;   // msg.reply_count entries in timestamp order
+} StreamedMessage;
+
+// Thread structure in compressed sparse row layout.
+// The replies of message i are children[offsets[i]] .. children[offsets[i + 1] - 1],
+// stored as indices into the messages array in timestamp order.
+typedef struct {
+    int64_t *offsets;      // message_count + 1 entries
+    int64_t *children;     // One entry per reply
+} ThreadIndex;
+
 #endif // MODELS_H
@@ -0,0 +1,35 @@
+#ifndef NAME_SET_H
+#define NAME_SET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Open-addressing set of base names used to make usernames unique.
+// Each slot remembers the first holder of a name and how many later users
+// asked for the same one. Base names are letters and dots only, so appending
+// the occurrence number ("jane.doe", "jane.doe2", "jane.doe3", ...) can never
+// produce another user's base name: uniqueness needs no second lookup.
+typedef struct {
+    uint64_t hash;         // 0 marks an empty slot
+    const char *name;      // First holder's name (owned by the caller)
+    uint32_t count;        // Occurrences seen so far
+} NameSlot;
+
+typedef struct {
+    NameSlot *slots;
+    size_t capacity;       // Power of two
+    size_t used;
+} NameSet;
+
+// Initialize for roughly expected distinct names (0 selects a default)
+void name_set_init(NameSet *set, size_t expected);
+
+// Claim the NUL-terminated name held in buf (capacity buf_size). The first
+// claim keeps it as is and records buf, which must stay valid for the life
+// of the set; later claims of the same name get a numeric suffix appended
+// in place. Returns the occurrence number (1 for the first).
+uint32_t name_set_claim(NameSet *set, char *buf, size_t buf_size);
+
+void name_set_free(NameSet *set);
+
+#endif // NAME_SET_H
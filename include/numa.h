@@ -0,0 +1,40 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// NUMA placement of worker threads and memory (--numa).
+// The topology is read from /sys/devices/system/node and limited to the
+// CPUs the process may run on, so numactl --cpunodebind and fake nodes
+// (numa=fake=N on the kernel command line) are honoured. Threads are
+// pinned with sched_setaffinity and memory is placed with the mbind system
+// call; libnuma is not needed. Placement is advisory: when the kernel
+// refuses, memory keeps the default first-touch policy.
+//
+// Nodes are numbered 0 .. numa_node_count() - 1 among the nodes with
+// usable CPUs. Worker w runs on node w % count and item k (a channel, an
+// export piece) is owned by node k % count. Until numa_init succeeds
+// there is a single node and every call is a no-op.
+
+#define NUMA_MAX_NODES 64
+
+// Read the topology and enable placement. Returns the node count.
+int numa_init(void);
+
+int numa_node_count(void);
+int numa_worker_node(int worker);
+int numa_owner(int64_t item);
+
+// Restrict the calling thread to the CPUs of worker's node
+void numa_pin_worker(int worker);
+// Let the calling thread run on every allowed CPU again
+void numa_unpin(void);
+
+// Place the pages of [addr, addr + len) on node, or interleave them over
+// every node if node is negative. addr must be page aligned and the pages
+// not yet touched.
+void numa_place(void *addr, size_t len, int node);
+
+#endif // NUMA_H
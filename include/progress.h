@@ -0,0 +1,76 @@
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Live progress reporting.
+// Workers bump counters in a cache line of their own, so the hot loops
+// never contend; a reporter thread sums the lines on each tick. On a TTY
+// the reporter redraws one status line on stderr with the rate, bytes and
+// files written and the ETA of the current phase; otherwise it prints one
+// JSON object per line. SIGUSR1 makes it print a full snapshot of every
+// counter, phase timing and the resident set size, at any time.
+
+// Hot loops count locally and add this many at a time
+#define PROGRESS_BATCH 4096
+
+typedef enum {
+    PROGRESS_USERS,         // Users generated
+    PROGRESS_CHANNELS,      // Channels generated
+    PROGRESS_GENERATED,     // Messages drawn
+    PROGRESS_THREADED,      // Messages through the threading pass
+    PROGRESS_TEXT,          // Message texts written
+    PROGRESS_EXPORTED,      // Messages serialised into the output
+    PROGRESS_BYTES,         // Bytes written to output files
+    PROGRESS_FILES,         // Output files or archive members completed
+    PROGRESS_COUNTERS
+} ProgressCounter;
+
+typedef enum {
+    PROGRESS_PHASE_SETUP,
+    PROGRESS_PHASE_GENERATE,
+    PROGRESS_PHASE_SORT,
+    PROGRESS_PHASE_THREAD,
+    PROGRESS_PHASE_TEXT,
+    PROGRESS_PHASE_EXPORT,
+    PROGRESS_PHASES
+} ProgressPhase;
+
+// Start the reporter. interval is in seconds; 0 prints nothing but still
+// answers SIGUSR1. Call before starting any other thread, so that every
+// thread inherits the blocked SIGUSR1 and only the reporter receives it.
+void progress_start(double interval);
+
+// Print the final status and stop the reporter. Under --trace, phases
+// are also recorded as spans; this ends the last one.
+void progress_stop(void);
+
+// Erase the status line, if one is drawn, before printing to the terminal
+void progress_clear(void);
+
+// Enter phase, which is done after total units of its counter
+void progress_phase(ProgressPhase phase, int64_t total);
+
+// Add n to counter on the calling thread's line. Cheap, but meant to be
+// called per batch rather than per item in hot loops.
+void progress_add(ProgressCounter counter, int64_t n);
+
+// Ignore counters and phases, and the metrics histograms with them, until
+// the matching progress_resume; calls nest. For work that is not part of
+// the output, such as calibrating on a sample. Counters are process-wide,
+// so this also hides other threads' work in the meantime.
+void progress_pause(void);
+void progress_resume(void);
+bool progress_paused(void);
+
+// Current totals of every counter, indexed by ProgressCounter
+void progress_totals(int64_t *totals);
+
+ProgressPhase progress_current_phase(void);
+const char *progress_phase_name(ProgressPhase phase);
+
+// Resident set size from /proc/self/statm, -1 if unavailable
+int64_t progress_resident_bytes(void);
+
+#endif // PROGRESS_H
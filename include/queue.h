@@ -0,0 +1,54 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Bounded lock-free multi-producer multi-consumer queue of pointers
+// (Vyukov's array queue: each cell carries a sequence number that tells
+// producers and consumers whose turn it is). Used to connect the export
+// pipeline stages. Blocking operations spin, then yield, then sleep.
+typedef struct {
+    size_t seq;
+    void *item;
+} QueueCell;
+
+typedef struct {
+    QueueCell *cells;
+    size_t mask;
+    char pad0[64];
+    size_t head;            // Next position to fill
+    char pad1[64];
+    size_t tail;            // Next position to take
+    char pad2[64];
+    int producers;          // Producers that have not called queue_done
+} TaskQueue;
+
+// capacity is rounded up to a power of two
+void queue_init(TaskQueue *q, size_t capacity, int producers);
+void queue_free(TaskQueue *q);
+
+bool queue_try_push(TaskQueue *q, void *item);
+bool queue_try_pop(TaskQueue *q, void **item);
+
+// Push, waiting while the queue is full
+void queue_push(TaskQueue *q, void *item);
+
+// Pop, waiting while the queue is empty. Returns false once every producer
+// has called queue_done and the queue is drained.
+bool queue_pop(TaskQueue *q, void **item);
+
+// A producer will push no more items
+void queue_done(TaskQueue *q);
+
+// Every producer has called queue_done
+bool queue_closed(TaskQueue *q);
+
+// Items waiting, approximate while other threads push or pop
+size_t queue_depth(TaskQueue *q);
+
+// Wait a little longer on each failed attempt: spin, then yield, then
+// sleep. Shared with the scheduler's idle loop.
+void queue_backoff(unsigned attempt);
+
+#endif // QUEUE_H
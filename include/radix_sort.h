@@ -0,0 +1,22 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// LSD radix sort of (key, index) pairs on 64-bit keys, one byte per pass.
+// Callers pack whatever they order by into the key and sort an index
+// permutation alongside it, so the records themselves are never moved.
+// Passes whose byte is the same for every key are skipped, so narrow keys
+// cost only as many passes as they have significant bytes.
+
+// Sort keys ascending, permuting vals with them. The sort is stable.
+// workers > 1 splits each pass across that many threads on large inputs.
+void radix_sort_pairs(uint64_t *keys, int64_t *vals, size_t n, int workers);
+
+// Reorder records (each size bytes) so that record i becomes the one at
+// perm[i], moving every record once along the permutation's cycles.
+// perm is consumed (left as the identity).
+void radix_apply_permutation(void *records, size_t size, int64_t *perm, size_t n);
+
+#endif // RADIX_SORT_H
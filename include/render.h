@@ -0,0 +1,35 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdint.h>
+#include "models.h"
+#include "ids.h"
+#include "json_writer.h"
+
+// JSON objects as they appear in a Slack export, shared by the exporter
+// and the API emulator. User IDs are derived from user indices.
+
+// Scratch space for the reply_users of a thread. An open-addressing set
+// sized to the thread replaces a per-user marker array, so every
+// serialiser can keep its own without memory growing with the user count.
+// Start from all zeroes.
+typedef struct {
+    int64_t *slots;         // User index + 1, or 0 when empty
+    size_t slot_capacity;
+    int64_t *unique;
+    size_t unique_capacity;
+} ReplyUsers;
+
+void reply_users_free(ReplyUsers *ru);
+
+// An entry of users.json
+void render_user(JsonWriter *w, const User *user);
+
+// An entry of channels.json, with its member list
+void render_channel(JsonWriter *w, const Channel *channel, const IdKeys *ids);
+
+// Render one message. parent_user is the author of the thread parent (-1
+// if m is not a reply) and replies holds m->reply_count entries.
+void render_message(JsonWriter *w, const IdKeys *ids, ReplyUsers *ru, const Message *m, int64_t parent_user, const ReplyRef *replies);
+
+#endif // RENDER_H
@@ -0,0 +1,70 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// xoshiro256** pseudo-random generator.
+// Each generator is independent state, so separate threads or channels can
+// draw from their own streams without locking.
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+// One splitmix64 step: advances x and returns a well-mixed 64-bit value
+uint64_t rng_splitmix64(uint64_t *x);
+
+// Seed the state by expanding seed with splitmix64
+void rng_seed(Rng *rng, uint64_t seed);
+
+// Derive an independent stream, e.g. one per channel, from a base seed
+void rng_seed_stream(Rng *rng, uint64_t seed, uint64_t stream);
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Uniform double in [0, 1) with 53 random bits
+static inline double rng_uniform(Rng *rng) {
+    return (double)(rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+// Integer in [0, n) by multiply-shift, without modulo or rejection. Each
+// value's probability is off by a relative error of at most about
+// n / 2^32, negligible for the counts drawn here.
+static inline uint32_t rng_range(Rng *rng, uint32_t n) {
+    return (uint32_t)(((rng_next(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+// Uniform integer in [0, n) for any 64-bit n. Bounds below 2^32 draw
+// exactly like rng_range; larger ones take the high word of next * n.
+static inline uint64_t rng_range64(Rng *rng, uint64_t n) {
+    if (n <= UINT32_MAX) return rng_range(rng, (uint32_t)n);
+    uint64_t x = rng_next(rng);
+    uint64_t x_lo = x & 0xFFFFFFFFu, x_hi = x >> 32;
+    uint64_t n_lo = n & 0xFFFFFFFFu, n_hi = n >> 32;
+    uint64_t mid = x_hi * n_lo + ((x_lo * n_lo) >> 32);
+    uint64_t mid2 = x_lo * n_hi + (mid & 0xFFFFFFFFu);
+    return x_hi * n_hi + (mid >> 32) + (mid2 >> 32);
+}
+
+// Fill out with n random 64-bit words
+void rng_fill(Rng *rng, uint64_t *out, size_t n);
+
+// Write len random lowercase hex characters (no NUL)
+void rng_hex(Rng *rng, char *out, size_t len);
+
+#endif // RNG_H
@@ -0,0 +1,32 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Work-stealing scheduler for unevenly sized ranges of work.
+// Tasks are dealt to per-worker deques, heaviest first. A worker takes its
+// own newest task; an idle worker steals the oldest task of another
+// (Chase-Lev deques). A task larger than the grain is split lazily: the
+// worker pushes the back half, where it can be stolen, and carries on with
+// the front half. One huge channel therefore spreads over every worker
+// while the many small ones are stolen whole.
+// Under --numa each worker is pinned to its node, tasks are dealt to
+// workers on the node that owns their data, and thieves try workers on
+// their own node before crossing to another.
+
+typedef struct {
+    int64_t begin;          // Range of work units, e.g. message positions
+    int64_t end;
+    int node;               // NUMA node owning the data, -1 for any
+} WorkTask;
+
+// Process units [begin, end) on worker (0 .. workers - 1)
+typedef void (*WorkFn)(void *ctx, int worker, int64_t begin, int64_t end);
+
+// Run fn over every task with up to workers threads, worker 0 being the
+// calling thread. Tasks longer than grain units are split; a grain of 0
+// runs every task whole. Split halves keep their node. tasks is
+// reordered. Empty tasks are skipped.
+void scheduler_run(int workers, WorkTask *tasks, int64_t task_count, int64_t grain, WorkFn fn, void *ctx);
+
+#endif // SCHEDULER_H
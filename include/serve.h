@@ -0,0 +1,50 @@
+#ifndef SERVE_H
+#define SERVE_H
+
+#include <stdint.h>
+#include "models.h"
+#include "ids.h"
+#include "history.h"
+
+// A local emulator of the Slack Web API methods that read a workspace:
+// users.list, conversations.list, conversations.history and
+// conversations.replies, under /api/ on 127.0.0.1. Requests take their
+// arguments from the query string or a form-encoded body, and answer in
+// Slack's shape, cursor pagination included. Every page is computed when
+// asked for, so its cost depends on the page size only.
+//
+// One thread polls the listening socket and every idle connection, and
+// hands connections with data to the worker threads. A worker answers the
+// requests received and gives the connection back, so idle keep-alive
+// connections hold no worker.
+
+typedef struct {
+    int port;                   // 0 for any free port
+    int workers;
+    int rate_limit;             // Requests per minute per method, 0 for no limit
+} ServeOptions;
+
+// What the server answers from. It must outlive the server.
+typedef struct {
+    const User *users;
+    int64_t user_count;
+    const Channel *channels;
+    int64_t channel_count;
+    const IdKeys *ids;
+    const History *history;
+} ServeData;
+
+typedef struct Server Server;
+
+// Listen and start the workers. Returns NULL after printing the reason
+// to stderr.
+Server *serve_start(const ServeOptions *opts, const ServeData *data);
+
+// Port the server listens on
+int serve_port(const Server *server);
+
+// Finish the requests in progress, stop and free the server. Returns the
+// number of requests served.
+int64_t serve_stop(Server *server);
+
+#endif // SERVE_H
@@ -0,0 +1,63 @@
+#ifndef SPILL_H
+#define SPILL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// External sort of fixed-size records under a memory budget.
+// Every record starts with a uint64_t key. Records are buffered, radix
+// sorted and written to temporary files as runs whenever the buffer fills,
+// then read back through a k-way merge. Equal keys come back in the order
+// they were added. Input that fits in one buffer never touches the disk.
+typedef struct SpillRun SpillRun;
+
+typedef struct {
+    size_t record_size;
+    size_t memory;         // Byte budget for buffers
+    const char *dir;       // Directory for run files
+    int workers;           // Threads for the in-memory run sort
+    
+    // Run formation
+    char *buffer;
+    size_t capacity;       // Records per run
+    size_t count;
+    
+    // Sorted runs, each an unlinked temporary file
+    SpillRun *runs;
+    size_t run_count;
+    size_t run_capacity;
+    
+    // Read-back state: a min-heap of run indices ordered by (key, run), or
+    // the sorted order of buffer when nothing was spilled
+    size_t *heap;
+    size_t heap_size;
+    int64_t *order;
+    size_t next;
+} SpillSorter;
+
+// Open an anonymous read/write temporary file in dir. It is unlinked at
+// once, so it disappears when closed or when the process exits.
+FILE *spill_temp_file(const char *dir);
+
+void spill_sorter_init(SpillSorter *sorter, size_t record_size, size_t memory, const char *dir, int workers);
+
+// Append one record (record_size bytes, key first)
+void spill_sorter_add(SpillSorter *sorter, const void *record);
+
+// End the input; records can then be read back in key order
+void spill_sorter_finish(SpillSorter *sorter);
+
+// Copy the next record in key order into out. Returns false when done.
+bool spill_sorter_next(SpillSorter *sorter, void *out);
+
+// Key of the next record without consuming it. Returns false when done.
+bool spill_sorter_peek(const SpillSorter *sorter, uint64_t *key);
+
+// Number of runs written to disk so far
+size_t spill_sorter_runs(const SpillSorter *sorter);
+
+void spill_sorter_free(SpillSorter *sorter);
+
+#endif // SPILL_H
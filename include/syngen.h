@@ -0,0 +1,106 @@
+#ifndef SYNGEN_H
+#define SYNGEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "models.h"
+#include "generator.h"
+#include "export_manager.h"
+#include "corpus.h"
+#include "serve.h"
+
+// libsyngen: the generator as a library, built by `make libsyngen`.
+// A run is configured by a SyngenConfig and writes an export to disk, or
+// hands it to a SyngenSink: either the generated entities in batches or
+// the rendered JSON files, all in memory. The syngen command is a client
+// of this API.
+//
+// Runs are independent: every random draw comes from the run's own seed
+// and all run state lives in its Syngen handle, so several runs may go on
+// at once in different threads. What is process-wide is left to the
+// embedding program and shared by every run: huge pages
+// (big_alloc_configure), NUMA placement (numa_init), progress reports
+// (progress_start), tracing (trace_open) and metrics (metrics_start).
+// As in the rest of syngen, running out of memory ends the process.
+
+typedef struct {
+    int64_t users;
+    int64_t channels;
+    int64_t messages;           // Ignored when target_bytes is set
+    unsigned long long seed;
+    ConversationModel model;    // Includes the worker threads
+    int64_t vocab_size;         // Synthetic words, 0 for model.text.vocab
+    double zipf;                // Exponent of the synthetic word frequencies
+    const char *corpus_path;    // Sample message text from here, NULL for model.text.corpus
+    CorpusUnit corpus_unit;
+    size_t max_memory;          // Spill messages beyond this many bytes, 0 for never
+    const char *spill_dir;      // Where spill runs go
+    size_t target_bytes;        // Draw messages until the output is this size, 0 for -m
+    bool target_archive;        // target_bytes is the ZIP archive, not the JSON
+    const char *output;         // Archive or directory, when there is no sink
+    bool unpacked;
+    bool sync;
+    ExportIoBackend io;
+    FILE *log;                  // Status lines go here (NULL = nowhere)
+} SyngenConfig;
+
+// Where a run's data goes instead of config->output. Set the entity
+// callbacks or the file callbacks, not both; a non-zero return from any
+// callback stops the run. Batches and buffers are only valid during the
+// call.
+typedef struct {
+    void *ctx;
+    // Users, then channels, then messages in (channel, day, ts) order.
+    // first is the index of the batch's first entity; messages refer to
+    // users and channels by these indices.
+    int (*users)(void *ctx, const User *users, int64_t first, int64_t count);
+    int (*channels)(void *ctx, const Channel *channels, int64_t first, int64_t count);
+    int (*messages)(void *ctx, const StreamedMessage *messages, int64_t count);
+    // users.json, channels.json, then the channel-day files, uncompressed.
+    // files.ctx is ignored in favour of ctx.
+    ExportFileSink files;
+} SyngenSink;
+
+// Entities per users, channels and messages batch
+#define SYNGEN_BATCH 4096
+
+typedef struct Syngen Syngen;
+
+// Fill in the defaults of the syngen command, but with seed 0
+void syngen_config_defaults(SyngenConfig *config);
+
+// Prepare a run: validate config, load the vocabulary and corpus, and
+// under target_bytes calibrate the message count on a sample. config and
+// the strings it points to must outlive the handle. Returns NULL after
+// printing the reason to stderr.
+Syngen *syngen_open(const SyngenConfig *config);
+
+// Messages the run will draw (calibrated under target_bytes)
+int64_t syngen_messages(const Syngen *s);
+
+// Print a prediction of the run's output size, memory and time to out
+void syngen_estimate(const Syngen *s, FILE *out);
+
+// Generate and deliver the data to sink, or write it to config->output if
+// sink is NULL. A handle runs once. Returns 0 on success, -1 on failure or
+// if a callback stopped the run.
+int syngen_run(Syngen *s, const SyngenSink *sink);
+
+// Serve the run's data as the Slack Web API on 127.0.0.1 instead of
+// running it (see serve.h). Users and channels are generated up front;
+// messages are computed page by page, so config->messages may be far
+// beyond what fits in memory. model.workers threads answer requests, and
+// rate_limit caps each method at that many requests a minute (0 for no
+// cap). port 0 picks a free port. Returns the port, or -1 on failure.
+int syngen_serve(Syngen *s, int port, int rate_limit);
+
+// Stop serving. Returns the number of requests served.
+int64_t syngen_serve_stop(Syngen *s);
+
+// Size the output reached under target_bytes, after syngen_run
+uint64_t syngen_reached(const Syngen *s);
+
+void syngen_close(Syngen *s);
+
+#endif // SYNGEN_H
@@ -0,0 +1,33 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Span tracing for --trace, written as Chrome trace-event JSON (load it in
+// Perfetto or chrome://tracing).
+// Each thread appends complete spans to a chunked buffer of its own, linked
+// into a global list on first use with a compare-and-swap, so recording
+// takes no lock and threads never share a cache line. Buffers outlive their
+// threads and are written out by trace_close. While tracing is off every
+// call returns at once.
+
+// Start recording into path, which is created now so a bad path fails
+// early. Returns 0 on success.
+int trace_open(const char *path);
+
+// Write every recorded span to the file and stop recording. Call once all
+// traced threads have finished.
+void trace_close(void);
+
+// Name the calling thread's track, e.g. "serialiser 2"
+void trace_thread_name(const char *fmt, ...);
+
+// Timestamp opening a span, or 0 while tracing is off
+int64_t trace_clock(void);
+
+// Record span name from begin (trace_clock) until now. name must be a
+// string literal; the optional detail (printf-style, may be NULL) is
+// copied and shown as the span's argument.
+void trace_span(const char *name, int64_t begin, const char *detail_fmt, ...);
+
+#endif // TRACE_H
@@ -0,0 +1,41 @@
+#ifndef VOCAB_H
+#define VOCAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "rng.h"
+
+// Longest word vocab_word can produce (4 syllables + coda)
+#define VOCAB_WORD_MAX_LEN 9
+
+// Largest supported vocabulary (all words of up to 4 syllables)
+#define VOCAB_MAX_SIZE 101010100LL
+
+// Synthetic vocabulary with Zipf-distributed term frequencies.
+// Words are computed from their rank on demand, so no dictionary is stored:
+// rank r always maps to the same pseudo-word for a given seed, distinct
+// ranks never share a word, and frequent (low) ranks get short words.
+typedef struct {
+    int64_t size;          // Number of distinct words
+    double exponent;       // Zipf exponent s, P(rank k) ~ k^-s
+    uint64_t perm_mul[5];  // Per-length affine permutation (index 1-4 used)
+    uint64_t perm_add[5];
+    
+    // Rejection-inversion sampler constants
+    double h_integral_x1;
+    double h_integral_n;
+    double s;
+} Vocabulary;
+
+// Set up a vocabulary of size words (1..VOCAB_MAX_SIZE) with exponent > 0.
+// Returns 0 on success, -1 on invalid parameters.
+int vocab_init(Vocabulary *vocab, int64_t size, double exponent, uint64_t seed);
+
+// Draw a rank in [0, size) from the Zipf distribution
+int64_t vocab_sample(const Vocabulary *vocab, Rng *rng);
+
+// Write the word for rank into out (at least VOCAB_WORD_MAX_LEN bytes, not
+// NUL-terminated). Returns the word length.
+size_t vocab_word(const Vocabulary *vocab, int64_t rank, char *out);
+
+#endif // VOCAB_H
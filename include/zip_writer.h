@@ -0,0 +1,74 @@
+#ifndef ZIP_WRITER_H
+#define ZIP_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "export_io.h"
+
+// Streaming ZIP archive writer.
+// Members are written in one pass without seeking: each local header is
+// followed by the data and a data descriptor with the CRC and sizes.
+// Deflated data arrives already compressed, in pieces that were each
+// deflated on their own (see zip_deflate), so members can be compressed in
+// parallel. Zip64 records are added when the archive passes 65535 entries
+// or 4 GiB.
+
+typedef struct {
+    const char *name;
+    uint32_t crc;
+    uint32_t packed_size;
+    uint32_t size;
+    uint64_t offset;        // Of the local header
+    bool directory;
+} ZipEntry;
+
+typedef struct {
+    ExportDir *dir;
+    ExportFile *file;
+    uint64_t offset;        // Bytes written so far
+    char *buf;              // Small writes are gathered here
+    size_t buf_len;
+    ZipEntry *entries;
+    size_t count;
+    size_t capacity;
+    TextArena names;
+    uint64_t central_size;  // Of the central directory entries so far
+    uint16_t dos_time;
+    uint16_t dos_date;
+    // Member being written
+    uint32_t crc;
+    uint64_t packed_size;
+    uint64_t size;
+} ZipWriter;
+
+// Create path relative to dir. Returns 0 on success.
+int zip_writer_open(ZipWriter *zw, ExportDir *dir, const char *path);
+
+// Start a deflated member
+void zip_begin_file(ZipWriter *zw, const char *name);
+// Append a deflated piece; crc and size describe the uncompressed bytes
+void zip_file_data(ZipWriter *zw, const char *packed, size_t packed_len, uint32_t crc, size_t size);
+void zip_end_file(ZipWriter *zw);
+
+// Add an empty directory entry; name ends with '/'
+void zip_add_directory(ZipWriter *zw, const char *name);
+
+// Size of the archive if it were closed now
+uint64_t zip_writer_size(const ZipWriter *zw);
+
+// Write the central directory and close the file
+void zip_writer_close(ZipWriter *zw);
+
+// Deflate a piece of a member with a raw (headerless) stream and store its
+// CRC-32 in *crc. Pieces other than the last end on a byte boundary after
+// a sync flush, so the pieces of a member can be concatenated. out grows
+// as needed. Returns the compressed length.
+size_t zip_deflate(void *stream, const char *data, size_t len, bool last, char **out, size_t *out_capacity, uint32_t *crc);
+
+// zlib stream state for zip_deflate, one per compressing thread
+void *zip_deflate_new(void);
+void zip_deflate_free(void *stream);
+
+#endif // ZIP_WRITER_H
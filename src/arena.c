@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include "arena.h"
+#include "big_alloc.h"
+
+// A few huge pages per chunk (see big_alloc.h)
+#define TEXT_ARENA_DEFAULT_CHUNK (8 * 1024 * 1024)
+
+struct ArenaChunk {
+    ArenaChunk *next;
+    size_t used;
+    size_t capacity;
+    char data[];
+};
+
+// Chunk bytes held by every arena, for metrics
+static size_t arena_bytes = 0;
+
+void text_arena_init(TextArena *arena, size_t chunk_size) {
+    arena->head = NULL;
+    arena->chunk_size = chunk_size > 0 ? chunk_size : TEXT_ARENA_DEFAULT_CHUNK;
+    arena->node = -1;
+}
+
+char *text_arena_reserve(TextArena *arena, size_t max_len) {
+    ArenaChunk *chunk = arena->head;
+    if (!chunk || chunk->capacity - chunk->used < max_len) {
+        size_t capacity = max_len > arena->chunk_size ? max_len : arena->chunk_size;
+        chunk = big_alloc_on_node(1, sizeof(ArenaChunk) + capacity, arena->node);
+        chunk->next = arena->head;
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        arena->head = chunk;
+        __atomic_add_fetch(&arena_bytes, capacity, __ATOMIC_RELAXED);
+    }
+    return chunk->data + chunk->used;
+}
+
+void text_arena_commit(TextArena *arena, size_t used) {
+    arena->head->used += used;
+}
+
+void text_arena_merge(TextArena *arena, TextArena *src) {
+    ArenaChunk *first = src->head;
+    if (!first) return;
+    ArenaChunk *last = first;
+    while (last->next) last = last->next;
+    // Keep arena's current chunk in front, so it goes on filling
+    if (arena->head) {
+        last->next = arena->head->next;
+        arena->head->next = first;
+    } else {
+        arena->head = first;
+    }
+    src->head = NULL;
+}
+
+void text_arena_reset(TextArena *arena) {
+    ArenaChunk *chunk = arena->head;
+    if (!chunk) return;
+    ArenaChunk *older = chunk->next;
+    while (older) {
+        ArenaChunk *next = older->next;
+        __atomic_sub_fetch(&arena_bytes, older->capacity, __ATOMIC_RELAXED);
+        big_free(older);
+        older = next;
+    }
+    chunk->next = NULL;
+    chunk->used = 0;
+}
+
+void text_arena_free(TextArena *arena) {
+    ArenaChunk *chunk = arena->head;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        __atomic_sub_fetch(&arena_bytes, chunk->capacity, __ATOMIC_RELAXED);
+        big_free(chunk);
+        chunk = next;
+    }
+    arena->head = NULL;
+}
+
+size_t text_arena_total_bytes(void) {
+    return __atomic_load_n(&arena_bytes, __ATOMIC_RELAXED);
+}
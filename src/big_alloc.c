@@ -0,0 +1,163 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "big_alloc.h"
+#include "checked.h"
+#include "numa.h"
+
+// Every block is preceded by a header recording how to release it. It is
+// a full cache line so the data keeps 64-byte alignment.
+#define BIG_HEADER_SIZE 64
+
+typedef enum {
+    BIG_KIND_MALLOC,
+    BIG_KIND_MAPPED
+} BigKind;
+
+typedef struct {
+    size_t map_size;       // Length of the mapping (0 for malloc)
+    BigKind kind;
+} BigHeader;
+
+static BigPages pages_mode = BIG_PAGES_TRANSPARENT;
+static const char *fallback_dir = ".";
+
+void big_alloc_configure(BigPages mode, const char *dir) {
+    pages_mode = mode;
+    fallback_dir = dir ? dir : ".";
+}
+
+int big_pages_parse(const char *arg, BigPages *mode) {
+    if (strcmp(arg, "transparent") == 0) {
+        *mode = BIG_PAGES_TRANSPARENT;
+    } else if (strcmp(arg, "explicit") == 0) {
+        *mode = BIG_PAGES_EXPLICIT;
+    } else if (strcmp(arg, "off") == 0) {
+        *mode = BIG_PAGES_OFF;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static size_t round_up(size_t n, size_t align) {
+    return checked_add(n, align - 1) / align * align;
+}
+
+// Anonymous mapping of at least size bytes starting on a huge page
+// boundary. Returns NULL if the kernel refuses.
+static void *map_anonymous(size_t size, size_t *map_size) {
+#ifdef MAP_HUGETLB
+    if (pages_mode == BIG_PAGES_EXPLICIT) {
+        size_t huge_size = round_up(size, BIG_ALLOC_PAGE_SIZE);
+        void *p = mmap(NULL, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            *map_size = huge_size;
+            return p;
+        }
+        // No reserved huge pages: fall through to transparent ones
+    }
+#endif
+    
+    // Over-map by one huge page, then trim so the block starts aligned
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = round_up(size, page);
+    size_t span = checked_add(length, BIG_ALLOC_PAGE_SIZE);
+    char *raw = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    
+    char *start = (char *)round_up((size_t)(uintptr_t)raw, BIG_ALLOC_PAGE_SIZE);
+    size_t head = (size_t)(start - raw);
+    if (head > 0) munmap(raw, head);
+    size_t tail = span - head - length;
+    if (tail > 0) munmap(start + length, tail);
+    
+#ifdef MADV_HUGEPAGE
+    if (pages_mode != BIG_PAGES_OFF) {
+        madvise(start, length, MADV_HUGEPAGE);
+    }
+#endif
+    *map_size = length;
+    return start;
+}
+
+// Shared mapping of an unlinked temporary file in fallback_dir
+static void *map_file(size_t size, size_t *map_size) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/syngen_map_XXXXXX", fallback_dir);
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    unlink(path);
+    
+    size_t length = round_up(size, (size_t)sysconf(_SC_PAGESIZE));
+    void *p = MAP_FAILED;
+    if (ftruncate(fd, (off_t)length) == 0) {
+        p = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd); // The mapping keeps the file referenced
+    if (p == MAP_FAILED) return NULL;
+    *map_size = length;
+    return p;
+}
+
+static void *big_alloc_bytes(size_t bytes, int zero, int node) {
+    size_t total = checked_add(bytes, BIG_HEADER_SIZE);
+    BigHeader *header;
+    
+    if (total < BIG_ALLOC_MIN_BYTES) {
+        // Cache-line aligned like the mappings, so the data is too
+        size_t rounded = checked_add(total, BIG_HEADER_SIZE - 1) & ~(size_t)(BIG_HEADER_SIZE - 1);
+        header = aligned_alloc(BIG_HEADER_SIZE, rounded);
+        if (header && zero) memset(header, 0, rounded);
+        if (!header) {
+            fprintf(stderr, "Error: Out of memory allocating %zu bytes\n", bytes);
+            exit(1);
+        }
+        header->kind = BIG_KIND_MALLOC;
+        header->map_size = 0;
+    } else {
+        // Fresh mappings are zero-filled, so zero needs no extra work
+        size_t map_size;
+        header = map_anonymous(total, &map_size);
+        if (header) {
+            // Before the header write below touches the first page
+            numa_place(header, map_size, node);
+        } else {
+            header = map_file(total, &map_size);
+        }
+        if (!header) {
+            fprintf(stderr, "Error: Cannot map %zu bytes in memory or in %s\n", bytes, fallback_dir);
+            exit(1);
+        }
+        header->kind = BIG_KIND_MAPPED;
+        header->map_size = map_size;
+    }
+    return (char *)header + BIG_HEADER_SIZE;
+}
+
+void *big_alloc(int64_t count, size_t size) {
+    return big_alloc_on_node(count, size, -1);
+}
+
+void *big_alloc_on_node(int64_t count, size_t size, int node) {
+    size_t n = checked_count(count);
+    return big_alloc_bytes(checked_mul(n > 0 ? n : 1, size), 0, node);
+}
+
+void *big_calloc(int64_t count, size_t size) {
+    size_t n = checked_count(count);
+    return big_alloc_bytes(checked_mul(n > 0 ? n : 1, size), 1, -1);
+}
+
+void big_free(void *ptr) {
+    if (!ptr) return;
+    BigHeader *header = (BigHeader *)((char *)ptr - BIG_HEADER_SIZE);
+    if (header->kind == BIG_KIND_MALLOC) {
+        free(header);
+    } else {
+        munmap(header, header->map_size);
+    }
+}
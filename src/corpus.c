@@ -0,0 +1,137 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "corpus.h"
+
+static int is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+static int is_sentence_end(char c) {
+    return c == '.' || c == '!' || c == '?';
+}
+
+// Grow the index arrays when full
+static int reserve_units(Corpus *corpus, uint64_t *capacity) {
+    if (corpus->count < *capacity) return 0;
+    uint64_t new_cap = *capacity ? *capacity * 2 : 4096;
+    uint64_t *starts = realloc(corpus->starts, sizeof(uint64_t) * new_cap);
+    if (!starts) return -1;
+    corpus->starts = starts;
+    uint32_t *lengths = realloc(corpus->lengths, sizeof(uint32_t) * new_cap);
+    if (!lengths) return -1;
+    corpus->lengths = lengths;
+    *capacity = new_cap;
+    return 0;
+}
+
+// Trim [begin, end) and record it if anything is left
+static int add_unit(Corpus *corpus, uint64_t *capacity, size_t begin, size_t end) {
+    const char *d = corpus->data;
+    while (begin < end && is_space(d[begin])) begin++;
+    while (end > begin && is_space(d[end - 1])) end--;
+    if (begin == end) return 0;
+    
+    if (end - begin > CORPUS_MAX_UNIT_LEN) {
+        end = begin + CORPUS_MAX_UNIT_LEN;
+        // Do not cut a UTF-8 sequence in half
+        while (end > begin && ((unsigned char)d[end] & 0xC0) == 0x80) end--;
+    }
+    
+    if (reserve_units(corpus, capacity) != 0) return -1;
+    corpus->starts[corpus->count] = begin;
+    corpus->lengths[corpus->count] = (uint32_t)(end - begin);
+    corpus->count++;
+    return 0;
+}
+
+static int build_index(Corpus *corpus, CorpusUnit unit) {
+    const char *d = corpus->data;
+    size_t size = corpus->size;
+    uint64_t capacity = 0;
+    size_t begin = 0;
+    
+    if (unit == CORPUS_LINES) {
+        while (begin < size) {
+            const char *nl = memchr(d + begin, '\n', size - begin);
+            size_t end = nl ? (size_t)(nl - d) : size;
+            if (add_unit(corpus, &capacity, begin, end) != 0) return -1;
+            begin = end + 1;
+        }
+        return 0;
+    }
+    
+    for (size_t i = 0; i < size; i++) {
+        if (d[i] == '\n' || (is_sentence_end(d[i]) && (i + 1 == size || is_space(d[i + 1])))) {
+            size_t end = d[i] == '\n' ? i : i + 1;
+            if (add_unit(corpus, &capacity, begin, end) != 0) return -1;
+            begin = i + 1;
+        }
+    }
+    return add_unit(corpus, &capacity, begin, size);
+}
+
+int corpus_open(Corpus *corpus, const char *path, CorpusUnit unit) {
+    memset(corpus, 0, sizeof(*corpus));
+    
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        perror(path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        fprintf(stderr, "%s: corpus is empty\n", path);
+        close(fd);
+        return -1;
+    }
+    
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file referenced
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    corpus->data = map;
+    corpus->size = (size_t)st.st_size;
+    
+    // One sequential scan to build the index, then random sampling
+    posix_madvise(map, corpus->size, POSIX_MADV_SEQUENTIAL);
+    if (build_index(corpus, unit) != 0) {
+        fprintf(stderr, "%s: out of memory indexing corpus\n", path);
+        corpus_close(corpus);
+        return -1;
+    }
+    posix_madvise(map, corpus->size, POSIX_MADV_RANDOM);
+    
+    if (corpus->count == 0) {
+        fprintf(stderr, "%s: corpus has no text\n", path);
+        corpus_close(corpus);
+        return -1;
+    }
+    return 0;
+}
+
+const char *corpus_unit(const Corpus *corpus, uint64_t idx, size_t *len) {
+    *len = corpus->lengths[idx];
+    return corpus->data + corpus->starts[idx];
+}
+
+void corpus_close(Corpus *corpus) {
+    if (corpus->data) {
+        munmap((void *)corpus->data, corpus->size);
+    }
+    free(corpus->starts);
+    free(corpus->lengths);
+    memset(corpus, 0, sizeof(*corpus));
+}
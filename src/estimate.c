@@ -0,0 +1,359 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "estimate.h"
+#include "export_manager.h"
+#include "progress.h"
+
+// Samples taken to find the message count for a size target
+#define ESTIMATE_TARGET_ROUNDS 5
+// Messages in the calibration sample
+#define ESTIMATE_SAMPLE_MESSAGES 100000
+// Bound on the sample's channel member entries, which grow with users
+// times channels
+#define ESTIMATE_SAMPLE_MEMBERS 2000000
+#define ESTIMATE_SAMPLE_USERS 100000
+// A member in channels.json: a quoted 11-character ID and ", "
+#define ESTIMATE_MEMBER_BYTES 15
+// ZIP local header, data descriptor and central directory entry, each
+// followed by the name in the headers
+#define ESTIMATE_ZIP_ENTRY_BYTES (30 + 16 + 46)
+// "/YYYY-MM-DD.json" after the channel name
+#define ESTIMATE_DAY_NAME_BYTES 16
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Mean of generate_channels' member count: 20% of the users plus a
+// uniform share of up to half of them
+static double expected_members(int64_t users) {
+    double members = (double)(users / 2) / 2.0 + (double)(users / 5);
+    if (members > (double)users) members = (double)users;
+    return members < 1.0 ? 1.0 : members;
+}
+
+static double normal_cdf(double x) {
+    return 0.5 * erfc(-x / sqrt(2.0));
+}
+
+// Expected number of non-empty channel-day files: channels are drawn by
+// rand_gaussian_index, timestamps uniformly over the last 30 days
+static double expected_day_files(int64_t channels, int64_t messages) {
+    time_t now = time(NULL);
+    time_t start = now - (30 * 24 * 3600);
+    double window = difftime(now, start);
+
+    // Share of the window in each local calendar day
+    double day_share[40];
+    int days = 0;
+    for (time_t t = start; t < now && days < 40; days++) {
+        struct tm tm;
+        localtime_r(&t, &tm);
+        tm.tm_mday++;
+        tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+        tm.tm_isdst = -1;
+        time_t next = mktime(&tm);
+        if (next > now) next = now;
+        day_share[days] = difftime(next, t) / window;
+        t = next;
+    }
+
+    double mean = (double)channels / 2.0;
+    double sigma = (double)channels / 6.0;
+    if (sigma < 1.0) sigma = 1.0;
+    double files = 0;
+    for (int64_t k = 0; k < channels; k++) {
+        double lo = k == 0 ? 0.0 : normal_cdf(((double)k - 0.5 - mean) / sigma);
+        double hi = k == channels - 1 ? 1.0 : normal_cdf(((double)k + 0.5 - mean) / sigma);
+        double p = hi - lo;
+        if (p <= 0) continue;
+        for (int d = 0; d < days; d++) {
+            // Chance that at least one message lands in (k, d)
+            files += -expm1((double)messages * log1p(-p * day_share[d]));
+        }
+    }
+    return files;
+}
+
+typedef struct {
+    double files;
+    int64_t channels;
+    double raw;
+    double packed;              // The archive
+    double fixed_raw;           // users.json and channels.json
+    double fixed_packed;        // The same in the archive, with directories
+    bool spill;
+    double memory;
+    double spill_disk;
+    double seconds;
+    // Shares of the channel-day file bytes along the messages
+    double raw_profile[EXPORT_PROFILE_POINTS + 1];
+    double packed_profile[EXPORT_PROFILE_POINTS + 1];
+} Estimate;
+
+static void print_bytes(FILE *out, const char *label, double bytes, const char *note) {
+    static const char *const units[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB"};
+    int u = 0;
+    while (bytes >= 1024 && u < 5) {
+        bytes /= 1024;
+        u++;
+    }
+    fprintf(out, "  %-14s%.1f %s%s\n", label, bytes, units[u], note);
+}
+
+static void print_duration(FILE *out, const char *label, double seconds) {
+    long s = lround(seconds);
+    if (s >= 3600) {
+        fprintf(out, "  %-14s~%ldh%02ldm\n", label, s / 3600, s / 60 % 60);
+    } else if (s >= 60) {
+        fprintf(out, "  %-14s~%ldm%02lds\n", label, s / 60, s % 60);
+    } else {
+        fprintf(out, "  %-14s~%.1fs\n", label, seconds);
+    }
+}
+
+static double ratio(uint64_t packed, uint64_t raw) {
+    return raw > 0 ? (double)packed / (double)raw : 1.0;
+}
+
+static double elapsed(double since) {
+    double t = now_seconds() - since;
+    return t > 1e-6 ? t : 1e-6;
+}
+
+static bool no_messages(void *source, StreamedMessage *out) {
+    (void)source;
+    (void)out;
+    return false;
+}
+
+// channels.json alone, with the run's full user count: member IDs drawn
+// from a small sample's users repeat and deflate far better than the real
+// ones. The channel count is cut so the member lists stay small.
+typedef struct {
+    int64_t channels;
+    int64_t members;
+    double fixed_bytes;         // Per channel, besides its members
+    double packed_ratio;
+    double generate_seconds;
+    double export_seconds;
+} ChannelSample;
+
+static void sample_channels(const EstimateParams *params, ChannelSample *out) {
+    int64_t u = params->users;
+    int64_t c = (int64_t)(ESTIMATE_SAMPLE_MEMBERS / expected_members(u));
+    if (c > params->channels) c = params->channels;
+    if (c < 1) c = 1;
+
+    Rng rng;
+    rng_seed(&rng, params->seed);
+    IdKeys ids;
+    id_keys_init(&ids, params->seed);
+
+    double t0 = now_seconds();
+    Channel *channels = generate_channels(&rng, c, u, &ids);
+    out->generate_seconds = elapsed(t0);
+
+    ExportSizes sizes;
+    memset(&sizes, 0, sizeof(sizes));
+    ExportOptions opts = {
+        .output = NULL,
+        .unpacked = params->unpacked,
+        .workers = params->model->workers,
+        .measure = &sizes
+    };
+    t0 = now_seconds();
+    export_write(&opts, NULL, 0, channels, c, &ids, no_messages, NULL);
+    out->export_seconds = elapsed(t0);
+
+    out->members = 0;
+    for (int64_t i = 0; i < c; i++) {
+        out->members += channels[i].member_count;
+    }
+    if (out->members < 1) out->members = 1;
+    free_channels(channels, c);
+
+    out->channels = c;
+    out->fixed_bytes = ((double)sizes.channel_bytes - (double)out->members * ESTIMATE_MEMBER_BYTES) / (double)c;
+    out->packed_ratio = ratio(sizes.channel_packed, sizes.channel_bytes);
+}
+
+// Run the samples and extrapolate them to params
+static void estimate_run(const EstimateParams *params, Estimate *e) {
+    int64_t u = params->users;
+    int64_t c = params->channels;
+    int64_t m = params->messages;
+    const ConversationModel *model = params->model;
+
+    // The samples are not part of any output, so they stay out of the
+    // progress counters and metrics
+    progress_pause();
+
+    // Keep the messages per channel, which drive thread lengths and file
+    // sizes, and cap the users so the channel member lists stay small
+    int64_t m_s = m < ESTIMATE_SAMPLE_MESSAGES ? m : ESTIMATE_SAMPLE_MESSAGES;
+    int64_t c_s = (int64_t)llround((double)c * (double)m_s / (double)m);
+    if (c_s < 1) c_s = 1;
+    int64_t u_s = u < ESTIMATE_SAMPLE_USERS ? u : ESTIMATE_SAMPLE_USERS;
+    while (u_s > 10 && (double)c_s * expected_members(u_s) > ESTIMATE_SAMPLE_MEMBERS) {
+        u_s /= 2;
+    }
+    if (params->log) {
+        fprintf(params->log, "Estimating from a sample of %lld users, %lld channels and %lld messages...\n",
+                (long long)u_s, (long long)c_s, (long long)m_s);
+    }
+
+    ChannelSample cs;
+    sample_channels(params, &cs);
+
+    Rng rng;
+    rng_seed(&rng, params->seed);
+    IdKeys ids;
+    id_keys_init(&ids, params->seed);
+
+    double t0 = now_seconds();
+    User *users = generate_users(&rng, u_s, &ids);
+    double user_seconds = elapsed(t0);
+    Channel *channels = generate_channels(&rng, c_s, u_s, &ids);
+    t0 = now_seconds();
+    TextArena arena;
+    text_arena_init(&arena, 0);
+    Message *messages = generate_messages(&rng, m_s, channels, c_s, u_s, model, &arena);
+    ThreadIndex threads;
+    generate_thread_index(messages, m_s, &threads);
+    double message_seconds = elapsed(t0);
+
+    ExportSizes sizes;
+    memset(&sizes, 0, sizeof(sizes));
+    ExportOptions opts = {
+        .output = NULL,
+        .unpacked = params->unpacked,
+        .workers = model->workers,
+        .message_count = m_s,
+        .measure = &sizes
+    };
+    t0 = now_seconds();
+    SortedMessages sorted;
+    sorted_messages_init(&sorted, messages, m_s, &threads, model->workers);
+    export_write(&opts, users, u_s, channels, c_s, &ids, sorted_messages_next, &sorted);
+    sorted_messages_free(&sorted);
+    double export_seconds = elapsed(t0);
+
+    double name_bytes = 0;
+    for (int64_t i = 0; i < c_s; i++) {
+        name_bytes += (double)strlen(channels[i].name);
+    }
+    name_bytes /= (double)c_s;
+    int64_t replies_s = 0;
+    for (int64_t i = 0; i < m_s; i++) {
+        replies_s += messages[i].reply_count;
+    }
+    free_thread_index(&threads);
+    free_messages(messages, m_s);
+    text_arena_free(&arena);
+    free_channels(channels, c_s);
+    free_users(users, u_s);
+
+    // Output sizes
+    double members = expected_members(u);
+    double channel_json = cs.fixed_bytes + members * ESTIMATE_MEMBER_BYTES;
+    double user_bytes = (double)sizes.user_bytes / (double)u_s * (double)u;
+    double channel_bytes = (double)c * channel_json;
+    double message_bytes = (double)sizes.message_bytes / (double)m_s * (double)m;
+    double day_files = expected_day_files(c, m);
+    e->files = 2 + day_files;
+    e->channels = c;
+    e->raw = user_bytes + channel_bytes + message_bytes;
+    e->fixed_raw = user_bytes + channel_bytes;
+    // Every name is stored twice: channel-day files, channel directories
+    // ("name/"), users.json and channels.json
+    double dir_headers = (double)c * (ESTIMATE_ZIP_ENTRY_BYTES + 2 * (name_bytes + 1)) +
+                         2 * ESTIMATE_ZIP_ENTRY_BYTES + 2 * 23;
+    double day_headers = day_files * (ESTIMATE_ZIP_ENTRY_BYTES + 2 * (name_bytes + ESTIMATE_DAY_NAME_BYTES));
+    e->fixed_packed = user_bytes * ratio(sizes.user_packed, sizes.user_bytes) + channel_bytes * cs.packed_ratio +
+                      dir_headers;
+    e->packed = e->fixed_packed + message_bytes * ratio(sizes.message_packed, sizes.message_bytes) + day_headers;
+    for (int i = 0; i <= EXPORT_PROFILE_POINTS; i++) {
+        e->raw_profile[i] = sizes.raw_profile[i] / sizes.raw_profile[EXPORT_PROFILE_POINTS];
+        e->packed_profile[i] = sizes.packed_profile[i] / sizes.packed_profile[EXPORT_PROFILE_POINTS];
+    }
+
+    // Memory: users, channels with member lists, the messages (or the
+    // spill budget) and the export pipeline's buffers. Pieces keep their
+    // buffers, so every piece that once held a slice of channels.json
+    // keeps its rendered and deflated size.
+    e->spill = params->max_memory > 0 && (uint64_t)m > params->max_memory / GENERATOR_BYTES_PER_MESSAGE;
+    double entities = (double)u * (sizeof(User) + sizeof(int64_t)) +
+                      (double)c * (sizeof(Channel) + members * sizeof(int64_t));
+    double message_memory = e->spill ? (double)params->max_memory : (double)m * GENERATOR_BYTES_PER_MESSAGE;
+    double channel_pieces = ceil((double)c / (double)sizes.piece_channels);
+    if (channel_pieces > (double)sizes.pieces) channel_pieces = (double)sizes.pieces;
+    double per_piece = (double)(c < sizes.piece_channels ? c : sizes.piece_channels) * channel_json;
+    double buffers = (double)sizes.buffer_bytes +
+                     channel_pieces * per_piece * (1 + (params->unpacked ? 0 : cs.packed_ratio));
+    e->memory = entities + message_memory + buffers;
+    double replies = (double)replies_s / (double)m_s * (double)m;
+    e->spill_disk = (double)message_spill_disk_bytes(m, (int64_t)replies);
+
+    // Time: users and messages at the sampled rates, channels per member
+    // entry generated and per channels.json byte exported. Spilling adds
+    // its own disk I/O.
+    e->seconds = user_seconds / (double)u_s * (double)u +
+                 cs.generate_seconds / (double)cs.members * (double)c * members +
+                 (message_seconds + export_seconds) / (double)m_s * (double)m +
+                 cs.export_seconds / ((double)cs.channels * channel_json) * channel_bytes;
+    progress_resume();
+}
+
+void estimate_print(const EstimateParams *params, FILE *out) {
+    Estimate e;
+    estimate_run(params, &e);
+    fprintf(out, "Estimate:\n");
+    fprintf(out, "  %-14s%.0f (and %lld channel directories)\n", "Files:", e.files, (long long)e.channels);
+    print_bytes(out, "Uncompressed:", e.raw, "");
+    if (!params->unpacked) {
+        print_bytes(out, "Archive:", e.packed, "");
+    }
+    print_bytes(out, "Peak memory:", e.memory, e.spill ? " (spilling)" : "");
+    if (e.spill) {
+        print_bytes(out, "Spill disk:", e.spill_disk, "");
+    }
+    print_duration(out, "Wall time:", e.seconds);
+    fprintf(out, "  %-14s%d job%s%s\n", "Assuming:", params->model->workers, params->model->workers == 1 ? "" : "s",
+            e.spill ? ", excluding spill I/O" : "");
+}
+
+int64_t estimate_messages_for(const EstimateParams *params, ExportTarget *target) {
+    // Each message adds less as the day files fill up, so the count is
+    // refined by secant steps between the last two sampled sizes
+    EstimateParams at = *params;
+    double last_messages = 0, last_size = 0;
+    for (int round = 0; round < ESTIMATE_TARGET_ROUNDS; round++) {
+        Estimate e;
+        estimate_run(&at, &e);
+        double fixed = target->archive ? e.fixed_packed : e.fixed_raw;
+        double size = target->archive ? e.packed : e.raw;
+        if ((double)target->bytes <= fixed || size <= fixed) return -1;
+        target->message_bytes = (size - fixed) / (double)at.messages;
+        memcpy(target->profile, target->archive ? e.packed_profile : e.raw_profile, sizeof(target->profile));
+
+        double slope = target->message_bytes;
+        if (round > 0 && size > last_size && (double)at.messages != last_messages) {
+            slope = (size - last_size) / ((double)at.messages - last_messages);
+        }
+        last_messages = (double)at.messages;
+        last_size = size;
+        int64_t messages = llround((double)at.messages + ((double)target->bytes - size) / slope);
+        if (messages < 1) messages = 1;
+        bool settled = llabs(messages - at.messages) <= messages / 50;
+        at.messages = messages;
+        if (settled) break;
+    }
+    return at.messages;
+}
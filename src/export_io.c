@@ -0,0 +1,709 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include "export_io.h"
+#include "big_alloc.h"
+#include "progress.h"
+#include "trace.h"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+// IORING_FEAT_RW_CUR_POS marks headers from Linux 5.6, which has the
+// probe, write and close operations used here
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+#define EXPORT_IO_HAVE_URING 1
+#endif
+#endif
+
+// Files created but not yet finished; creating more waits for closes
+#define EXPORT_IO_MAX_OPEN 256
+
+struct ExportFile {
+    int fd;
+    off_t offset;           // Where the next write goes
+    int pending;            // Writes handed over but not completed
+    bool closing;           // Closed by the caller; finish once pending is 0
+    ExportFile *next;       // Link in the close queue
+};
+
+typedef struct {
+    ExportFile *file;
+    off_t offset;
+    size_t len;
+} IoSlot;
+
+#ifdef EXPORT_IO_HAVE_URING
+#define RING_ENTRIES (2 * EXPORT_IO_SLOTS)
+
+// Low bits of user_data tell completions apart; ExportFile pointers come
+// from malloc and leave them clear
+enum { TAG_WRITE, TAG_CLOSE, TAG_FSYNC, TAG_MASK = 3 };
+
+typedef struct {
+    int fd;
+    unsigned entries;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_map, *cq_map;
+    size_t sq_map_size, cq_map_size;
+    unsigned tail;          // Local SQ tail, published on io_uring_enter
+    unsigned to_submit;     // SQEs queued since the last io_uring_enter
+    unsigned in_flight;     // SQEs queued or submitted without a completion
+    bool fixed;             // Staging buffers are registered
+} Ring;
+#endif
+
+struct ExportWriter {
+    ExportIoBackend backend;
+    bool sync;
+    char *buffers;                  // EXPORT_IO_SLOTS staging buffers
+    IoSlot slots[EXPORT_IO_SLOTS];
+    int free_slots[EXPORT_IO_SLOTS];
+    int free_count;
+    int open_files;                 // Created and not yet finished
+    ExportFile *close_head;         // Files whose writes are all done
+    ExportFile *close_tail;
+#ifdef EXPORT_IO_HAVE_URING
+    Ring ring;
+#endif
+    // Thread pool; the fields above are shared under lock
+    pthread_t threads[EXPORT_IO_WORKERS];
+    int thread_count;
+    pthread_mutex_t lock;
+    pthread_cond_t work;            // A job was queued or the pool is stopping
+    pthread_cond_t progress;        // A slot was released or a file finished
+    int jobs[EXPORT_IO_SLOTS];      // Filled slots waiting for a worker
+    int job_head;
+    int job_count;
+    bool stopping;
+    int error;                      // errno of the first failed operation, 0 if none
+};
+
+static char *slot_data(ExportWriter *w, int s) {
+    return w->buffers + (size_t)s * EXPORT_IO_BUFFER;
+}
+
+// --- Plain I/O, shared by every backend ---
+
+// Keep the first error for export_dir_close. Only that one is printed;
+// once the output is incomplete, a full disk would repeat it for every
+// write that follows.
+static void record_error(ExportWriter *w, const char *what, int err) {
+    int none = 0;
+    if (__atomic_compare_exchange_n(&w->error, &none, err, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        fprintf(stderr, "%s: %s\n", what, strerror(err));
+    }
+}
+
+static bool failed(ExportWriter *w) {
+    return __atomic_load_n(&w->error, __ATOMIC_RELAXED) != 0;
+}
+
+static void write_all(ExportWriter *w, int fd, const char *data, size_t len, off_t offset) {
+    int64_t begin = trace_clock();
+    size_t total = len;
+    while (len > 0) {
+        ssize_t n = pwrite(fd, data, len, offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            record_error(w, "write", errno);
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+        offset += n;
+    }
+    trace_span("pwrite", begin, "%zu bytes", total);
+}
+
+// fsync (if asked) and close the file, then release it
+static void finish_file(ExportWriter *w, ExportFile *file) {
+    if (w->sync && fsync(file->fd) != 0) record_error(w, "fsync", errno);
+    if (close(file->fd) != 0) record_error(w, "close", errno);
+    free(file);
+}
+
+static void queue_close(ExportWriter *w, ExportFile *file) {
+    file->next = NULL;
+    if (w->close_tail) {
+        w->close_tail->next = file;
+    } else {
+        w->close_head = file;
+    }
+    w->close_tail = file;
+}
+
+static ExportFile *pop_close(ExportWriter *w) {
+    ExportFile *file = w->close_head;
+    w->close_head = file->next;
+    if (!w->close_head) w->close_tail = NULL;
+    return file;
+}
+
+// A write in slot s finished: free the slot and close its file if that was
+// the last write after the caller closed it
+static void slot_done(ExportWriter *w, int s) {
+    ExportFile *file = w->slots[s].file;
+    w->free_slots[w->free_count++] = s;
+    if (--file->pending == 0 && file->closing) queue_close(w, file);
+}
+
+// --- io_uring backend ---
+// Single-threaded: the exporter's thread queues SQEs and reaps completions
+// whenever it needs a free slot. Finished files are closed with linked
+// FSYNC and CLOSE operations.
+
+#ifdef EXPORT_IO_HAVE_URING
+static int ring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int ring_register(int fd, unsigned opcode, void *arg, unsigned count) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, count);
+}
+
+// IORING_OP_CLOSE and IORING_OP_WRITE need Linux 5.6
+static bool ring_supports_ops(int fd) {
+    size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = calloc(1, size);
+    if (!probe) return false;
+    bool ok = ring_register(fd, IORING_REGISTER_PROBE, probe, 256) == 0 &&
+        probe->last_op >= IORING_OP_CLOSE &&
+        (probe->ops[IORING_OP_CLOSE].flags & IO_URING_OP_SUPPORTED) &&
+        (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+    free(probe);
+    return ok;
+}
+
+static void ring_unmap(Ring *r) {
+    if (r->sqes) munmap(r->sqes, r->entries * sizeof(struct io_uring_sqe));
+    if (r->cq_map && r->cq_map != r->sq_map) munmap(r->cq_map, r->cq_map_size);
+    if (r->sq_map) munmap(r->sq_map, r->sq_map_size);
+}
+
+static int ring_init(ExportWriter *w) {
+    Ring *r = &w->ring;
+    memset(r, 0, sizeof(*r));
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    r->fd = ring_setup(RING_ENTRIES, &p);
+    if (r->fd < 0) return -1;
+    if (!ring_supports_ops(r->fd)) {
+        close(r->fd);
+        return -1;
+    }
+
+    r->entries = p.sq_entries;
+    r->sq_map_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_map_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && r->cq_map_size > r->sq_map_size) r->sq_map_size = r->cq_map_size;
+
+    r->sq_map = mmap(NULL, r->sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    if (r->sq_map == MAP_FAILED) r->sq_map = NULL;
+    if (r->sq_map) {
+        r->cq_map = single ? r->sq_map : mmap(NULL, r->cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_CQ_RING);
+        if (r->cq_map == MAP_FAILED) r->cq_map = NULL;
+    }
+    if (r->cq_map) {
+        r->sqes = mmap(NULL, r->entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+        if (r->sqes == MAP_FAILED) r->sqes = NULL;
+    }
+    if (!r->sqes) {
+        ring_unmap(r);
+        close(r->fd);
+        return -1;
+    }
+
+    char *sq = r->sq_map;
+    char *cq = r->cq_map;
+    r->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    r->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    r->sq_array = (unsigned *)(sq + p.sq_off.array);
+    r->cq_head = (unsigned *)(cq + p.cq_off.head);
+    r->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    r->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    r->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    r->tail = *r->sq_tail;
+
+    // Registered buffers save the kernel pinning pages on every write. If
+    // RLIMIT_MEMLOCK is too small, plain writes from the same buffers work.
+    struct iovec iov[EXPORT_IO_SLOTS];
+    for (int s = 0; s < EXPORT_IO_SLOTS; s++) {
+        iov[s].iov_base = slot_data(w, s);
+        iov[s].iov_len = EXPORT_IO_BUFFER;
+    }
+    r->fixed = ring_register(r->fd, IORING_REGISTER_BUFFERS, iov, EXPORT_IO_SLOTS) == 0;
+    return 0;
+}
+
+static void ring_free(ExportWriter *w) {
+    Ring *r = &w->ring;
+    ring_unmap(r);
+    close(r->fd);
+}
+
+static void ring_complete(ExportWriter *w, uint64_t data, int res) {
+    if ((data & TAG_MASK) == TAG_WRITE) {
+        int s = (int)(data >> 2);
+        IoSlot *slot = &w->slots[s];
+        if (res < 0) {
+            record_error(w, "write", -res);
+        } else if ((size_t)res < slot->len) {
+            // Short write: finish it here, it is rare enough
+            write_all(w, slot->file->fd, slot_data(w, s) + res, slot->len - (size_t)res, slot->offset + res);
+        }
+        slot_done(w, s);
+        return;
+    }
+
+    ExportFile *file = (ExportFile *)(uintptr_t)(data & ~(uint64_t)TAG_MASK);
+    if ((data & TAG_MASK) == TAG_FSYNC) {
+        if (res < 0) record_error(w, "fsync", -res);
+        return;
+    }
+    if (res == -ECANCELED) {
+        // The linked fsync failed, so the close never ran
+        close(file->fd);
+    } else if (res < 0) {
+        record_error(w, "close", -res);
+    }
+    free(file);
+    w->open_files--;
+}
+
+static void ring_reap(ExportWriter *w) {
+    Ring *r = &w->ring;
+    unsigned head = *r->cq_head;
+    unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const struct io_uring_cqe *cqe = &r->cqes[head & *r->cq_mask];
+        uint64_t data = cqe->user_data;
+        int res = cqe->res;
+        head++;
+        r->in_flight--;
+        ring_complete(w, data, res);
+    }
+    __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+}
+
+// Submit everything queued; with wait, block until a completion arrives
+// and reap it
+static void ring_enter(ExportWriter *w, bool wait) {
+    Ring *r = &w->ring;
+    __atomic_store_n(r->sq_tail, r->tail, __ATOMIC_RELEASE);
+    unsigned min_complete = wait ? 1 : 0;
+    int64_t begin = trace_clock();
+    unsigned submitted = r->to_submit;
+    for (;;) {
+        long ret = syscall(__NR_io_uring_enter, r->fd, r->to_submit, min_complete,
+                           wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EBUSY) {
+                // Completion queue backed up: make room and retry
+                ring_reap(w);
+                continue;
+            }
+            perror("io_uring_enter");
+            exit(1);
+        }
+        r->to_submit -= (unsigned)ret;
+        if (r->to_submit == 0) break;
+    }
+    trace_span("io_uring_enter", begin, "%u sqes%s", submitted, wait ? ", wait" : "");
+    ring_reap(w);
+}
+
+// Make room for n more SQEs without exceeding the ring
+static void ring_reserve(ExportWriter *w, unsigned n) {
+    while (w->ring.in_flight + n > w->ring.entries) {
+        ring_enter(w, true);
+    }
+}
+
+static struct io_uring_sqe *ring_sqe(Ring *r) {
+    unsigned index = r->tail & *r->sq_mask;
+    struct io_uring_sqe *sqe = &r->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    r->sq_array[index] = index;
+    r->tail++;
+    r->to_submit++;
+    r->in_flight++;
+    return sqe;
+}
+
+static void ring_queue_write(ExportWriter *w, int s) {
+    ring_reserve(w, 1);
+    Ring *r = &w->ring;
+    const IoSlot *slot = &w->slots[s];
+    struct io_uring_sqe *sqe = ring_sqe(r);
+    sqe->opcode = r->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = slot->file->fd;
+    sqe->addr = (uint64_t)(uintptr_t)slot_data(w, s);
+    sqe->len = (unsigned)slot->len;
+    sqe->off = (uint64_t)slot->offset;
+    if (r->fixed) sqe->buf_index = (uint16_t)s;
+    sqe->user_data = (uint64_t)s << 2 | TAG_WRITE;
+}
+
+// Queue closes for every file whose writes are done
+static void ring_flush_closes(ExportWriter *w) {
+    Ring *r = &w->ring;
+    while (w->close_head) {
+        ring_reserve(w, 2);
+        ExportFile *file = pop_close(w);
+        uint64_t tag = (uint64_t)(uintptr_t)file;
+        if (w->sync) {
+            struct io_uring_sqe *sqe = ring_sqe(r);
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fd = file->fd;
+            sqe->flags = IOSQE_IO_LINK;
+            sqe->user_data = tag | TAG_FSYNC;
+        }
+        struct io_uring_sqe *sqe = ring_sqe(r);
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = file->fd;
+        sqe->user_data = tag | TAG_CLOSE;
+    }
+}
+
+static void ring_drain(ExportWriter *w) {
+    ring_flush_closes(w);
+    while (w->ring.in_flight > 0) {
+        ring_enter(w, true);
+        ring_flush_closes(w);
+    }
+}
+#endif
+
+// --- pwrite thread pool backend ---
+
+static void *pool_worker(void *arg) {
+    ExportWriter *w = arg;
+    trace_thread_name("io");
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+        if (w->job_count > 0) {
+            int s = w->jobs[w->job_head];
+            w->job_head = (w->job_head + 1) % EXPORT_IO_SLOTS;
+            w->job_count--;
+            const IoSlot *slot = &w->slots[s];
+            pthread_mutex_unlock(&w->lock);
+            write_all(w, slot->file->fd, slot_data(w, s), slot->len, slot->offset);
+            pthread_mutex_lock(&w->lock);
+            slot_done(w, s);
+            pthread_cond_broadcast(&w->progress);
+        } else if (w->close_head) {
+            ExportFile *file = pop_close(w);
+            pthread_mutex_unlock(&w->lock);
+            finish_file(w, file);
+            pthread_mutex_lock(&w->lock);
+            w->open_files--;
+            pthread_cond_broadcast(&w->progress);
+        } else if (w->stopping) {
+            break;
+        } else {
+            pthread_cond_wait(&w->work, &w->lock);
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+static int pool_init(ExportWriter *w) {
+    for (int t = 0; t < EXPORT_IO_WORKERS; t++) {
+        if (pthread_create(&w->threads[t], NULL, pool_worker, w) != 0) break;
+        w->thread_count++;
+    }
+    return w->thread_count > 0 ? 0 : -1;
+}
+
+static void pool_stop(ExportWriter *w) {
+    pthread_mutex_lock(&w->lock);
+    while (w->open_files > 0) {
+        pthread_cond_wait(&w->progress, &w->lock);
+    }
+    w->stopping = true;
+    pthread_cond_broadcast(&w->work);
+    pthread_mutex_unlock(&w->lock);
+    for (int t = 0; t < w->thread_count; t++) {
+        pthread_join(w->threads[t], NULL);
+    }
+}
+
+// --- Directories ---
+
+static ExportWriter *writer_new(ExportIoBackend backend, bool sync) {
+    ExportWriter *w = calloc(1, sizeof(ExportWriter));
+    if (!w) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    w->sync = sync;
+    w->buffers = big_alloc(EXPORT_IO_SLOTS, EXPORT_IO_BUFFER);
+    for (int s = 0; s < EXPORT_IO_SLOTS; s++) {
+        w->free_slots[s] = EXPORT_IO_SLOTS - 1 - s;
+    }
+    w->free_count = EXPORT_IO_SLOTS;
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->work, NULL);
+    pthread_cond_init(&w->progress, NULL);
+
+#ifdef EXPORT_IO_HAVE_URING
+    if (backend == EXPORT_IO_AUTO || backend == EXPORT_IO_URING) {
+        if (ring_init(w) == 0) {
+            w->backend = EXPORT_IO_URING;
+            return w;
+        }
+    }
+#endif
+    if (backend != EXPORT_IO_SYNC && pool_init(w) == 0) {
+        w->backend = EXPORT_IO_THREADS;
+    } else {
+        w->backend = EXPORT_IO_SYNC;
+    }
+    return w;
+}
+
+// Finish every operation and free the writer. Returns its first error.
+static int writer_free(ExportWriter *w) {
+#ifdef EXPORT_IO_HAVE_URING
+    if (w->backend == EXPORT_IO_URING) {
+        ring_drain(w);
+        ring_free(w);
+    }
+#endif
+    if (w->backend == EXPORT_IO_THREADS) {
+        pool_stop(w);
+    }
+    pthread_cond_destroy(&w->progress);
+    pthread_cond_destroy(&w->work);
+    pthread_mutex_destroy(&w->lock);
+    big_free(w->buffers);
+    int error = w->error;
+    free(w);
+    return error;
+}
+
+int export_dir_open(ExportDir *dir, const char *path, bool sync, ExportIoBackend backend) {
+    dir->path = path;
+    dir->sync = sync;
+    dir->writer = NULL;
+    if (mkdir(path, 0755) == -1 && errno != EEXIST) {
+        perror(path);
+        return -1;
+    }
+    dir->fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir->fd < 0) {
+        perror(path);
+        return -1;
+    }
+    dir->writer = writer_new(backend, sync);
+    return 0;
+}
+
+int export_dir_close(ExportDir *dir) {
+    int error = 0;
+    if (dir->writer) {
+        error = writer_free(dir->writer);
+        dir->writer = NULL;
+    }
+    if (dir->fd < 0) return error;
+    if (dir->sync && fsync(dir->fd) != 0 && error == 0) {
+        error = errno;
+        perror(dir->path);
+    }
+    close(dir->fd);
+    dir->fd = -1;
+    return error;
+}
+
+const char *export_io_backend_name(const ExportDir *dir) {
+    switch (dir->writer->backend) {
+        case EXPORT_IO_URING: return "io_uring";
+        case EXPORT_IO_THREADS: return "threads";
+        default: return "sync";
+    }
+}
+
+int export_io_backend_parse(const char *arg, ExportIoBackend *backend) {
+    if (strcmp(arg, "auto") == 0) {
+        *backend = EXPORT_IO_AUTO;
+    } else if (strcmp(arg, "uring") == 0) {
+        *backend = EXPORT_IO_URING;
+    } else if (strcmp(arg, "threads") == 0) {
+        *backend = EXPORT_IO_THREADS;
+    } else if (strcmp(arg, "sync") == 0) {
+        *backend = EXPORT_IO_SYNC;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+void export_mkdir(int dir_fd, const char *name) {
+    if (mkdirat(dir_fd, name, 0755) == -1 && errno != EEXIST) {
+        perror(name);
+    }
+}
+
+int export_subdir_open(int dir_fd, const char *name) {
+    int fd = openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) perror(name);
+    return fd;
+}
+
+void export_subdir_close(const ExportDir *dir, int fd) {
+    if (fd < 0) return;
+    // Persist the entries of the files created in it
+    if (dir->sync) fsync(fd);
+    close(fd);
+}
+
+// --- Files ---
+
+ExportFile *export_file_create(ExportDir *dir, int dir_fd, const char *name) {
+    ExportWriter *w = dir->writer;
+    // Bound the descriptors held by files still being written
+#ifdef EXPORT_IO_HAVE_URING
+    if (w->backend == EXPORT_IO_URING) {
+        ring_flush_closes(w);
+        while (w->open_files >= EXPORT_IO_MAX_OPEN && w->ring.in_flight > 0) {
+            ring_enter(w, true);
+            ring_flush_closes(w);
+        }
+    }
+#endif
+    if (w->backend == EXPORT_IO_THREADS) {
+        pthread_mutex_lock(&w->lock);
+        while (w->open_files >= EXPORT_IO_MAX_OPEN) {
+            pthread_cond_wait(&w->progress, &w->lock);
+        }
+        pthread_mutex_unlock(&w->lock);
+    }
+
+    int fd = openat(dir_fd, name, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        record_error(w, name, errno);
+        return NULL;
+    }
+    ExportFile *file = calloc(1, sizeof(ExportFile));
+    if (!file) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    file->fd = fd;
+
+    if (w->backend == EXPORT_IO_THREADS) pthread_mutex_lock(&w->lock);
+    w->open_files++;
+    if (w->backend == EXPORT_IO_THREADS) pthread_mutex_unlock(&w->lock);
+    return file;
+}
+
+// Take a free staging buffer, waiting for a write to complete if needed
+static int acquire_slot(ExportWriter *w) {
+#ifdef EXPORT_IO_HAVE_URING
+    if (w->backend == EXPORT_IO_URING) {
+        while (w->free_count == 0) {
+            ring_enter(w, true);
+        }
+        return w->free_slots[--w->free_count];
+    }
+#endif
+    pthread_mutex_lock(&w->lock);
+    while (w->free_count == 0) {
+        pthread_cond_wait(&w->progress, &w->lock);
+    }
+    int s = w->free_slots[--w->free_count];
+    pthread_mutex_unlock(&w->lock);
+    return s;
+}
+
+// Hand a filled slot to the backend
+static void submit_slot(ExportWriter *w, int s) {
+    ExportFile *file = w->slots[s].file;
+#ifdef EXPORT_IO_HAVE_URING
+    if (w->backend == EXPORT_IO_URING) {
+        file->pending++;
+        ring_queue_write(w, s);
+        return;
+    }
+#endif
+    pthread_mutex_lock(&w->lock);
+    file->pending++;
+    w->jobs[(w->job_head + w->job_count) % EXPORT_IO_SLOTS] = s;
+    w->job_count++;
+    pthread_cond_signal(&w->work);
+    pthread_mutex_unlock(&w->lock);
+}
+
+void export_file_write(ExportDir *dir, ExportFile *file, const char *data, size_t len) {
+    ExportWriter *w = dir->writer;
+    // After a failure the export is lost; the rest is not worth writing
+    if (!file || failed(w)) return;
+    progress_add(PROGRESS_BYTES, (int64_t)len);
+    if (w->backend == EXPORT_IO_SYNC) {
+        write_all(w, file->fd, data, len, file->offset);
+        file->offset += (off_t)len;
+        return;
+    }
+
+    while (len > 0) {
+        size_t n = len < EXPORT_IO_BUFFER ? len : EXPORT_IO_BUFFER;
+        int s = acquire_slot(w);
+        memcpy(slot_data(w, s), data, n);
+        IoSlot *slot = &w->slots[s];
+        slot->file = file;
+        slot->offset = file->offset;
+        slot->len = n;
+        file->offset += (off_t)n;
+        submit_slot(w, s);
+        data += n;
+        len -= n;
+    }
+#ifdef EXPORT_IO_HAVE_URING
+    if (w->backend == EXPORT_IO_URING) ring_enter(w, false);
+#endif
+}
+
+void export_file_close(ExportDir *dir, ExportFile *file) {
+    if (!file) return;
+    ExportWriter *w = dir->writer;
+    switch (w->backend) {
+        case EXPORT_IO_SYNC:
+            finish_file(w, file);
+            w->open_files--;
+            break;
+        case EXPORT_IO_THREADS:
+            pthread_mutex_lock(&w->lock);
+            file->closing = true;
+            if (file->pending == 0) {
+                queue_close(w, file);
+                pthread_cond_signal(&w->work);
+            }
+            pthread_mutex_unlock(&w->lock);
+            break;
+        default:
+#ifdef EXPORT_IO_HAVE_URING
+            file->closing = true;
+            if (file->pending == 0) queue_close(w, file);
+            ring_flush_closes(w);
+            ring_enter(w, false);
+#endif
+            break;
+    }
+}
@@ -2,343 +2,878 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/stat.h>
-#include <sys/types.h>
-#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
 #include "export_manager.h"
-#include "cJSON.h"
-#include "faker.h" // For timestamp helpers if needed, or just time.h
+#include "export_io.h"
+#include "zip_writer.h"
+#include "queue.h"
+#include "checked.h"
+#include "big_alloc.h"
+#include "json_writer.h"
+#include "render.h"
+#include "ids.h"
+#include "radix_sort.h"
+#include "numa.h"
+#include "progress.h"
+#include "trace.h"
+#include "metrics.h"
 
-static void create_directory(const char *path) {
-    if (mkdir(path, 0755) == -1) {
-        if (errno != EEXIST) {
-            perror("mkdir");
+// A message piece is cut at a channel or day boundary, or once it holds
+// this many messages or text bytes; longer days span several pieces
+#define EXPORT_PIECE_MESSAGES 4096
+#define EXPORT_PIECE_TEXT (512 * 1024)
+// users.json and channels.json are rendered this many entries per piece
+#define EXPORT_PIECE_USERS 2048
+#define EXPORT_PIECE_CHANNELS 256
+// Size targets steer by the sizes stored this many pieces back. A fixed
+// lag, rather than whatever has been stored, keeps the output the same for
+// any number of workers; the producer waits if the writer is further back.
+#define EXPORT_TARGET_LAG 64
+
+// Numbers each export in the process, so that concurrent runs register
+// distinct queue gauges
+static int export_runs;
+
+// --- Pieces ---
+
+typedef enum {
+    PIECE_USERS,
+    PIECE_CHANNELS,
+    PIECE_MESSAGES
+} PieceKind;
+
+// A message copied into a piece. Its text and replies live in the piece's
+// buffers, since the source may reuse its own.
+typedef struct {
+    Message msg;
+    int64_t parent_user;
+    size_t text_offset;
+    size_t reply_offset;
+} PieceMessage;
+
+// Unit of work flowing through the pipeline: all or part of one file
+typedef struct {
+    uint64_t seq;               // Position in the output
+    int node;                   // NUMA node whose threads handle it
+    PieceKind kind;
+    int64_t channel;            // Directory of the file, -1 for the root
+    char file_name[16];         // YYYY-MM-DD.json, users.json or channels.json
+    bool first;                 // Opens its file
+    bool last;                  // Closes its file
+    int64_t begin, end;         // User or channel range
+    int64_t drawn;              // Messages read from the source up to here
+
+    PieceMessage *messages;
+    size_t count, capacity;
+    char *text;
+    size_t text_len, text_capacity;
+    ReplyRef *replies;
+    size_t reply_len, reply_capacity;
+
+    JsonWriter json;            // Rendered by a serialiser
+    char *packed;               // Deflated by a compressor
+    size_t packed_len, packed_capacity;
+    uint32_t crc;
+} Piece;
+
+// Grow *buf to hold at least need elements of size bytes
+static void grow(void *buf, size_t *capacity, size_t need, size_t size) {
+    if (need <= *capacity) return;
+    size_t cap = *capacity ? *capacity : 64;
+    while (cap < need) cap *= 2;
+    void **p = buf;
+    void *grown = realloc(*p, checked_mul(cap, size));
+    if (!grown) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    *p = grown;
+    *capacity = cap;
+}
+
+static void piece_add(Piece *piece, const StreamedMessage *sm) {
+    const Message *m = &sm->msg;
+    grow(&piece->messages, &piece->capacity, piece->count + 1, sizeof(PieceMessage));
+    grow(&piece->text, &piece->text_capacity, piece->text_len + m->text_len, 1);
+    grow(&piece->replies, &piece->reply_capacity, piece->reply_len + (size_t)m->reply_count, sizeof(ReplyRef));
+
+    PieceMessage *pm = &piece->messages[piece->count++];
+    pm->msg = *m;
+    pm->msg.text = NULL;
+    pm->parent_user = sm->parent_user_idx;
+    pm->text_offset = piece->text_len;
+    pm->reply_offset = piece->reply_len;
+    memcpy(piece->text + piece->text_len, m->text, m->text_len);
+    piece->text_len += m->text_len;
+    if (m->reply_count > 0) {
+        memcpy(piece->replies + piece->reply_len, sm->replies, sizeof(ReplyRef) * (size_t)m->reply_count);
+        piece->reply_len += (size_t)m->reply_count;
+    }
+}
+
+// Output size and messages stored after a piece, and the messages read
+// from the source by then
+typedef struct {
+    uint64_t size;
+    int64_t messages;
+    int64_t drawn;
+} TargetPoint;
+
+// --- Pipeline ---
+// The calling thread cuts the output into pieces. Serialisers render them
+// to JSON, compressors deflate them, and one writer appends them in seq
+// order. Stages are connected by lock-free queues. A fixed pool of pieces
+// cycles from the writer back to the producer, which is the backpressure:
+// the producer waits for a free piece, so memory stays flat and the
+// pieces in flight always fit the writer's reorder window.
+// Under --numa the pool and the render and pack queues are split by node.
+// A piece belongs to the node owning its channel, serialisers and
+// compressors are pinned and take from their own node's queue first, and
+// a piece's buffers stay with the threads of one node.
+
+typedef struct {
+    const ExportOptions *opts;
+    const User *users;
+    int64_t user_count;
+    const Channel *channels;
+    int64_t channel_count;
+    const IdKeys *ids;
+
+    Piece *pieces;
+    size_t piece_count;
+    int nodes;
+    TaskQueue *free_pieces;     // Writer -> producer, per node
+    TaskQueue *to_render;       // Producer -> serialisers, per node
+    TaskQueue *to_pack;         // Serialisers -> compressors, per node
+    TaskQueue to_write;         // Compressors (serialisers if not packing) -> writer
+    bool packing;               // Files are deflated for an archive
+
+    ExportDir dir;
+    ZipWriter zip;
+
+    // Size targets: the writer records the output size after each piece
+    TargetPoint *stored_sizes;  // By seq modulo 2 * EXPORT_TARGET_LAG
+    uint64_t stored_pieces;     // Pieces recorded, published with release
+    uint64_t written;           // Uncompressed bytes, once the writer ends
+    int stopped;                // Set by the writer when the file sink refuses
+} Pipeline;
+
+static void render_piece(const Pipeline *p, Piece *piece, ReplyUsers *ru) {
+    JsonWriter *w = &piece->json;
+    json_writer_reset(w);
+    if (piece->first) {
+        json_begin_array(w);
+    } else {
+        json_continue_array(w);
+    }
+
+    switch (piece->kind) {
+        case PIECE_USERS:
+            for (int64_t i = piece->begin; i < piece->end; i++) {
+                render_user(w, &p->users[i]);
+            }
+            break;
+        case PIECE_CHANNELS:
+            for (int64_t i = piece->begin; i < piece->end; i++) {
+                render_channel(w, &p->channels[i], p->ids);
+            }
+            break;
+        case PIECE_MESSAGES:
+            for (size_t i = 0; i < piece->count; i++) {
+                const PieceMessage *pm = &piece->messages[i];
+                Message m = pm->msg;
+                m.text = piece->text + pm->text_offset;
+                render_message(w, p->ids, ru, &m, pm->parent_user, piece->replies + pm->reply_offset);
+            }
+            break;
+    }
+
+    if (piece->last) json_end_array(w);
+}
+
+// Pop from the node's own queue, else from another node's. Returns false
+// once every queue is closed and drained.
+static bool pop_near(TaskQueue *queues, int nodes, int node, void **item) {
+    for (unsigned attempt = 0;; attempt++) {
+        bool finished = true;
+        for (int k = 0; k < nodes; k++) {
+            TaskQueue *q = &queues[(node + k) % nodes];
+            // Closed before the pop fails means nothing more will arrive
+            bool closed = queue_closed(q);
+            if (queue_try_pop(q, item)) return true;
+            if (!closed) finished = false;
         }
+        if (finished) return false;
+        queue_backoff(attempt);
     }
 }
 
-void export_init(const char *base_path) {
-    create_directory(base_path);
+typedef struct {
+    Pipeline *p;
+    int index;                  // Among the threads of its stage
+} StageThread;
+
+static int64_t queue_depth_gauge(void *q) {
+    return (int64_t)queue_depth(q);
 }
 
-void export_write_users(const char *base_path, const User *users, int count) {
-    cJSON *root = cJSON_CreateArray();
-    
-    for (int i = 0; i < count; i++) {
-        cJSON *user = cJSON_CreateObject();
-        cJSON_AddStringToObject(user, "id", users[i].id);
-        cJSON_AddStringToObject(user, "name", users[i].name);
-        cJSON_AddStringToObject(user, "real_name", users[i].real_name);
-        cJSON_AddStringToObject(user, "team_id", "T012345678"); // Fake Team ID
-        
-        // Profile
-        cJSON *profile = cJSON_CreateObject();
-        cJSON_AddStringToObject(profile, "email", users[i].email);
-        cJSON_AddStringToObject(profile, "real_name", users[i].real_name);
-        cJSON_AddStringToObject(profile, "display_name", users[i].name);
-        
-        cJSON_AddStringToObject(profile, "avatar_hash", users[i].avatar_hash);
-        
-        char img_url[256];
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=1024&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_original", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=24&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_24", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=32&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_32", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=48&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_48", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=72&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_72", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=192&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_192", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=512&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_512", img_url);
-        
-        snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=1024&d=identicon", users[i].avatar_hash);
-        cJSON_AddStringToObject(profile, "image_1024", img_url);
-        
-        cJSON_AddItemToObject(user, "profile", profile);
-        
-        cJSON_AddBoolToObject(user, "is_admin", users[i].is_admin);
-        cJSON_AddBoolToObject(user, "is_owner", users[i].is_admin); // Make admins owners for simplicity
-        cJSON_AddBoolToObject(user, "is_bot", users[i].is_bot);
-        cJSON_AddBoolToObject(user, "deleted", false);
-        
-        cJSON_AddItemToArray(root, user);
-    }
-    
-    char path[512];
-    snprintf(path, sizeof(path), "%s/users.json", base_path);
-    
-    char *json_str = cJSON_Print(root);
-    FILE *fp = fopen(path, "w");
-    if (fp) {
-        fputs(json_str, fp);
-        fclose(fp);
+// Directory of the file a piece belongs to, "" for root files
+static const char *piece_dir(const Pipeline *p, const Piece *piece) {
+    return piece->channel < 0 ? "" : p->channels[piece->channel].name;
+}
+
+static void *serialiser_main(void *arg) {
+    const StageThread *st = arg;
+    Pipeline *p = st->p;
+    numa_pin_worker(st->index);
+    int node = numa_worker_node(st->index);
+    trace_thread_name("serialiser %d", st->index);
+    ReplyUsers ru = {0};
+    void *item;
+    while (pop_near(p->to_render, p->nodes, node, &item)) {
+        Piece *piece = item;
+        int64_t begin = trace_clock();
+        int64_t started = metrics_clock();
+        render_piece(p, piece, &ru);
+        if (started) metrics_observe(METRICS_SERIALISE_NS, metrics_clock() - started);
+        trace_span("serialise", begin, "%s%s%s", piece_dir(p, piece), piece->channel < 0 ? "" : "/", piece->file_name);
+        queue_push(p->packing ? &p->to_pack[piece->node] : &p->to_write, piece);
+    }
+    if (!p->packing) {
+        queue_done(&p->to_write);
     } else {
-        perror("fopen users.json");
+        for (int n = 0; n < p->nodes; n++) queue_done(&p->to_pack[n]);
+    }
+    reply_users_free(&ru);
+    return NULL;
+}
+
+static void *compressor_main(void *arg) {
+    const StageThread *st = arg;
+    Pipeline *p = st->p;
+    numa_pin_worker(st->index);
+    int node = numa_worker_node(st->index);
+    trace_thread_name("compressor %d", st->index);
+    void *stream = zip_deflate_new();
+    void *item;
+    while (pop_near(p->to_pack, p->nodes, node, &item)) {
+        Piece *piece = item;
+        int64_t begin = trace_clock();
+        piece->packed_len = zip_deflate(stream, piece->json.data, piece->json.len, piece->last,
+                                        &piece->packed, &piece->packed_capacity, &piece->crc);
+        trace_span("compress", begin, "%s%s%s", piece_dir(p, piece), piece->channel < 0 ? "" : "/", piece->file_name);
+        queue_push(&p->to_write, piece);
     }
-    
-    free(json_str);
-    cJSON_Delete(root);
+    queue_done(&p->to_write);
+    zip_deflate_free(stream);
+    return NULL;
 }
 
-void export_write_channels(const char *base_path, const Channel *channels, int count) {
-    cJSON *root = cJSON_CreateArray();
-    
-    for (int i = 0; i < count; i++) {
-        cJSON *ch = cJSON_CreateObject();
-        cJSON_AddStringToObject(ch, "id", channels[i].id);
-        cJSON_AddStringToObject(ch, "name", channels[i].name);
-        cJSON_AddNumberToObject(ch, "created", (double)channels[i].created);
-        cJSON_AddStringToObject(ch, "creator", channels[i].creator);
-        cJSON_AddBoolToObject(ch, "is_archived", false);
-        cJSON_AddBoolToObject(ch, "is_general", false);
-        
-        cJSON *members = cJSON_CreateStringArray((const char **)channels[i].members, channels[i].member_count);
-        cJSON_AddItemToObject(ch, "members", members);
-        
-        cJSON_AddItemToArray(root, ch);
-        
-        // Create directory for this channel
-        char dir_path[512];
-        snprintf(dir_path, sizeof(dir_path), "%s/%s", base_path, channels[i].name);
-        create_directory(dir_path);
-    }
-    
-    char path[512];
-    snprintf(path, sizeof(path), "%s/channels.json", base_path);
-    
-    char *json_str = cJSON_Print(root);
-    FILE *fp = fopen(path, "w");
-    if (fp) {
-        fputs(json_str, fp);
-        fclose(fp);
-    }
-    
-    free(json_str);
-    cJSON_Delete(root);
+// Writer state for unpacked output
+typedef struct {
+    int64_t channel;            // Channel whose directory is open
+    int channel_fd;
+    ExportFile *file;
+} DirWriter;
+
+static void write_piece_unpacked(Pipeline *p, DirWriter *dw, const Piece *piece) {
+    if (piece->first) {
+        if (piece->channel != dw->channel) {
+            export_subdir_close(&p->dir, dw->channel_fd);
+            dw->channel_fd = export_subdir_open(p->dir.fd, p->channels[piece->channel].name);
+            dw->channel = piece->channel;
+        }
+        int dir_fd = piece->channel < 0 ? p->dir.fd : dw->channel_fd;
+        dw->file = export_file_create(&p->dir, dir_fd, piece->file_name);
+    }
+    export_file_write(&p->dir, dw->file, piece->json.data, piece->json.len);
+    if (!piece->last) return;
+
+    export_file_close(&p->dir, dw->file);
+    dw->file = NULL;
+    if (piece->kind == PIECE_CHANNELS) {
+        // Every channel directory is made up front, relative to the root
+        for (int64_t i = 0; i < p->channel_count; i++) {
+            export_mkdir(p->dir.fd, p->channels[i].name);
+        }
+    }
 }
 
-static char *get_channel_name_by_id(const Channel *channels, int count, const char *id) {
-    for (int i = 0; i < count; i++) {
-        if (strcmp(channels[i].id, id) == 0) {
-            return (char *)channels[i].name; // Cast to discard const, assuming caller doesn't modify
+static void write_piece_zipped(Pipeline *p, const Piece *piece) {
+    char name[96];
+    if (piece->first) {
+        if (piece->channel < 0) {
+            snprintf(name, sizeof(name), "%s", piece->file_name);
+        } else {
+            snprintf(name, sizeof(name), "%s/%s", p->channels[piece->channel].name, piece->file_name);
+        }
+        zip_begin_file(&p->zip, name);
+    }
+    zip_file_data(&p->zip, piece->packed, piece->packed_len, piece->crc, piece->json.len);
+    if (!piece->last) return;
+
+    zip_end_file(&p->zip);
+    if (piece->kind == PIECE_CHANNELS) {
+        // Channel directories follow channels.json, as zip -r lists them
+        for (int64_t i = 0; i < p->channel_count; i++) {
+            snprintf(name, sizeof(name), "%s/", p->channels[i].name);
+            zip_add_directory(&p->zip, name);
         }
     }
-    return "unknown";
 }
 
-static int compare_refs(const void *a, const void *b) {
-    struct MsgRef {
-        int index;
-        char channel_id[12];
-        time_t date; // Rounded to day
-        double ts;
-    };
-    const struct MsgRef *ra = (const struct MsgRef *)a;
-    const struct MsgRef *rb = (const struct MsgRef *)b;
-    
-    int ch_cmp = strcmp(ra->channel_id, rb->channel_id);
-    if (ch_cmp != 0) return ch_cmp;
-    
-    if (ra->date < rb->date) return -1;
-    if (ra->date > rb->date) return 1;
-    
-    if (ra->ts < rb->ts) return -1;
-    if (ra->ts > rb->ts) return 1;
-    
-    return 0;
+// Hand a piece to the file sink. Returns non-zero if the sink refuses it.
+static int write_piece_sink(const Pipeline *p, const Piece *piece) {
+    const ExportFileSink *sink = p->opts->files;
+    if (piece->first) {
+        char path[96];
+        snprintf(path, sizeof(path), "%s%s%s", piece_dir(p, piece), piece->channel < 0 ? "" : "/", piece->file_name);
+        if (sink->begin(sink->ctx, path) != 0) return -1;
+    }
+    if (sink->data(sink->ctx, piece->json.data, piece->json.len) != 0) return -1;
+    return piece->last ? sink->end(sink->ctx) : 0;
 }
 
-void export_write_messages(const char *base_path, const Message *messages, int count, const Channel *channels, int channel_count) {
-    // We need to group by channel and date.
-    // Since implementing a hash map is complex in C, we will iterate and append to files.
-    // This is inefficient but simple.
-    // To make it slightly better, we process one message at a time, check if the file exists, read it (if we want valid JSON array), append...
-    // But appending to a JSON array is hard with file I/O.
-    // Better strategy:
-    // 1. Sort messages by channel and date. (They are sorted by timestamp already).
-    // 2. Iterate. When channel or date changes, close previous JSON array and start new one.
-    
-    // Sort logic requires creating a struct that holds all info. 
-    // `Message` struct has everything except Channel Name (it has ID) and Date string.
-    
-    // Let's create a temporary index array and sort it.
-    struct MsgRef {
-        int index;
-        char channel_id[12];
-        time_t date; // Rounded to day
-        double ts;
-    };
-    
-    struct MsgRef *refs = malloc(sizeof(struct MsgRef) * (size_t)count);
-    for (int i = 0; i < count; i++) {
-        refs[i].index = i;
-        strcpy(refs[i].channel_id, messages[i].channel);
-        refs[i].ts = messages[i].ts;
-        
-        // Calculate date
-        time_t t = (time_t)messages[i].ts;
-        struct tm *tm_info = localtime(&t);
-        // Normalize to midnight
-        tm_info->tm_sec = 0;
-        tm_info->tm_min = 0;
-        tm_info->tm_hour = 0;
-        refs[i].date = mktime(tm_info);
-    }
-    
-    qsort(refs, (size_t)count, sizeof(struct MsgRef), compare_refs);
-    
-    // Now iterate and write
-    cJSON *current_array = NULL;
-    char current_file_path[512] = {0};
-    
-    for (int i = 0; i < count; i++) {
-        int original_idx = refs[i].index;
-        const Message *m = &messages[original_idx];
-        
-        // Determine file path
-        const char *ch_name = get_channel_name_by_id(channels, channel_count, refs[i].channel_id);
-        
-        time_t t = (time_t)m->ts;
-        const struct tm *tm_info = localtime(&t);
-        char date_str[12];
-        strftime(date_str, sizeof(date_str), "%Y-%m-%d", tm_info);
-        
-        char file_path[512];
-        snprintf(file_path, sizeof(file_path), "%s/%s/%s.json", base_path, ch_name, date_str);
-        
-        // If file path changed, write current array and start new one
-        if (strcmp(file_path, current_file_path) != 0) {
-            if (current_array) {
-                // Write previous file
-                char *json_str = cJSON_Print(current_array);
-                FILE *fp = fopen(current_file_path, "w");
-                if (fp) {
-                    fputs(json_str, fp);
-                    fclose(fp);
+// Running totals of the channel-day files for the size profile
+typedef struct {
+    int64_t messages;
+    double raw;
+    double archive;
+    int points;                 // Profile points filled
+} Measure;
+
+static void measure_piece(const Pipeline *p, Measure *ms, const Piece *piece) {
+    ExportSizes *sizes = p->opts->measure;
+    uint64_t raw = piece->json.len;
+    uint64_t packed = piece->packed_len;
+    switch (piece->kind) {
+        case PIECE_USERS:
+            sizes->user_bytes += raw;
+            sizes->user_packed += packed;
+            break;
+        case PIECE_CHANNELS:
+            sizes->channel_bytes += raw;
+            sizes->channel_packed += packed;
+            break;
+        case PIECE_MESSAGES:
+            sizes->message_bytes += raw;
+            sizes->message_packed += packed;
+            break;
+    }
+    if (piece->last) sizes->files++;
+    if (piece->kind != PIECE_MESSAGES) return;
+
+    // Members pay a local header, a data descriptor and a central
+    // directory entry, with the name in both headers
+    size_t name_len = strlen(piece_dir(p, piece)) + 1 + strlen(piece->file_name);
+    double header = piece->first ? (double)(30 + 16 + 46 + 2 * name_len) : 0.0;
+    Measure was = *ms;
+    ms->messages += (int64_t)piece->count;
+    ms->raw += (double)raw;
+    ms->archive += (double)packed + header;
+    // Interpolate the points this piece passes
+    int64_t total = p->opts->message_count;
+    while (ms->points <= EXPORT_PROFILE_POINTS &&
+           (double)ms->points * (double)total <= (double)ms->messages * EXPORT_PROFILE_POINTS) {
+        double at = (double)ms->points * (double)total / EXPORT_PROFILE_POINTS;
+        double w = ms->messages > was.messages ? (at - (double)was.messages) / (double)(ms->messages - was.messages) : 1.0;
+        if (w < 0.0) w = 0.0;
+        sizes->raw_profile[ms->points] = was.raw + w * (ms->raw - was.raw);
+        sizes->packed_profile[ms->points] = was.archive + w * (ms->archive - was.archive);
+        ms->points++;
+    }
+}
+
+static void *writer_main(void *arg) {
+    Pipeline *p = ((const StageThread *)arg)->p;
+    trace_thread_name("writer");
+    // Pieces that arrived ahead of their turn, by seq modulo the pool size
+    Piece **waiting = checked_calloc((int64_t)p->piece_count, sizeof(Piece *));
+    DirWriter dw = {-1, -1, NULL};
+    uint64_t next = 0;
+    int64_t file_bytes = 0;     // Uncompressed size of the file so far
+    uint64_t written = 0;
+    TargetPoint at = {0, 0, 0};
+    Measure ms = {0, 0.0, 0.0, 0};
+    void *item;
+    while (queue_pop(&p->to_write, &item)) {
+        Piece *piece = item;
+        waiting[piece->seq % p->piece_count] = piece;
+        while ((piece = waiting[next % p->piece_count]) != NULL) {
+            waiting[next % p->piece_count] = NULL;
+            int64_t begin = trace_clock();
+            if (p->opts->measure) {
+                measure_piece(p, &ms, piece);
+            } else if (p->opts->files) {
+                // Once refused, the rest drains without being handed over
+                if (!p->stopped && write_piece_sink(p, piece) != 0) {
+                    __atomic_store_n(&p->stopped, 1, __ATOMIC_RELEASE);
                 }
-                free(json_str);
-                cJSON_Delete(current_array);
-            }
-            
-            strcpy(current_file_path, file_path);
-            current_array = cJSON_CreateArray();
-        }
-        
-        // Add message to current array
-        cJSON *msg = cJSON_CreateObject();
-        cJSON_AddStringToObject(msg, "user", m->user);
-        cJSON_AddStringToObject(msg, "type", m->type);
-        
-        char ts_str[32];
-        snprintf(ts_str, sizeof(ts_str), "%.6f", m->ts);
-        cJSON_AddStringToObject(msg, "ts", ts_str);
-        
-        cJSON_AddStringToObject(msg, "text", m->text);
-        
-        // Threading
-        if (m->thread_ts > 0) {
-            char thread_ts_str[32];
-            snprintf(thread_ts_str, sizeof(thread_ts_str), "%.6f", m->thread_ts);
-            cJSON_AddStringToObject(msg, "thread_ts", thread_ts_str);
-            
-            // If it's a child message (has parent_user_id)
-            if (m->parent_user_id[0] != '\0') {
-                cJSON_AddStringToObject(msg, "parent_user_id", m->parent_user_id);
+            } else if (p->opts->unpacked) {
+                write_piece_unpacked(p, &dw, piece);
+            } else {
+                write_piece_zipped(p, piece);
             }
-            
-            // If it's a parent message (has replies)
-            if (m->reply_count > 0) {
-                cJSON_AddNumberToObject(msg, "reply_count", m->reply_count);
-                
-                char latest_reply_str[32];
-                snprintf(latest_reply_str, sizeof(latest_reply_str), "%.6f", m->latest_reply);
-                cJSON_AddStringToObject(msg, "latest_reply", latest_reply_str);
-                
-                cJSON *replies = cJSON_CreateArray();
-                cJSON *reply_users = cJSON_CreateArray();
-                
-                char **unique_users = malloc(sizeof(char*) * (size_t)m->reply_count);
-                int unique_count = 0;
-                
-                for(int r=0; r < m->reply_count; r++) {
-                    cJSON *rep_obj = cJSON_CreateObject();
-                    cJSON_AddStringToObject(rep_obj, "user", m->replies[r].user);
-                    char r_ts_str[32];
-                    snprintf(r_ts_str, sizeof(r_ts_str), "%.6f", m->replies[r].ts);
-                    cJSON_AddStringToObject(rep_obj, "ts", r_ts_str);
-                    cJSON_AddItemToArray(replies, rep_obj);
-                    
-                    // Unique check
-                    int found = 0;
-                    for(int u=0; u<unique_count; u++) {
-                        if (strcmp(unique_users[u], m->replies[r].user) == 0) {
-                            found = 1;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        unique_users[unique_count++] = m->replies[r].user;
-                        cJSON_AddItemToArray(reply_users, cJSON_CreateString(m->replies[r].user));
-                    }
+            trace_span("store", begin, "%s%s%s", piece_dir(p, piece), piece->channel < 0 ? "" : "/", piece->file_name);
+            if (piece->kind == PIECE_MESSAGES) progress_add(PROGRESS_EXPORTED, (int64_t)piece->count);
+            file_bytes = (piece->first ? 0 : file_bytes) + (int64_t)piece->json.len;
+            written += piece->json.len;
+            if (p->stored_sizes) {
+                uint64_t size = p->opts->target->archive ? zip_writer_size(&p->zip) : written;
+                if (piece->kind == PIECE_MESSAGES) {
+                    at.messages += (int64_t)piece->count;
+                    at.drawn = piece->drawn;
                 }
-                free(unique_users);
-                
-                cJSON_AddNumberToObject(msg, "reply_users_count", unique_count);
-                cJSON_AddItemToObject(msg, "reply_users", reply_users);
-                cJSON_AddItemToObject(msg, "replies", replies);
-                
-                cJSON_AddBoolToObject(msg, "is_locked", 0); // false
-                cJSON_AddBoolToObject(msg, "subscribed", 0); // false
+                at.size = size;
+                p->stored_sizes[piece->seq % (2 * EXPORT_TARGET_LAG)] = at;
+                __atomic_store_n(&p->stored_pieces, piece->seq + 1, __ATOMIC_RELEASE);
             }
+            if (piece->last) {
+                progress_add(PROGRESS_FILES, 1);
+                metrics_observe(METRICS_FILE_BYTES, file_bytes);
+            }
+            next++;
+            queue_push(&p->free_pieces[piece->node], piece);
+        }
+    }
+    export_subdir_close(&p->dir, dw.channel_fd);
+    free(waiting);
+    p->written = written;
+    return NULL;
+}
+
+// Take a free piece for position seq from the node owning its channel,
+// waiting for the writer if needed. Root files are spread by seq.
+static Piece *take_piece(Pipeline *p, uint64_t seq, PieceKind kind, int64_t channel, const char *file_name, bool first) {
+    int node = channel >= 0 ? numa_owner(channel) : numa_owner((int64_t)seq);
+    void *item;
+    if (!queue_try_pop(&p->free_pieces[node], &item)) {
+        // Every piece is in flight: the stages behind are the bottleneck
+        int64_t begin = trace_clock();
+        queue_pop(&p->free_pieces[node], &item);
+        trace_span("wait for piece", begin, NULL);
+    }
+    Piece *piece = item;
+    piece->seq = seq;
+    piece->kind = kind;
+    piece->channel = channel;
+    snprintf(piece->file_name, sizeof(piece->file_name), "%s", file_name);
+    piece->first = first;
+    piece->last = false;
+    piece->begin = piece->end = 0;
+    piece->drawn = 0;
+    piece->count = 0;
+    piece->text_len = 0;
+    piece->reply_len = 0;
+    return piece;
+}
+
+static void submit(Pipeline *p, Piece *piece) {
+    queue_push(&p->to_render[piece->node], piece);
+}
+
+// Local calendar day holding t: its file name and [start, end) bounds
+static void day_of(time_t t, char *file_name, size_t size, time_t *start, time_t *end) {
+    struct tm tm;
+    localtime_r(&t, &tm);
+    strftime(file_name, size, "%Y-%m-%d.json", &tm);
+    tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    *start = mktime(&tm);
+    tm.tm_mday++;
+    tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    *end = mktime(&tm);
+    if (t < *start || t >= *end) {
+        // Odd time zone rules: do not cache this day
+        *start = t;
+        *end = t + 1;
+    }
+}
+
+// Cut users.json or channels.json into pieces of per entries
+static uint64_t produce_list(Pipeline *p, uint64_t seq, PieceKind kind, const char *file_name, int64_t count, int64_t per) {
+    int64_t begin = 0;
+    do {
+        Piece *piece = take_piece(p, seq++, kind, -1, file_name, begin == 0);
+        piece->begin = begin;
+        piece->end = count - begin > per ? begin + per : count;
+        piece->last = piece->end == count;
+        begin = piece->end;
+        submit(p, piece);
+    } while (begin < count);
+    return seq;
+}
+
+// --- Size targets ---
+
+// A thread with replies whose fate is decided, until its last reply
+typedef struct {
+    double thread_ts;
+    double latest_reply;
+    bool keep;
+} OpenThread;
+
+typedef struct {
+    double keep;                // Share of the messages to keep from here on
+    double owed;                // Messages the share asked for, minus those kept
+    int64_t seen;
+    int64_t kept;
+    int64_t channel;
+    OpenThread *open;
+    size_t open_count, open_capacity;
+} Thinning;
+
+// Decide whether to export a message. Threads are kept or dropped whole,
+// weighted by their size, so that the share kept tracks t->keep.
+static bool thin(Thinning *t, const StreamedMessage *sm) {
+    const Message *m = &sm->msg;
+    t->seen++;
+    if (m->channel_idx != t->channel) {
+        t->channel = m->channel_idx;
+        t->open_count = 0;
+    }
+
+    bool keep = true;
+    if (sm->parent_user_idx >= 0) {
+        // A reply follows its parent
+        for (size_t i = 0; i < t->open_count; i++) {
+            if (t->open[i].thread_ts != m->thread_ts) continue;
+            keep = t->open[i].keep;
+            if (m->ts >= t->open[i].latest_reply) t->open[i] = t->open[--t->open_count];
+            break;
+        }
+    } else {
+        double weight = 1.0 + (double)m->reply_count;
+        keep = t->owed + t->keep * weight >= weight / 2;
+        t->owed += t->keep * weight - (keep ? weight : 0.0);
+        if (m->reply_count > 0) {
+            grow(&t->open, &t->open_capacity, t->open_count + 1, sizeof(OpenThread));
+            t->open[t->open_count++] = (OpenThread){m->thread_ts, m->latest_reply, keep};
+        }
+    }
+    if (keep) t->kept++;
+    return keep;
+}
+
+// Share of the message bytes at share of the messages read, interpolated
+// between the profile's points
+static double profile_at(const double *profile, double share) {
+    double pos = share * EXPORT_PROFILE_POINTS;
+    if (pos <= 0.0) return profile[0];
+    if (pos >= EXPORT_PROFILE_POINTS) return profile[EXPORT_PROFILE_POINTS];
+    int i = (int)pos;
+    return profile[i] + (pos - i) * (profile[i + 1] - profile[i]);
+}
+
+// Before taking piece seq: set the share to keep so that what was stored
+// EXPORT_TARGET_LAG pieces back, what is in flight since, and the share
+// of the messages still to come add up to the target. Messages not yet
+// stored are costed along the calibrated profile rather than at the
+// average so far: the quiet channels written first cost more per message
+// and would hold the share down until it is too late.
+static void steer(Pipeline *p, Thinning *t, uint64_t seq) {
+    if (seq < EXPORT_TARGET_LAG) return;
+    uint64_t back = seq - EXPORT_TARGET_LAG;
+    for (unsigned attempt = 0; __atomic_load_n(&p->stored_pieces, __ATOMIC_ACQUIRE) <= back; attempt++) {
+        queue_backoff(attempt);
+    }
+    TargetPoint at = p->stored_sizes[back % (2 * EXPORT_TARGET_LAG)];
+
+    const ExportTarget *target = p->opts->target;
+    double total = (double)p->opts->message_count;
+    double all = target->message_bytes * total;
+    double stored_share = profile_at(target->profile, (double)at.drawn / total);
+    double read_share = profile_at(target->profile, (double)t->seen / total);
+    double in_flight = 0.0;
+    if (t->seen > at.drawn) {
+        in_flight = all * (read_share - stored_share) * (double)(t->kept - at.messages) / (double)(t->seen - at.drawn);
+    }
+    double left = (double)target->bytes - (double)at.size - in_flight;
+    double coming = all * (1.0 - read_share);
+    t->keep = coming > 0 ? left / coming : 0.0;
+    if (t->keep < 0.0) t->keep = 0.0;
+    if (t->keep > 1.0) t->keep = 1.0;
+}
+
+static void produce_messages(Pipeline *p, uint64_t seq, MessageSource next, void *source) {
+    Piece *piece = NULL;
+    char day_name[16] = "";
+    time_t day_start = 0, day_end = 0;
+    StreamedMessage sm;
+    Thinning thinning = {0};
+    thinning.keep = p->stored_sizes ? p->opts->target->keep : 1.0;
+    thinning.channel = -1;
+
+    while (!__atomic_load_n(&p->stopped, __ATOMIC_ACQUIRE) && next(source, &sm)) {
+        if (p->stored_sizes && !thin(&thinning, &sm)) continue;
+        const Message *m = &sm.msg;
+        time_t t = (time_t)m->ts;
+        if (t < day_start || t >= day_end) {
+            day_of(t, day_name, sizeof(day_name), &day_start, &day_end);
+        }
+
+        bool first = true;
+        if (piece && (m->channel_idx != piece->channel || strcmp(day_name, piece->file_name) != 0)) {
+            piece->last = true;
+            submit(p, piece);
+            piece = NULL;
+        } else if (piece && (piece->count >= EXPORT_PIECE_MESSAGES || piece->text_len >= EXPORT_PIECE_TEXT)) {
+            // Busy day: continue the same file in a new piece
+            submit(p, piece);
+            piece = NULL;
+            first = false;
+        }
+        if (!piece) {
+            if (p->stored_sizes) steer(p, &thinning, seq);
+            piece = take_piece(p, seq++, PIECE_MESSAGES, m->channel_idx, day_name, first);
+        }
+        piece_add(piece, &sm);
+        piece->drawn = thinning.seen;
+    }
+    free(thinning.open);
+
+    if (piece) {
+        piece->last = true;
+        submit(p, piece);
+    }
+}
+
+static void start_threads(pthread_t *threads, StageThread *args, int count, void *(*fn)(void *), Pipeline *p) {
+    for (int t = 0; t < count; t++) {
+        args[t].p = p;
+        args[t].index = t;
+        if (pthread_create(&threads[t], NULL, fn, &args[t]) != 0) {
+            fprintf(stderr, "Error: Cannot start export threads\n");
+            exit(1);
+        }
+    }
+}
+
+int export_write(const ExportOptions *opts, const User *users, int64_t user_count, const Channel *channels, int64_t channel_count, const IdKeys *ids, MessageSource next, void *source) {
+    Pipeline p;
+    memset(&p, 0, sizeof(p));
+    p.opts = opts;
+    p.users = users;
+    p.user_count = user_count;
+    p.channels = channels;
+    p.channel_count = channel_count;
+    p.ids = ids;
+
+    // A dry run still serialises and compresses, to measure the output
+    bool writing = !opts->measure;
+    bool to_disk = writing && !opts->files;
+    p.packing = !opts->unpacked && !opts->files;
+    if (to_disk && opts->unpacked) {
+        if (export_dir_open(&p.dir, opts->output, opts->sync, opts->io) != 0) return -1;
+    } else if (to_disk) {
+        if (export_dir_open(&p.dir, ".", opts->sync, opts->io) != 0) return -1;
+        if (zip_writer_open(&p.zip, &p.dir, opts->output) != 0) {
+            export_dir_close(&p.dir);
+            return -1;
+        }
+    }
+    progress_phase(PROGRESS_PHASE_EXPORT, opts->message_count);
+    if (to_disk && opts->log) {
+        progress_clear();
+        fprintf(opts->log, "Exporting data to %s (%s writes)...\n", opts->output, export_io_backend_name(&p.dir));
+    }
+
+    int workers = opts->workers > 0 ? opts->workers : 1;
+    int compressors = p.packing ? workers : 0;
+    p.nodes = numa_node_count();
+    p.piece_count = 4 * (size_t)workers + 4 * (size_t)p.nodes;
+    p.pieces = checked_calloc((int64_t)p.piece_count, sizeof(Piece));
+    // Every queue can hold the whole pool, so pushes never wait
+    p.free_pieces = checked_alloc(p.nodes, sizeof(TaskQueue));
+    p.to_render = checked_alloc(p.nodes, sizeof(TaskQueue));
+    p.to_pack = checked_alloc(p.nodes, sizeof(TaskQueue));
+    int run = __atomic_add_fetch(&export_runs, 1, __ATOMIC_RELAXED);
+    char labels[64];
+    for (int n = 0; n < p.nodes; n++) {
+        queue_init(&p.free_pieces[n], p.piece_count, 1);
+        queue_init(&p.to_render[n], p.piece_count, 1);
+        queue_init(&p.to_pack[n], p.piece_count, workers);
+        snprintf(labels, sizeof(labels), "run=\"%d\",queue=\"free\",node=\"%d\"", run, n);
+        metrics_gauge_add("syngen_queue_depth", labels, queue_depth_gauge, &p.free_pieces[n]);
+        snprintf(labels, sizeof(labels), "run=\"%d\",queue=\"render\",node=\"%d\"", run, n);
+        metrics_gauge_add("syngen_queue_depth", labels, queue_depth_gauge, &p.to_render[n]);
+        if (compressors > 0) {
+            snprintf(labels, sizeof(labels), "run=\"%d\",queue=\"pack\",node=\"%d\"", run, n);
+            metrics_gauge_add("syngen_queue_depth", labels, queue_depth_gauge, &p.to_pack[n]);
+        }
+    }
+    queue_init(&p.to_write, p.piece_count, workers);
+    snprintf(labels, sizeof(labels), "run=\"%d\",queue=\"write\"", run);
+    metrics_gauge_add("syngen_queue_depth", labels, queue_depth_gauge, &p.to_write);
+    for (size_t i = 0; i < p.piece_count; i++) {
+        json_writer_init(&p.pieces[i].json, 0);
+        p.pieces[i].node = numa_owner((int64_t)i);
+        queue_push(&p.free_pieces[p.pieces[i].node], &p.pieces[i]);
+    }
+
+    if (writing && opts->target) {
+        p.stored_sizes = checked_calloc(2 * EXPORT_TARGET_LAG, sizeof(TargetPoint));
+    }
+
+    int thread_count = workers + compressors + 1;
+    pthread_t *threads = checked_alloc(thread_count, sizeof(pthread_t));
+    StageThread *args = checked_alloc(thread_count, sizeof(StageThread));
+    start_threads(threads, args, workers, serialiser_main, &p);
+    start_threads(threads + workers, args + workers, compressors, compressor_main, &p);
+    start_threads(threads + workers + compressors, args + workers + compressors, 1, writer_main, &p);
+
+    uint64_t seq = 0;
+    seq = produce_list(&p, seq, PIECE_USERS, "users.json", user_count, EXPORT_PIECE_USERS);
+    seq = produce_list(&p, seq, PIECE_CHANNELS, "channels.json", channel_count, EXPORT_PIECE_CHANNELS);
+    produce_messages(&p, seq, next, source);
+    for (int n = 0; n < p.nodes; n++) queue_done(&p.to_render[n]);
+
+    for (int t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(args);
+    free(threads);
+    for (int n = 0; n < p.nodes; n++) {
+        metrics_gauge_remove(&p.free_pieces[n]);
+        metrics_gauge_remove(&p.to_render[n]);
+        metrics_gauge_remove(&p.to_pack[n]);
+    }
+    metrics_gauge_remove(&p.to_write);
+
+    int status = p.stopped ? -1 : 0;
+    if (to_disk) {
+        if (!opts->unpacked) zip_writer_close(&p.zip);
+        int error = export_dir_close(&p.dir);
+        if (error != 0) {
+            progress_clear();
+            fprintf(stderr, "Error: %s is incomplete: %s\n", opts->output, strerror(error));
+            status = -1;
+        }
+    }
+    if (p.stored_sizes) {
+        opts->target->reached = opts->target->archive ? p.zip.offset : p.written;
+        free(p.stored_sizes);
+    }
+
+    if (opts->measure) {
+        opts->measure->pieces = p.piece_count;
+        opts->measure->piece_channels = EXPORT_PIECE_CHANNELS;
+    }
+    for (size_t i = 0; i < p.piece_count; i++) {
+        Piece *piece = &p.pieces[i];
+        if (opts->measure) {
+            opts->measure->buffer_bytes += piece->capacity * sizeof(PieceMessage) + piece->text_capacity +
+                piece->reply_capacity * sizeof(ReplyRef) + piece->json.cap + piece->packed_capacity;
         }
-        
-        cJSON_AddItemToArray(current_array, msg);
-    }
-    
-    // Write last array
-    if (current_array) {
-        char *json_str = cJSON_Print(current_array);
-        FILE *fp = fopen(current_file_path, "w");
-        if (fp) {
-            fputs(json_str, fp);
-            fclose(fp);
+        free(piece->messages);
+        free(piece->text);
+        free(piece->replies);
+        free(piece->packed);
+        json_writer_free(&piece->json);
+    }
+    free(p.pieces);
+    for (int n = 0; n < p.nodes; n++) {
+        queue_free(&p.free_pieces[n]);
+        queue_free(&p.to_render[n]);
+        queue_free(&p.to_pack[n]);
+    }
+    free(p.free_pieces);
+    free(p.to_render);
+    free(p.to_pack);
+    queue_free(&p.to_write);
+    return status;
+}
+
+// --- In-memory source ---
+
+// Number of bits needed to hold v
+static int bit_width(uint64_t v) {
+    int bits = 0;
+    while (v) {
+        bits++;
+        v >>= 1;
+    }
+    return bits;
+}
+
+void sorted_messages_init(SortedMessages *sorted, const Message *messages, int64_t count, const ThreadIndex *threads, int workers) {
+    // Messages are written grouped by channel, then day, then timestamp.
+    // The day is a function of the timestamp, so (channel, ts) gives the
+    // same order. Both are packed into one 64-bit key, channel above the
+    // microseconds since the earliest message, and radix sorted along with
+    // the message indices.
+    uint64_t *keys = big_alloc(count, sizeof(uint64_t));
+    int64_t *order = big_alloc(count, sizeof(int64_t));
+    uint64_t min_us = UINT64_MAX, max_us = 0;
+    int64_t max_channel = 0;
+    for (int64_t i = 0; i < count; i++) {
+        uint64_t us = (uint64_t)llround(messages[i].ts * 1e6);
+        keys[i] = us;
+        order[i] = i;
+        if (us < min_us) min_us = us;
+        if (us > max_us) max_us = us;
+        if (messages[i].channel_idx > max_channel) max_channel = messages[i].channel_idx;
+    }
+
+    int ts_bits = count > 0 ? bit_width(max_us - min_us) : 0;
+    int channel_bits = bit_width((uint64_t)max_channel);
+    if (ts_bits + channel_bits <= 64) {
+        for (int64_t i = 0; i < count; i++) {
+            uint64_t channel = (uint64_t)messages[i].channel_idx;
+            keys[i] = ts_bits < 64 ? (channel << ts_bits) | (keys[i] - min_us) : keys[i] - min_us;
+        }
+        radix_sort_pairs(keys, order, (size_t)count, workers);
+    } else {
+        // Too wide to pack: sort by timestamp, then stably by channel
+        radix_sort_pairs(keys, order, (size_t)count, workers);
+        for (int64_t i = 0; i < count; i++) {
+            keys[i] = (uint64_t)messages[order[i]].channel_idx;
         }
-        free(json_str);
-        cJSON_Delete(current_array);
+        radix_sort_pairs(keys, order, (size_t)count, workers);
     }
-    
-    free(refs);
+    big_free(keys);
+
+    sorted->messages = messages;
+    sorted->threads = threads;
+    sorted->order = order;
+    sorted->count = count;
+    sorted->next = 0;
+    sorted->replies = NULL;
+    sorted->reply_capacity = 0;
 }
 
-void export_finalize(const char *base_path, const char *output_filename) {
-    // System call to zip
-    char command[1024];
-    // Zip contents of base_path into output_filename
-    // cd base_path && zip -r ../output_filename .
-    
-    // Ensure output filename is absolute or handles paths correctly.
-    // For simplicity, we assume output_filename is in current dir or relative to CWD.
-    // zip command: zip -r <zipfile> <directory>
-    
-    // Better: zip -r output.zip base_path
-    // But then the zip root is base_path. Slack expects files at root.
-    // So we must cd into base_path.
-    
-    snprintf(command, sizeof(command), "cd %s && zip -q -r ../%s .", base_path, output_filename);
-    
-    printf("Creating archive %s...\n", output_filename);
-    int ret = system(command);
-    if (ret != 0) {
-        fprintf(stderr, "Zip command failed with code %d\n", ret);
+bool sorted_messages_next(void *source, StreamedMessage *out) {
+    SortedMessages *sorted = source;
+    if (sorted->next == sorted->count) return false;
+    const Message *messages = sorted->messages;
+    int64_t original_idx = sorted->order[sorted->next++];
+    const Message *m = &messages[original_idx];
+
+    // Reply lists are gathered from the thread index into one reused buffer
+    int64_t first = sorted->threads->offsets[original_idx];
+    int64_t last = sorted->threads->offsets[original_idx + 1];
+    if ((size_t)(last - first) > sorted->reply_capacity) {
+        sorted->reply_capacity = (size_t)(last - first);
+        free(sorted->replies);
+        sorted->replies = checked_alloc(last - first, sizeof(ReplyRef));
     }
+    for (int64_t r = first; r < last; r++) {
+        const Message *rep = &messages[sorted->threads->children[r]];
+        sorted->replies[r - first].ts = rep->ts;
+        sorted->replies[r - first].user_idx = rep->user_idx;
+    }
+
+    out->msg = *m;
+    out->parent_user_idx = m->parent_idx >= 0 ? messages[m->parent_idx].user_idx : -1;
+    out->replies = sorted->replies;
+    return true;
+}
+
+void sorted_messages_free(SortedMessages *sorted) {
+    free(sorted->replies);
+    big_free(sorted->order);
 }
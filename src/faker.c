@@ -5,154 +5,165 @@
 #include "faker.h"
 #include "faker_data.h"
 
-void faker_init() {
-    srand((unsigned int)time(NULL));
+// Append a random word at buffer + len, given room for at least the longest
+// word. Words come from vocab, or the built-in list if it is NULL.
+static size_t append_word(Rng *rng, const Vocabulary *vocab, char *buffer, size_t len) {
+    if (vocab) {
+        int64_t rank = vocab_sample(vocab, rng);
+        return vocab_word(vocab, rank, buffer + len);
+    }
+    uint32_t idx = rng_range(rng, (uint32_t)faker_words_count);
+    size_t word_len = faker_words_len[idx];
+    memcpy(buffer + len, faker_words_blob + faker_words_offsets[idx], word_len);
+    return word_len;
 }
 
 // Helper to get random int in range [min, max]
-static int rand_range(int min, int max) {
-    return min + rand() % (max - min + 1);
-}
-
-// Helper to generate a random alphanumeric string
-static void rand_alphanum(char *buffer, int length) {
-    const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    for (int i = 0; i < length; i++) {
-        int key = rand() % (int)(sizeof(charset) - 1);
-        buffer[i] = charset[key];
-    }
-    buffer[length] = '\0';
+static int rand_range(Rng *rng, int min, int max) {
+    return min + (int)rng_range(rng, (uint32_t)(max - min + 1));
 }
 
-// Helper to generate a random hex string
-static void rand_hex(char *buffer, int length) {
-    const char charset[] = "0123456789abcdef";
-    for (int i = 0; i < length; i++) {
-        int key = rand() % (int)(sizeof(charset) - 1);
-        buffer[i] = charset[key];
-    }
-    buffer[length] = '\0';
-}
-
-void faker_get_id(char *buffer, const char *prefix) {
-    // Slack IDs: U + 8-10 alphanumeric upper
-    // E.g. U02M3TMTV9B
-    // We'll standardise on Prefix + 10 chars
-    strcpy(buffer, prefix);
-    rand_alphanum(buffer + strlen(prefix), 10);
-}
-
-void faker_get_uuid(char *buffer) {
-    // Simplified UUID-like string
-    // xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
-    // For now, just a random hex string or similar unique token
-    // Slack often uses simple alphanumeric strings for file IDs etc.
-    // Let's stick to a 12 char hex for now if needed, or implement full UUID v4
-    // Implementation of full UUID v4:
-    const char *hex_digits = "0123456789abcdef";
-    for (int i = 0; i < 36; i++) {
-        if (i == 8 || i == 13 || i == 18 || i == 23) {
-            buffer[i] = '-';
-        } else if (i == 14) {
-            buffer[i] = '4';
-        } else if (i == 19) {
-            buffer[i] = hex_digits[(rand() % 4) + 8];
-        } else {
-            buffer[i] = hex_digits[rand() % 16];
-        }
-    }
+void faker_get_uuid(Rng *rng, char *buffer) {
+    // UUID v4: xxxxxxxx-xxxx-4xxx-Nxxx-xxxxxxxxxxxx with N in 8..b
+    // 30 random hex digits, and the variant from two bits of a word of its own
+    static const char variant[] = "89ab";
+    char hex[30];
+    rng_hex(rng, hex, sizeof(hex));
+    memcpy(buffer, hex, 8);
+    buffer[8] = '-';
+    memcpy(buffer + 9, hex + 8, 4);
+    buffer[13] = '-';
+    buffer[14] = '4';
+    memcpy(buffer + 15, hex + 12, 3);
+    buffer[18] = '-';
+    buffer[19] = variant[rng_next(rng) >> 62];
+    memcpy(buffer + 20, hex + 15, 3);
+    buffer[23] = '-';
+    memcpy(buffer + 24, hex + 18, 12);
     buffer[36] = '\0';
 }
 
-char *faker_lorem_word() {
-    int idx = rand() % faker_words_count;
+char *faker_lorem_word(Rng *rng) {
+    uint32_t idx = rng_range(rng, (uint32_t)faker_words_count);
     // Return a copy? Or const char*? 
     // The header defines returns as char*, implying ownership. 
     // Let's return a duplicate to be safe for modification/freeing.
-    return strdup(faker_words[idx]);
+    return strndup(faker_words_blob + faker_words_offsets[idx], faker_words_len[idx]);
 }
 
-char *faker_lorem_sentence(int min_words, int max_words) {
-    int count = rand_range(min_words, max_words);
-    size_t total_len = 0;
-    
-    // First pass: calculate length
-    // We'll just alloc a safe large buffer or realloc. 
-    // Let's guess average word length 6 + space.
-    size_t capacity = (size_t)count * 10 + 1;
-    char *sentence = malloc(capacity);
-    sentence[0] = '\0';
+// Longest word the current word source can produce
+#define FAKER_MAX_WORD_LEN (FAKER_WORDS_MAX_LEN > VOCAB_WORD_MAX_LEN ? FAKER_WORDS_MAX_LEN : VOCAB_WORD_MAX_LEN)
+
+size_t faker_lorem_sentence_max_len(int max_words) {
+    // Each word plus a separating space or the final period, and the NUL
+    return (size_t)max_words * (FAKER_MAX_WORD_LEN + 1) + 1;
+}
+
+static size_t sentence_into(Rng *rng, const Vocabulary *vocab, char *buffer, size_t capacity, int min_words, int max_words) {
+    int count = rand_range(rng, min_words, max_words);
+    size_t len = 0;
     
     for (int i = 0; i < count; i++) {
-        const char *word = faker_words[rand() % faker_words_count];
-        size_t word_len = strlen(word);
-        
-        // Resize if needed
-        if (total_len + word_len + 2 > capacity) {
-            capacity *= 2;
-            char *tmp = realloc(sentence, capacity);
-            if (!tmp) {
-                free(sentence);
-                return NULL;
-            }
-            sentence = tmp;
-        }
+        // Keep room for the separator, the longest word, the period and the NUL
+        if (len + FAKER_MAX_WORD_LEN + 3 > capacity) break;
         
-        if (i == 0) {
-            // Capitalize first letter
-            char temp[128];
-            strncpy(temp, word, 127);
-            temp[0] = (char)toupper((unsigned char)temp[0]);
-            strcpy(sentence, temp);
-            total_len += word_len;
-        } else {
-            strcat(sentence, " ");
-            strcat(sentence, word);
-            total_len += 1 + word_len;
+        if (i > 0) {
+            buffer[len++] = ' ';
         }
+        len += append_word(rng, vocab, buffer, len);
+    }
+    if (len > 0) {
+        // Capitalize first letter
+        buffer[0] = (char)toupper((unsigned char)buffer[0]);
+    }
+    if (len + 2 <= capacity) {
+        buffer[len++] = '.';
+    }
+    if (capacity > 0) {
+        buffer[len] = '\0';
     }
-    strcat(sentence, ".");
+    return len;
+}
+
+size_t faker_lorem_sentence_into(Rng *rng, char *buffer, size_t capacity, int min_words, int max_words) {
+    return sentence_into(rng, NULL, buffer, capacity, min_words, max_words);
+}
+
+char *faker_lorem_sentence(Rng *rng, int min_words, int max_words) {
+    size_t capacity = faker_lorem_sentence_max_len(max_words);
+    char *sentence = malloc(capacity);
+    if (!sentence) return NULL;
+    faker_lorem_sentence_into(rng, sentence, capacity, min_words, max_words);
     return sentence;
 }
 
-char *faker_lorem_paragraph(int min_sentences, int max_sentences) {
-    int count = rand_range(min_sentences, max_sentences);
-    char *paragraph = malloc(1);
-    paragraph[0] = '\0';
+char *faker_lorem_sentence_arena(Rng *rng, TextArena *arena, int min_words, int max_words) {
+    size_t capacity = faker_lorem_sentence_max_len(max_words);
+    char *sentence = text_arena_reserve(arena, capacity);
+    if (!sentence) return NULL;
+    size_t len = faker_lorem_sentence_into(rng, sentence, capacity, min_words, max_words);
+    text_arena_commit(arena, len + 1);
+    return sentence;
+}
+
+const char *faker_message_text(Rng *rng, const TextSource *source, TextArena *arena, int min_words, int max_words, size_t *len) {
+    if (source->corpus) {
+        return corpus_unit(source->corpus, rng_next(rng) % source->corpus->count, len);
+    }
+    size_t capacity = faker_lorem_sentence_max_len(max_words);
+    char *text = text_arena_reserve(arena, capacity);
+    if (!text) {
+        *len = 0;
+        return "";
+    }
+    *len = sentence_into(rng, source->vocab, text, capacity, min_words, max_words);
+    text_arena_commit(arena, *len + 1);
+    return text;
+}
+
+size_t faker_lorem_paragraph_max_len(int max_sentences) {
+    // Sentences of up to 12 words, each followed by a space
+    return (size_t)max_sentences * faker_lorem_sentence_max_len(12) + 1;
+}
+
+size_t faker_lorem_paragraph_into(Rng *rng, char *buffer, size_t capacity, int min_sentences, int max_sentences) {
+    int count = rand_range(rng, min_sentences, max_sentences);
+    size_t len = 0;
     
-    for (int i = 0; i < count; i++) {
-        char *sent = faker_lorem_sentence(4, 12);
-        if (!sent) { // Handle failure
-            free(paragraph);
-            return NULL;
-        }
-        size_t new_len = strlen(paragraph) + strlen(sent) + 2;
-        char *tmp = realloc(paragraph, new_len);
-        if (!tmp) {
-            free(paragraph);
-            free(sent);
-            return NULL;
-        }
-        paragraph = tmp;
-        strcat(paragraph, sent);
-        strcat(paragraph, " ");
-        free(sent);
+    if (capacity > 0) {
+        buffer[0] = '\0';
+    }
+    for (int i = 0; i < count && len + 2 < capacity; i++) {
+        // Sentences are written in place; the trailing space replaces the NUL
+        len += faker_lorem_sentence_into(rng, buffer + len, capacity - len - 1, 4, 12);
+        buffer[len++] = ' ';
+        buffer[len] = '\0';
     }
+    return len;
+}
+
+char *faker_lorem_paragraph(Rng *rng, int min_sentences, int max_sentences) {
+    size_t capacity = faker_lorem_paragraph_max_len(max_sentences);
+    char *paragraph = malloc(capacity);
+    if (!paragraph) return NULL;
+    faker_lorem_paragraph_into(rng, paragraph, capacity, min_sentences, max_sentences);
     return paragraph;
 }
 
-void faker_create_user(User *user) {
-    faker_get_id(user->id, "U");
-    
+void faker_set_user_email(User *user) {
+    snprintf(user->email, sizeof(user->email), "%s@example.com", user->name);
+}
+
+void faker_create_user(Rng *rng, User *user) {
     // Pick gender (0: male, 1: female)
-    int gender = rand() % 2;
+    int gender = (int)rng_range(rng, 2);
     const char *first;
     if (gender == 0) {
-        first = faker_first_names_male[rand() % faker_first_names_male_count];
+        first = faker_first_names_male[rng_range(rng, (uint32_t)faker_first_names_male_count)];
     } else {
-        first = faker_first_names_female[rand() % faker_first_names_female_count];
+        first = faker_first_names_female[rng_range(rng, (uint32_t)faker_first_names_female_count)];
     }
-    const char *last = faker_last_names[rand() % faker_last_names_count];
+    const char *last = faker_last_names[rng_range(rng, (uint32_t)faker_last_names_count)];
     
     snprintf(user->real_name, sizeof(user->real_name), "%s %s", first, last);
     
@@ -161,32 +172,33 @@ void faker_create_user(User *user) {
     // Lowercase it
     for(char *p = user->name; *p; ++p) *p = (char)tolower((unsigned char)*p);
     
-    snprintf(user->email, sizeof(user->email), "%s@example.com", user->name);
+    faker_set_user_email(user);
     
     // Defaults
     user->is_admin = false;
     user->is_bot = false;
     
     // Avatar hash (random hex)
-    rand_hex(user->avatar_hash, 32);
+    rng_hex(rng, user->avatar_hash, 32);
+    user->avatar_hash[32] = '\0';
 }
 
-void faker_create_channel(Channel *channel, const char *creator_id) {
-    faker_get_id(channel->id, "C");
-    
+void faker_create_channel(Rng *rng, Channel *channel, int64_t creator_idx) {
     // Channel name: random-word-random-word
-    const char *w1 = faker_words[rand() % faker_words_count];
-    const char *w2 = faker_words[rand() % faker_words_count];
-    snprintf(channel->name, sizeof(channel->name), "%s-%s", w1, w2);
+    uint32_t w1 = rng_range(rng, (uint32_t)faker_words_count);
+    uint32_t w2 = rng_range(rng, (uint32_t)faker_words_count);
+    snprintf(channel->name, sizeof(channel->name), "%.*s-%.*s",
+             faker_words_len[w1], faker_words_blob + faker_words_offsets[w1],
+             faker_words_len[w2], faker_words_blob + faker_words_offsets[w2]);
     
-    channel->created = (long)time(NULL) - rand() % (365 * 24 * 3600); // Created within last year
-    strcpy(channel->creator, creator_id);
-    channel->members = NULL;
+    channel->created = (long)time(NULL) - (long)rng_range(rng, 365 * 24 * 3600); // Created within last year
+    channel->creator_idx = creator_idx;
+    channel->member_idx = NULL;
     channel->member_count = 0;
 }
 
-double faker_get_timestamp(time_t start_time, time_t end_time) {
+double faker_get_timestamp(Rng *rng, time_t start_time, time_t end_time) {
     double range = difftime(end_time, start_time);
-    double offset = ((double)rand() / RAND_MAX) * range;
+    double offset = rng_uniform(rng) * range;
     return (double)start_time + offset;
 }
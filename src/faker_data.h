@@ -1719,980 +1719,2296 @@ static const char *faker_last_names[] = {
 
 static const int faker_last_names_count = 1000;
 
-static const char *faker_words[] = {
-    "a",
-    "ability",
-    "able",
-    "about",
-    "above",
-    "accept",
-    "according",
-    "account",
-    "across",
-    "act",
-    "action",
-    "activity",
-    "actually",
-    "add",
-    "address",
-    "administration",
-    "admit",
-    "adult",
-    "affect",
-    "after",
-    "again",
-    "against",
-    "age",
-    "agency",
-    "agent",
-    "ago",
-    "agree",
-    "agreement",
-    "ahead",
-    "air",
-    "all",
-    "allow",
-    "almost",
-    "alone",
-    "along",
-    "already",
-    "also",
-    "although",
-    "always",
-    "American",
-    "among",
-    "amount",
-    "analysis",
-    "and",
-    "animal",
-    "another",
-    "answer",
-    "any",
-    "anyone",
-    "anything",
-    "appear",
-    "apply",
-    "approach",
-    "area",
-    "argue",
-    "arm",
-    "around",
-    "arrive",
-    "art",
-    "article",
-    "artist",
-    "as",
-    "ask",
-    "assume",
-    "at",
-    "attack",
-    "attention",
-    "attorney",
-    "audience",
-    "author",
-    "authority",
-    "available",
-    "avoid",
-    "away",
-    "baby",
-    "back",
-    "bad",
-    "bag",
-    "ball",
-    "bank",
-    "bar",
-    "base",
-    "be",
-    "beat",
-    "beautiful",
-    "because",
-    "become",
-    "bed",
-    "before",
-    "begin",
-    "behavior",
-    "behind",
-    "believe",
-    "benefit",
-    "best",
-    "better",
-    "between",
-    "beyond",
-    "big",
-    "bill",
-    "billion",
-    "bit",
-    "black",
-    "blood",
-    "blue",
-    "board",
-    "body",
-    "book",
-    "born",
-    "both",
-    "box",
-    "boy",
-    "break",
-    "bring",
-    "brother",
-    "budget",
-    "build",
-    "building",
-    "business",
-    "but",
-    "buy",
-    "by",
-    "call",
-    "camera",
-    "campaign",
-    "can",
-    "candidate",
-    "capital",
-    "car",
-    "card",
-    "care",
-    "career",
-    "carry",
-    "case",
-    "catch",
-    "cause",
-    "cell",
-    "center",
-    "central",
-    "century",
-    "certain",
-    "certainly",
-    "chair",
-    "challenge",
-    "chance",
-    "change",
-    "character",
-    "charge",
-    "check",
-    "child",
-    "choice",
-    "choose",
-    "church",
-    "citizen",
-    "city",
-    "civil",
-    "claim",
-    "class",
-    "clear",
-    "clearly",
-    "close",
-    "coach",
-    "cold",
-    "collection",
-    "college",
-    "color",
-    "commercial",
-    "common",
-    "community",
-    "company",
-    "compare",
-    "computer",
-    "concern",
-    "condition",
-    "conference",
-    "Congress",
-    "consider",
-    "consumer",
-    "contain",
-    "continue",
-    "control",
-    "cost",
-    "could",
-    "country",
-    "couple",
-    "course",
-    "court",
-    "cover",
-    "create",
-    "crime",
-    "cultural",
-    "culture",
-    "cup",
-    "current",
-    "customer",
-    "cut",
-    "dark",
-    "data",
-    "daughter",
-    "day",
-    "deal",
-    "debate",
-    "decade",
-    "decide",
-    "decision",
-    "deep",
-    "defense",
-    "degree",
-    "Democrat",
-    "democratic",
-    "describe",
-    "design",
-    "despite",
-    "detail",
-    "determine",
-    "develop",
-    "development",
-    "difference",
-    "different",
-    "difficult",
-    "dinner",
-    "direction",
-    "director",
-    "discover",
-    "discuss",
-    "discussion",
-    "do",
-    "doctor",
-    "dog",
-    "door",
-    "down",
-    "draw",
-    "dream",
-    "drive",
-    "drop",
-    "drug",
-    "during",
-    "each",
-    "early",
-    "east",
-    "easy",
-    "eat",
-    "economic",
-    "economy",
-    "edge",
-    "education",
-    "effect",
-    "effort",
-    "eight",
-    "either",
-    "election",
-    "else",
-    "employee",
-    "end",
-    "energy",
-    "enjoy",
-    "enough",
-    "enter",
-    "entire",
-    "environment",
-    "environmental",
-    "especially",
-    "establish",
-    "even",
-    "evening",
-    "event",
-    "ever",
-    "every",
-    "everybody",
-    "everyone",
-    "everything",
-    "evidence",
-    "exactly",
-    "example",
-    "executive",
-    "exist",
-    "expect",
-    "experience",
-    "expert",
-    "explain",
-    "eye",
-    "face",
-    "fact",
-    "factor",
-    "fall",
-    "family",
-    "far",
-    "fast",
-    "father",
-    "fear",
-    "federal",
-    "feel",
-    "feeling",
-    "few",
-    "field",
-    "fight",
-    "figure",
-    "fill",
-    "film",
-    "final",
-    "finally",
-    "financial",
-    "find",
-    "fine",
-    "finish",
-    "fire",
-    "firm",
-    "first",
-    "fish",
-    "five",
-    "floor",
-    "fly",
-    "focus",
-    "follow",
-    "food",
-    "foot",
-    "for",
-    "force",
-    "foreign",
-    "forget",
-    "form",
-    "former",
-    "forward",
-    "four",
-    "free",
-    "friend",
-    "from",
-    "front",
-    "full",
-    "fund",
-    "future",
-    "game",
-    "garden",
-    "gas",
-    "general",
-    "generation",
-    "get",
-    "girl",
-    "give",
-    "glass",
-    "go",
-    "goal",
-    "good",
-    "government",
-    "great",
-    "green",
-    "ground",
-    "group",
-    "grow",
-    "growth",
-    "guess",
-    "gun",
-    "guy",
-    "hair",
-    "half",
-    "hand",
-    "happen",
-    "happy",
-    "hard",
-    "have",
-    "he",
-    "head",
-    "health",
-    "hear",
-    "heart",
-    "heavy",
-    "help",
-    "her",
-    "here",
-    "herself",
-    "high",
-    "him",
-    "himself",
-    "his",
-    "history",
-    "hit",
-    "hold",
-    "home",
-    "hope",
-    "hospital",
-    "hot",
-    "hotel",
-    "hour",
-    "house",
-    "how",
-    "however",
-    "huge",
-    "human",
-    "hundred",
-    "husband",
-    "I",
-    "idea",
-    "identify",
-    "if",
-    "image",
-    "imagine",
-    "impact",
-    "important",
-    "improve",
-    "in",
-    "include",
-    "including",
-    "increase",
-    "indeed",
-    "indicate",
-    "individual",
-    "industry",
-    "information",
-    "inside",
-    "instead",
-    "institution",
-    "interest",
-    "interesting",
-    "international",
-    "interview",
-    "into",
-    "investment",
-    "involve",
-    "issue",
-    "it",
-    "item",
-    "its",
-    "itself",
-    "job",
-    "join",
-    "just",
-    "keep",
-    "key",
-    "kid",
-    "kind",
-    "kitchen",
-    "know",
-    "knowledge",
-    "land",
-    "language",
-    "large",
-    "last",
-    "late",
-    "later",
-    "laugh",
-    "law",
-    "lawyer",
-    "lay",
-    "lead",
-    "leader",
-    "learn",
-    "least",
-    "leave",
-    "left",
-    "leg",
-    "less",
-    "let",
-    "letter",
-    "level",
-    "life",
-    "light",
-    "like",
-    "likely",
-    "line",
-    "list",
-    "listen",
-    "little",
-    "live",
-    "local",
-    "long",
-    "look",
-    "lose",
-    "loss",
-    "lot",
-    "low",
-    "machine",
-    "magazine",
-    "main",
-    "maintain",
-    "major",
-    "majority",
-    "make",
-    "man",
-    "manage",
-    "management",
-    "manager",
-    "many",
-    "market",
-    "marriage",
-    "material",
-    "matter",
-    "may",
-    "maybe",
-    "me",
-    "mean",
-    "measure",
-    "media",
-    "medical",
-    "meet",
-    "meeting",
-    "member",
-    "memory",
-    "mention",
-    "message",
-    "method",
-    "middle",
-    "might",
-    "military",
-    "million",
-    "mind",
-    "minute",
-    "miss",
-    "mission",
-    "model",
-    "modern",
-    "moment",
-    "money",
-    "month",
-    "more",
-    "morning",
-    "most",
-    "mother",
-    "mouth",
-    "move",
-    "movement",
-    "movie",
-    "Mr",
-    "Mrs",
-    "much",
-    "music",
-    "must",
-    "my",
-    "myself",
-    "name",
-    "nation",
-    "national",
-    "natural",
-    "nature",
-    "near",
-    "nearly",
-    "necessary",
-    "need",
-    "network",
-    "never",
-    "new",
-    "news",
-    "newspaper",
-    "next",
-    "nice",
-    "night",
-    "no",
-    "none",
-    "nor",
-    "north",
-    "not",
-    "note",
-    "nothing",
-    "notice",
-    "now",
-    "number",
-    "occur",
-    "of",
-    "off",
-    "offer",
-    "office",
-    "officer",
-    "official",
-    "often",
-    "oil",
-    "ok",
-    "old",
-    "on",
-    "once",
-    "one",
-    "only",
-    "onto",
-    "open",
-    "operation",
-    "opportunity",
-    "option",
-    "or",
-    "order",
-    "organization",
-    "other",
-    "others",
-    "our",
-    "out",
-    "outside",
-    "over",
-    "own",
-    "owner",
-    "page",
-    "painting",
-    "paper",
-    "parent",
-    "part",
-    "participant",
-    "particular",
-    "particularly",
-    "partner",
-    "party",
-    "pass",
-    "past",
-    "pattern",
-    "pay",
-    "peace",
-    "people",
-    "per",
-    "perform",
-    "performance",
-    "perhaps",
-    "person",
-    "personal",
-    "phone",
-    "physical",
-    "pick",
-    "picture",
-    "piece",
-    "place",
-    "plan",
-    "plant",
-    "play",
-    "player",
-    "PM",
-    "point",
-    "police",
-    "policy",
-    "political",
-    "politics",
-    "poor",
-    "popular",
-    "population",
-    "position",
-    "positive",
-    "possible",
-    "power",
-    "practice",
-    "prepare",
-    "present",
-    "president",
-    "pressure",
-    "pretty",
-    "prevent",
-    "price",
-    "probably",
-    "process",
-    "produce",
-    "product",
-    "production",
-    "professional",
-    "professor",
-    "program",
-    "project",
-    "property",
-    "protect",
-    "prove",
-    "provide",
-    "public",
-    "pull",
-    "purpose",
-    "push",
-    "put",
-    "quality",
-    "question",
-    "quickly",
-    "quite",
-    "race",
-    "radio",
-    "raise",
-    "range",
-    "rate",
-    "rather",
-    "reach",
-    "read",
-    "ready",
-    "real",
-    "reality",
-    "realize",
-    "really",
-    "reason",
-    "receive",
-    "recent",
-    "recently",
-    "recognize",
-    "record",
-    "red",
-    "reduce",
-    "reflect",
-    "region",
-    "relate",
-    "relationship",
-    "religious",
-    "remain",
-    "remember",
-    "report",
-    "represent",
-    "Republican",
-    "require",
-    "research",
-    "resource",
-    "respond",
-    "response",
-    "responsibility",
-    "rest",
-    "result",
-    "return",
-    "reveal",
-    "rich",
-    "right",
-    "rise",
-    "risk",
-    "road",
-    "rock",
-    "role",
-    "room",
-    "rule",
-    "run",
-    "safe",
-    "same",
-    "save",
-    "say",
-    "scene",
-    "school",
-    "science",
-    "scientist",
-    "score",
-    "sea",
-    "season",
-    "seat",
-    "second",
-    "section",
-    "security",
-    "see",
-    "seek",
-    "seem",
-    "sell",
-    "send",
-    "senior",
-    "sense",
-    "series",
-    "serious",
-    "serve",
-    "service",
-    "set",
-    "seven",
-    "several",
-    "shake",
-    "share",
-    "she",
-    "short",
-    "should",
-    "shoulder",
-    "show",
-    "side",
-    "sign",
-    "significant",
-    "similar",
-    "simple",
-    "simply",
-    "since",
-    "sing",
-    "single",
-    "sister",
-    "sit",
-    "site",
-    "situation",
-    "six",
-    "size",
-    "skill",
-    "skin",
-    "small",
-    "smile",
-    "so",
-    "social",
-    "society",
-    "soldier",
-    "some",
-    "somebody",
-    "someone",
-    "something",
-    "sometimes",
-    "son",
-    "song",
-    "soon",
-    "sort",
-    "sound",
-    "source",
-    "south",
-    "southern",
-    "space",
-    "speak",
-    "special",
-    "specific",
-    "speech",
-    "spend",
-    "sport",
-    "spring",
-    "staff",
-    "stage",
-    "stand",
-    "standard",
-    "star",
-    "start",
-    "state",
-    "statement",
-    "station",
-    "stay",
-    "step",
-    "still",
-    "stock",
-    "stop",
-    "store",
-    "story",
-    "strategy",
-    "street",
-    "strong",
-    "structure",
-    "student",
-    "study",
-    "stuff",
-    "style",
-    "subject",
-    "success",
-    "successful",
-    "such",
-    "suddenly",
-    "suffer",
-    "suggest",
-    "summer",
-    "support",
-    "sure",
-    "surface",
-    "system",
-    "table",
-    "take",
-    "talk",
-    "task",
-    "tax",
-    "teach",
-    "teacher",
-    "team",
-    "technology",
-    "television",
-    "tell",
-    "ten",
-    "tend",
-    "term",
-    "test",
-    "than",
-    "thank",
-    "that",
-    "the",
-    "their",
-    "them",
-    "themselves",
-    "then",
-    "theory",
-    "there",
-    "these",
-    "they",
-    "thing",
-    "think",
-    "third",
-    "this",
-    "those",
-    "though",
-    "thought",
-    "thousand",
-    "threat",
-    "three",
-    "through",
-    "throughout",
-    "throw",
-    "thus",
-    "time",
-    "to",
-    "today",
-    "together",
-    "tonight",
-    "too",
-    "top",
-    "total",
-    "tough",
-    "toward",
-    "town",
-    "trade",
-    "traditional",
-    "training",
-    "travel",
-    "treat",
-    "treatment",
-    "tree",
-    "trial",
-    "trip",
-    "trouble",
-    "true",
-    "truth",
-    "try",
-    "turn",
-    "TV",
-    "two",
-    "type",
-    "under",
-    "understand",
-    "unit",
-    "until",
-    "up",
-    "upon",
-    "us",
-    "use",
-    "usually",
-    "value",
-    "various",
-    "very",
-    "view",
-    "visit",
-    "voice",
-    "vote",
-    "wait",
-    "walk",
-    "wall",
-    "want",
-    "war",
-    "watch",
-    "water",
-    "way",
-    "we",
-    "wear",
-    "week",
-    "weight",
-    "well",
-    "west",
-    "western",
-    "what",
-    "whatever",
-    "when",
-    "where",
-    "whether",
-    "which",
-    "while",
-    "white",
-    "who",
-    "whole",
-    "whom",
-    "whose",
-    "why",
-    "wide",
-    "wife",
-    "will",
-    "win",
-    "wind",
-    "window",
-    "wish",
-    "with",
-    "within",
-    "without",
-    "woman",
-    "wonder",
-    "word",
-    "work",
-    "worker",
-    "world",
-    "worry",
-    "would",
-    "write",
-    "writer",
-    "wrong",
-    "yard",
-    "yeah",
-    "year",
-    "yes",
-    "yet",
-    "you",
-    "young",
-    "your",
-    "yourself",
+static const char faker_words_blob[] = {
+    'a', 'a', 'b', 'i', 'l', 'i', 't', 'y', 'a', 'b', 'l', 'e', 'a', 'b', 'o', 'u',
+    't', 'a', 'b', 'o', 'v', 'e', 'a', 'c', 'c', 'e', 'p', 't', 'a', 'c', 'c', 'o',
+    'r', 'd', 'i', 'n', 'g', 'a', 'c', 'c', 'o', 'u', 'n', 't', 'a', 'c', 'r', 'o',
+    's', 's', 'a', 'c', 't', 'a', 'c', 't', 'i', 'o', 'n', 'a', 'c', 't', 'i', 'v',
+    'i', 't', 'y', 'a', 'c', 't', 'u', 'a', 'l', 'l', 'y', 'a', 'd', 'd', 'a', 'd',
+    'd', 'r', 'e', 's', 's', 'a', 'd', 'm', 'i', 'n', 'i', 's', 't', 'r', 'a', 't',
+    'i', 'o', 'n', 'a', 'd', 'm', 'i', 't', 'a', 'd', 'u', 'l', 't', 'a', 'f', 'f',
+    'e', 'c', 't', 'a', 'f', 't', 'e', 'r', 'a', 'g', 'a', 'i', 'n', 'a', 'g', 'a',
+    'i', 'n', 's', 't', 'a', 'g', 'e', 'a', 'g', 'e', 'n', 'c', 'y', 'a', 'g', 'e',
+    'n', 't', 'a', 'g', 'o', 'a', 'g', 'r', 'e', 'e', 'a', 'g', 'r', 'e', 'e', 'm',
+    'e', 'n', 't', 'a', 'h', 'e', 'a', 'd', 'a', 'i', 'r', 'a', 'l', 'l', 'a', 'l',
+    'l', 'o', 'w', 'a', 'l', 'm', 'o', 's', 't', 'a', 'l', 'o', 'n', 'e', 'a', 'l',
+    'o', 'n', 'g', 'a', 'l', 'r', 'e', 'a', 'd', 'y', 'a', 'l', 's', 'o', 'a', 'l',
+    't', 'h', 'o', 'u', 'g', 'h', 'a', 'l', 'w', 'a', 'y', 's', 'A', 'm', 'e', 'r',
+    'i', 'c', 'a', 'n', 'a', 'm', 'o', 'n', 'g', 'a', 'm', 'o', 'u', 'n', 't', 'a',
+    'n', 'a', 'l', 'y', 's', 'i', 's', 'a', 'n', 'd', 'a', 'n', 'i', 'm', 'a', 'l',
+    'a', 'n', 'o', 't', 'h', 'e', 'r', 'a', 'n', 's', 'w', 'e', 'r', 'a', 'n', 'y',
+    'a', 'n', 'y', 'o', 'n', 'e', 'a', 'n', 'y', 't', 'h', 'i', 'n', 'g', 'a', 'p',
+    'p', 'e', 'a', 'r', 'a', 'p', 'p', 'l', 'y', 'a', 'p', 'p', 'r', 'o', 'a', 'c',
+    'h', 'a', 'r', 'e', 'a', 'a', 'r', 'g', 'u', 'e', 'a', 'r', 'm', 'a', 'r', 'o',
+    'u', 'n', 'd', 'a', 'r', 'r', 'i', 'v', 'e', 'a', 'r', 't', 'a', 'r', 't', 'i',
+    'c', 'l', 'e', 'a', 'r', 't', 'i', 's', 't', 'a', 's', 'a', 's', 'k', 'a', 's',
+    's', 'u', 'm', 'e', 'a', 't', 'a', 't', 't', 'a', 'c', 'k', 'a', 't', 't', 'e',
+    'n', 't', 'i', 'o', 'n', 'a', 't', 't', 'o', 'r', 'n', 'e', 'y', 'a', 'u', 'd',
+    'i', 'e', 'n', 'c', 'e', 'a', 'u', 't', 'h', 'o', 'r', 'a', 'u', 't', 'h', 'o',
+    'r', 'i', 't', 'y', 'a', 'v', 'a', 'i', 'l', 'a', 'b', 'l', 'e', 'a', 'v', 'o',
+    'i', 'd', 'a', 'w', 'a', 'y', 'b', 'a', 'b', 'y', 'b', 'a', 'c', 'k', 'b', 'a',
+    'd', 'b', 'a', 'g', 'b', 'a', 'l', 'l', 'b', 'a', 'n', 'k', 'b', 'a', 'r', 'b',
+    'a', 's', 'e', 'b', 'e', 'b', 'e', 'a', 't', 'b', 'e', 'a', 'u', 't', 'i', 'f',
+    'u', 'l', 'b', 'e', 'c', 'a', 'u', 's', 'e', 'b', 'e', 'c', 'o', 'm', 'e', 'b',
+    'e', 'd', 'b', 'e', 'f', 'o', 'r', 'e', 'b', 'e', 'g', 'i', 'n', 'b', 'e', 'h',
+    'a', 'v', 'i', 'o', 'r', 'b', 'e', 'h', 'i', 'n', 'd', 'b', 'e', 'l', 'i', 'e',
+    'v', 'e', 'b', 'e', 'n', 'e', 'f', 'i', 't', 'b', 'e', 's', 't', 'b', 'e', 't',
+    't', 'e', 'r', 'b', 'e', 't', 'w', 'e', 'e', 'n', 'b', 'e', 'y', 'o', 'n', 'd',
+    'b', 'i', 'g', 'b', 'i', 'l', 'l', 'b', 'i', 'l', 'l', 'i', 'o', 'n', 'b', 'i',
+    't', 'b', 'l', 'a', 'c', 'k', 'b', 'l', 'o', 'o', 'd', 'b', 'l', 'u', 'e', 'b',
+    'o', 'a', 'r', 'd', 'b', 'o', 'd', 'y', 'b', 'o', 'o', 'k', 'b', 'o', 'r', 'n',
+    'b', 'o', 't', 'h', 'b', 'o', 'x', 'b', 'o', 'y', 'b', 'r', 'e', 'a', 'k', 'b',
+    'r', 'i', 'n', 'g', 'b', 'r', 'o', 't', 'h', 'e', 'r', 'b', 'u', 'd', 'g', 'e',
+    't', 'b', 'u', 'i', 'l', 'd', 'b', 'u', 'i', 'l', 'd', 'i', 'n', 'g', 'b', 'u',
+    's', 'i', 'n', 'e', 's', 's', 'b', 'u', 't', 'b', 'u', 'y', 'b', 'y', 'c', 'a',
+    'l', 'l', 'c', 'a', 'm', 'e', 'r', 'a', 'c', 'a', 'm', 'p', 'a', 'i', 'g', 'n',
+    'c', 'a', 'n', 'c', 'a', 'n', 'd', 'i', 'd', 'a', 't', 'e', 'c', 'a', 'p', 'i',
+    't', 'a', 'l', 'c', 'a', 'r', 'c', 'a', 'r', 'd', 'c', 'a', 'r', 'e', 'c', 'a',
+    'r', 'e', 'e', 'r', 'c', 'a', 'r', 'r', 'y', 'c', 'a', 's', 'e', 'c', 'a', 't',
+    'c', 'h', 'c', 'a', 'u', 's', 'e', 'c', 'e', 'l', 'l', 'c', 'e', 'n', 't', 'e',
+    'r', 'c', 'e', 'n', 't', 'r', 'a', 'l', 'c', 'e', 'n', 't', 'u', 'r', 'y', 'c',
+    'e', 'r', 't', 'a', 'i', 'n', 'c', 'e', 'r', 't', 'a', 'i', 'n', 'l', 'y', 'c',
+    'h', 'a', 'i', 'r', 'c', 'h', 'a', 'l', 'l', 'e', 'n', 'g', 'e', 'c', 'h', 'a',
+    'n', 'c', 'e', 'c', 'h', 'a', 'n', 'g', 'e', 'c', 'h', 'a', 'r', 'a', 'c', 't',
+    'e', 'r', 'c', 'h', 'a', 'r', 'g', 'e', 'c', 'h', 'e', 'c', 'k', 'c', 'h', 'i',
+    'l', 'd', 'c', 'h', 'o', 'i', 'c', 'e', 'c', 'h', 'o', 'o', 's', 'e', 'c', 'h',
+    'u', 'r', 'c', 'h', 'c', 'i', 't', 'i', 'z', 'e', 'n', 'c', 'i', 't', 'y', 'c',
+    'i', 'v', 'i', 'l', 'c', 'l', 'a', 'i', 'm', 'c', 'l', 'a', 's', 's', 'c', 'l',
+    'e', 'a', 'r', 'c', 'l', 'e', 'a', 'r', 'l', 'y', 'c', 'l', 'o', 's', 'e', 'c',
+    'o', 'a', 'c', 'h', 'c', 'o', 'l', 'd', 'c', 'o', 'l', 'l', 'e', 'c', 't', 'i',
+    'o', 'n', 'c', 'o', 'l', 'l', 'e', 'g', 'e', 'c', 'o', 'l', 'o', 'r', 'c', 'o',
+    'm', 'm', 'e', 'r', 'c', 'i', 'a', 'l', 'c', 'o', 'm', 'm', 'o', 'n', 'c', 'o',
+    'm', 'm', 'u', 'n', 'i', 't', 'y', 'c', 'o', 'm', 'p', 'a', 'n', 'y', 'c', 'o',
+    'm', 'p', 'a', 'r', 'e', 'c', 'o', 'm', 'p', 'u', 't', 'e', 'r', 'c', 'o', 'n',
+    'c', 'e', 'r', 'n', 'c', 'o', 'n', 'd', 'i', 't', 'i', 'o', 'n', 'c', 'o', 'n',
+    'f', 'e', 'r', 'e', 'n', 'c', 'e', 'C', 'o', 'n', 'g', 'r', 'e', 's', 's', 'c',
+    'o', 'n', 's', 'i', 'd', 'e', 'r', 'c', 'o', 'n', 's', 'u', 'm', 'e', 'r', 'c',
+    'o', 'n', 't', 'a', 'i', 'n', 'c', 'o', 'n', 't', 'i', 'n', 'u', 'e', 'c', 'o',
+    'n', 't', 'r', 'o', 'l', 'c', 'o', 's', 't', 'c', 'o', 'u', 'l', 'd', 'c', 'o',
+    'u', 'n', 't', 'r', 'y', 'c', 'o', 'u', 'p', 'l', 'e', 'c', 'o', 'u', 'r', 's',
+    'e', 'c', 'o', 'u', 'r', 't', 'c', 'o', 'v', 'e', 'r', 'c', 'r', 'e', 'a', 't',
+    'e', 'c', 'r', 'i', 'm', 'e', 'c', 'u', 'l', 't', 'u', 'r', 'a', 'l', 'c', 'u',
+    'l', 't', 'u', 'r', 'e', 'c', 'u', 'p', 'c', 'u', 'r', 'r', 'e', 'n', 't', 'c',
+    'u', 's', 't', 'o', 'm', 'e', 'r', 'c', 'u', 't', 'd', 'a', 'r', 'k', 'd', 'a',
+    't', 'a', 'd', 'a', 'u', 'g', 'h', 't', 'e', 'r', 'd', 'a', 'y', 'd', 'e', 'a',
+    'l', 'd', 'e', 'b', 'a', 't', 'e', 'd', 'e', 'c', 'a', 'd', 'e', 'd', 'e', 'c',
+    'i', 'd', 'e', 'd', 'e', 'c', 'i', 's', 'i', 'o', 'n', 'd', 'e', 'e', 'p', 'd',
+    'e', 'f', 'e', 'n', 's', 'e', 'd', 'e', 'g', 'r', 'e', 'e', 'D', 'e', 'm', 'o',
+    'c', 'r', 'a', 't', 'd', 'e', 'm', 'o', 'c', 'r', 'a', 't', 'i', 'c', 'd', 'e',
+    's', 'c', 'r', 'i', 'b', 'e', 'd', 'e', 's', 'i', 'g', 'n', 'd', 'e', 's', 'p',
+    'i', 't', 'e', 'd', 'e', 't', 'a', 'i', 'l', 'd', 'e', 't', 'e', 'r', 'm', 'i',
+    'n', 'e', 'd', 'e', 'v', 'e', 'l', 'o', 'p', 'd', 'e', 'v', 'e', 'l', 'o', 'p',
+    'm', 'e', 'n', 't', 'd', 'i', 'f', 'f', 'e', 'r', 'e', 'n', 'c', 'e', 'd', 'i',
+    'f', 'f', 'e', 'r', 'e', 'n', 't', 'd', 'i', 'f', 'f', 'i', 'c', 'u', 'l', 't',
+    'd', 'i', 'n', 'n', 'e', 'r', 'd', 'i', 'r', 'e', 'c', 't', 'i', 'o', 'n', 'd',
+    'i', 'r', 'e', 'c', 't', 'o', 'r', 'd', 'i', 's', 'c', 'o', 'v', 'e', 'r', 'd',
+    'i', 's', 'c', 'u', 's', 's', 'd', 'i', 's', 'c', 'u', 's', 's', 'i', 'o', 'n',
+    'd', 'o', 'd', 'o', 'c', 't', 'o', 'r', 'd', 'o', 'g', 'd', 'o', 'o', 'r', 'd',
+    'o', 'w', 'n', 'd', 'r', 'a', 'w', 'd', 'r', 'e', 'a', 'm', 'd', 'r', 'i', 'v',
+    'e', 'd', 'r', 'o', 'p', 'd', 'r', 'u', 'g', 'd', 'u', 'r', 'i', 'n', 'g', 'e',
+    'a', 'c', 'h', 'e', 'a', 'r', 'l', 'y', 'e', 'a', 's', 't', 'e', 'a', 's', 'y',
+    'e', 'a', 't', 'e', 'c', 'o', 'n', 'o', 'm', 'i', 'c', 'e', 'c', 'o', 'n', 'o',
+    'm', 'y', 'e', 'd', 'g', 'e', 'e', 'd', 'u', 'c', 'a', 't', 'i', 'o', 'n', 'e',
+    'f', 'f', 'e', 'c', 't', 'e', 'f', 'f', 'o', 'r', 't', 'e', 'i', 'g', 'h', 't',
+    'e', 'i', 't', 'h', 'e', 'r', 'e', 'l', 'e', 'c', 't', 'i', 'o', 'n', 'e', 'l',
+    's', 'e', 'e', 'm', 'p', 'l', 'o', 'y', 'e', 'e', 'e', 'n', 'd', 'e', 'n', 'e',
+    'r', 'g', 'y', 'e', 'n', 'j', 'o', 'y', 'e', 'n', 'o', 'u', 'g', 'h', 'e', 'n',
+    't', 'e', 'r', 'e', 'n', 't', 'i', 'r', 'e', 'e', 'n', 'v', 'i', 'r', 'o', 'n',
+    'm', 'e', 'n', 't', 'e', 'n', 'v', 'i', 'r', 'o', 'n', 'm', 'e', 'n', 't', 'a',
+    'l', 'e', 's', 'p', 'e', 'c', 'i', 'a', 'l', 'l', 'y', 'e', 's', 't', 'a', 'b',
+    'l', 'i', 's', 'h', 'e', 'v', 'e', 'n', 'e', 'v', 'e', 'n', 'i', 'n', 'g', 'e',
+    'v', 'e', 'n', 't', 'e', 'v', 'e', 'r', 'e', 'v', 'e', 'r', 'y', 'e', 'v', 'e',
+    'r', 'y', 'b', 'o', 'd', 'y', 'e', 'v', 'e', 'r', 'y', 'o', 'n', 'e', 'e', 'v',
+    'e', 'r', 'y', 't', 'h', 'i', 'n', 'g', 'e', 'v', 'i', 'd', 'e', 'n', 'c', 'e',
+    'e', 'x', 'a', 'c', 't', 'l', 'y', 'e', 'x', 'a', 'm', 'p', 'l', 'e', 'e', 'x',
+    'e', 'c', 'u', 't', 'i', 'v', 'e', 'e', 'x', 'i', 's', 't', 'e', 'x', 'p', 'e',
+    'c', 't', 'e', 'x', 'p', 'e', 'r', 'i', 'e', 'n', 'c', 'e', 'e', 'x', 'p', 'e',
+    'r', 't', 'e', 'x', 'p', 'l', 'a', 'i', 'n', 'e', 'y', 'e', 'f', 'a', 'c', 'e',
+    'f', 'a', 'c', 't', 'f', 'a', 'c', 't', 'o', 'r', 'f', 'a', 'l', 'l', 'f', 'a',
+    'm', 'i', 'l', 'y', 'f', 'a', 'r', 'f', 'a', 's', 't', 'f', 'a', 't', 'h', 'e',
+    'r', 'f', 'e', 'a', 'r', 'f', 'e', 'd', 'e', 'r', 'a', 'l', 'f', 'e', 'e', 'l',
+    'f', 'e', 'e', 'l', 'i', 'n', 'g', 'f', 'e', 'w', 'f', 'i', 'e', 'l', 'd', 'f',
+    'i', 'g', 'h', 't', 'f', 'i', 'g', 'u', 'r', 'e', 'f', 'i', 'l', 'l', 'f', 'i',
+    'l', 'm', 'f', 'i', 'n', 'a', 'l', 'f', 'i', 'n', 'a', 'l', 'l', 'y', 'f', 'i',
+    'n', 'a', 'n', 'c', 'i', 'a', 'l', 'f', 'i', 'n', 'd', 'f', 'i', 'n', 'e', 'f',
+    'i', 'n', 'i', 's', 'h', 'f', 'i', 'r', 'e', 'f', 'i', 'r', 'm', 'f', 'i', 'r',
+    's', 't', 'f', 'i', 's', 'h', 'f', 'i', 'v', 'e', 'f', 'l', 'o', 'o', 'r', 'f',
+    'l', 'y', 'f', 'o', 'c', 'u', 's', 'f', 'o', 'l', 'l', 'o', 'w', 'f', 'o', 'o',
+    'd', 'f', 'o', 'o', 't', 'f', 'o', 'r', 'f', 'o', 'r', 'c', 'e', 'f', 'o', 'r',
+    'e', 'i', 'g', 'n', 'f', 'o', 'r', 'g', 'e', 't', 'f', 'o', 'r', 'm', 'f', 'o',
+    'r', 'm', 'e', 'r', 'f', 'o', 'r', 'w', 'a', 'r', 'd', 'f', 'o', 'u', 'r', 'f',
+    'r', 'e', 'e', 'f', 'r', 'i', 'e', 'n', 'd', 'f', 'r', 'o', 'm', 'f', 'r', 'o',
+    'n', 't', 'f', 'u', 'l', 'l', 'f', 'u', 'n', 'd', 'f', 'u', 't', 'u', 'r', 'e',
+    'g', 'a', 'm', 'e', 'g', 'a', 'r', 'd', 'e', 'n', 'g', 'a', 's', 'g', 'e', 'n',
+    'e', 'r', 'a', 'l', 'g', 'e', 'n', 'e', 'r', 'a', 't', 'i', 'o', 'n', 'g', 'e',
+    't', 'g', 'i', 'r', 'l', 'g', 'i', 'v', 'e', 'g', 'l', 'a', 's', 's', 'g', 'o',
+    'g', 'o', 'a', 'l', 'g', 'o', 'o', 'd', 'g', 'o', 'v', 'e', 'r', 'n', 'm', 'e',
+    'n', 't', 'g', 'r', 'e', 'a', 't', 'g', 'r', 'e', 'e', 'n', 'g', 'r', 'o', 'u',
+    'n', 'd', 'g', 'r', 'o', 'u', 'p', 'g', 'r', 'o', 'w', 'g', 'r', 'o', 'w', 't',
+    'h', 'g', 'u', 'e', 's', 's', 'g', 'u', 'n', 'g', 'u', 'y', 'h', 'a', 'i', 'r',
+    'h', 'a', 'l', 'f', 'h', 'a', 'n', 'd', 'h', 'a', 'p', 'p', 'e', 'n', 'h', 'a',
+    'p', 'p', 'y', 'h', 'a', 'r', 'd', 'h', 'a', 'v', 'e', 'h', 'e', 'h', 'e', 'a',
+    'd', 'h', 'e', 'a', 'l', 't', 'h', 'h', 'e', 'a', 'r', 'h', 'e', 'a', 'r', 't',
+    'h', 'e', 'a', 'v', 'y', 'h', 'e', 'l', 'p', 'h', 'e', 'r', 'h', 'e', 'r', 'e',
+    'h', 'e', 'r', 's', 'e', 'l', 'f', 'h', 'i', 'g', 'h', 'h', 'i', 'm', 'h', 'i',
+    'm', 's', 'e', 'l', 'f', 'h', 'i', 's', 'h', 'i', 's', 't', 'o', 'r', 'y', 'h',
+    'i', 't', 'h', 'o', 'l', 'd', 'h', 'o', 'm', 'e', 'h', 'o', 'p', 'e', 'h', 'o',
+    's', 'p', 'i', 't', 'a', 'l', 'h', 'o', 't', 'h', 'o', 't', 'e', 'l', 'h', 'o',
+    'u', 'r', 'h', 'o', 'u', 's', 'e', 'h', 'o', 'w', 'h', 'o', 'w', 'e', 'v', 'e',
+    'r', 'h', 'u', 'g', 'e', 'h', 'u', 'm', 'a', 'n', 'h', 'u', 'n', 'd', 'r', 'e',
+    'd', 'h', 'u', 's', 'b', 'a', 'n', 'd', 'I', 'i', 'd', 'e', 'a', 'i', 'd', 'e',
+    'n', 't', 'i', 'f', 'y', 'i', 'f', 'i', 'm', 'a', 'g', 'e', 'i', 'm', 'a', 'g',
+    'i', 'n', 'e', 'i', 'm', 'p', 'a', 'c', 't', 'i', 'm', 'p', 'o', 'r', 't', 'a',
+    'n', 't', 'i', 'm', 'p', 'r', 'o', 'v', 'e', 'i', 'n', 'i', 'n', 'c', 'l', 'u',
+    'd', 'e', 'i', 'n', 'c', 'l', 'u', 'd', 'i', 'n', 'g', 'i', 'n', 'c', 'r', 'e',
+    'a', 's', 'e', 'i', 'n', 'd', 'e', 'e', 'd', 'i', 'n', 'd', 'i', 'c', 'a', 't',
+    'e', 'i', 'n', 'd', 'i', 'v', 'i', 'd', 'u', 'a', 'l', 'i', 'n', 'd', 'u', 's',
+    't', 'r', 'y', 'i', 'n', 'f', 'o', 'r', 'm', 'a', 't', 'i', 'o', 'n', 'i', 'n',
+    's', 'i', 'd', 'e', 'i', 'n', 's', 't', 'e', 'a', 'd', 'i', 'n', 's', 't', 'i',
+    't', 'u', 't', 'i', 'o', 'n', 'i', 'n', 't', 'e', 'r', 'e', 's', 't', 'i', 'n',
+    't', 'e', 'r', 'e', 's', 't', 'i', 'n', 'g', 'i', 'n', 't', 'e', 'r', 'n', 'a',
+    't', 'i', 'o', 'n', 'a', 'l', 'i', 'n', 't', 'e', 'r', 'v', 'i', 'e', 'w', 'i',
+    'n', 't', 'o', 'i', 'n', 'v', 'e', 's', 't', 'm', 'e', 'n', 't', 'i', 'n', 'v',
+    'o', 'l', 'v', 'e', 'i', 's', 's', 'u', 'e', 'i', 't', 'i', 't', 'e', 'm', 'i',
+    't', 's', 'i', 't', 's', 'e', 'l', 'f', 'j', 'o', 'b', 'j', 'o', 'i', 'n', 'j',
+    'u', 's', 't', 'k', 'e', 'e', 'p', 'k', 'e', 'y', 'k', 'i', 'd', 'k', 'i', 'n',
+    'd', 'k', 'i', 't', 'c', 'h', 'e', 'n', 'k', 'n', 'o', 'w', 'k', 'n', 'o', 'w',
+    'l', 'e', 'd', 'g', 'e', 'l', 'a', 'n', 'd', 'l', 'a', 'n', 'g', 'u', 'a', 'g',
+    'e', 'l', 'a', 'r', 'g', 'e', 'l', 'a', 's', 't', 'l', 'a', 't', 'e', 'l', 'a',
+    't', 'e', 'r', 'l', 'a', 'u', 'g', 'h', 'l', 'a', 'w', 'l', 'a', 'w', 'y', 'e',
+    'r', 'l', 'a', 'y', 'l', 'e', 'a', 'd', 'l', 'e', 'a', 'd', 'e', 'r', 'l', 'e',
+    'a', 'r', 'n', 'l', 'e', 'a', 's', 't', 'l', 'e', 'a', 'v', 'e', 'l', 'e', 'f',
+    't', 'l', 'e', 'g', 'l', 'e', 's', 's', 'l', 'e', 't', 'l', 'e', 't', 't', 'e',
+    'r', 'l', 'e', 'v', 'e', 'l', 'l', 'i', 'f', 'e', 'l', 'i', 'g', 'h', 't', 'l',
+    'i', 'k', 'e', 'l', 'i', 'k', 'e', 'l', 'y', 'l', 'i', 'n', 'e', 'l', 'i', 's',
+    't', 'l', 'i', 's', 't', 'e', 'n', 'l', 'i', 't', 't', 'l', 'e', 'l', 'i', 'v',
+    'e', 'l', 'o', 'c', 'a', 'l', 'l', 'o', 'n', 'g', 'l', 'o', 'o', 'k', 'l', 'o',
+    's', 'e', 'l', 'o', 's', 's', 'l', 'o', 't', 'l', 'o', 'w', 'm', 'a', 'c', 'h',
+    'i', 'n', 'e', 'm', 'a', 'g', 'a', 'z', 'i', 'n', 'e', 'm', 'a', 'i', 'n', 'm',
+    'a', 'i', 'n', 't', 'a', 'i', 'n', 'm', 'a', 'j', 'o', 'r', 'm', 'a', 'j', 'o',
+    'r', 'i', 't', 'y', 'm', 'a', 'k', 'e', 'm', 'a', 'n', 'm', 'a', 'n', 'a', 'g',
+    'e', 'm', 'a', 'n', 'a', 'g', 'e', 'm', 'e', 'n', 't', 'm', 'a', 'n', 'a', 'g',
+    'e', 'r', 'm', 'a', 'n', 'y', 'm', 'a', 'r', 'k', 'e', 't', 'm', 'a', 'r', 'r',
+    'i', 'a', 'g', 'e', 'm', 'a', 't', 'e', 'r', 'i', 'a', 'l', 'm', 'a', 't', 't',
+    'e', 'r', 'm', 'a', 'y', 'm', 'a', 'y', 'b', 'e', 'm', 'e', 'm', 'e', 'a', 'n',
+    'm', 'e', 'a', 's', 'u', 'r', 'e', 'm', 'e', 'd', 'i', 'a', 'm', 'e', 'd', 'i',
+    'c', 'a', 'l', 'm', 'e', 'e', 't', 'm', 'e', 'e', 't', 'i', 'n', 'g', 'm', 'e',
+    'm', 'b', 'e', 'r', 'm', 'e', 'm', 'o', 'r', 'y', 'm', 'e', 'n', 't', 'i', 'o',
+    'n', 'm', 'e', 's', 's', 'a', 'g', 'e', 'm', 'e', 't', 'h', 'o', 'd', 'm', 'i',
+    'd', 'd', 'l', 'e', 'm', 'i', 'g', 'h', 't', 'm', 'i', 'l', 'i', 't', 'a', 'r',
+    'y', 'm', 'i', 'l', 'l', 'i', 'o', 'n', 'm', 'i', 'n', 'd', 'm', 'i', 'n', 'u',
+    't', 'e', 'm', 'i', 's', 's', 'm', 'i', 's', 's', 'i', 'o', 'n', 'm', 'o', 'd',
+    'e', 'l', 'm', 'o', 'd', 'e', 'r', 'n', 'm', 'o', 'm', 'e', 'n', 't', 'm', 'o',
+    'n', 'e', 'y', 'm', 'o', 'n', 't', 'h', 'm', 'o', 'r', 'e', 'm', 'o', 'r', 'n',
+    'i', 'n', 'g', 'm', 'o', 's', 't', 'm', 'o', 't', 'h', 'e', 'r', 'm', 'o', 'u',
+    't', 'h', 'm', 'o', 'v', 'e', 'm', 'o', 'v', 'e', 'm', 'e', 'n', 't', 'm', 'o',
+    'v', 'i', 'e', 'M', 'r', 'M', 'r', 's', 'm', 'u', 'c', 'h', 'm', 'u', 's', 'i',
+    'c', 'm', 'u', 's', 't', 'm', 'y', 'm', 'y', 's', 'e', 'l', 'f', 'n', 'a', 'm',
+    'e', 'n', 'a', 't', 'i', 'o', 'n', 'n', 'a', 't', 'i', 'o', 'n', 'a', 'l', 'n',
+    'a', 't', 'u', 'r', 'a', 'l', 'n', 'a', 't', 'u', 'r', 'e', 'n', 'e', 'a', 'r',
+    'n', 'e', 'a', 'r', 'l', 'y', 'n', 'e', 'c', 'e', 's', 's', 'a', 'r', 'y', 'n',
+    'e', 'e', 'd', 'n', 'e', 't', 'w', 'o', 'r', 'k', 'n', 'e', 'v', 'e', 'r', 'n',
+    'e', 'w', 'n', 'e', 'w', 's', 'n', 'e', 'w', 's', 'p', 'a', 'p', 'e', 'r', 'n',
+    'e', 'x', 't', 'n', 'i', 'c', 'e', 'n', 'i', 'g', 'h', 't', 'n', 'o', 'n', 'o',
+    'n', 'e', 'n', 'o', 'r', 'n', 'o', 'r', 't', 'h', 'n', 'o', 't', 'n', 'o', 't',
+    'e', 'n', 'o', 't', 'h', 'i', 'n', 'g', 'n', 'o', 't', 'i', 'c', 'e', 'n', 'o',
+    'w', 'n', 'u', 'm', 'b', 'e', 'r', 'o', 'c', 'c', 'u', 'r', 'o', 'f', 'o', 'f',
+    'f', 'o', 'f', 'f', 'e', 'r', 'o', 'f', 'f', 'i', 'c', 'e', 'o', 'f', 'f', 'i',
+    'c', 'e', 'r', 'o', 'f', 'f', 'i', 'c', 'i', 'a', 'l', 'o', 'f', 't', 'e', 'n',
+    'o', 'i', 'l', 'o', 'k', 'o', 'l', 'd', 'o', 'n', 'o', 'n', 'c', 'e', 'o', 'n',
+    'e', 'o', 'n', 'l', 'y', 'o', 'n', 't', 'o', 'o', 'p', 'e', 'n', 'o', 'p', 'e',
+    'r', 'a', 't', 'i', 'o', 'n', 'o', 'p', 'p', 'o', 'r', 't', 'u', 'n', 'i', 't',
+    'y', 'o', 'p', 't', 'i', 'o', 'n', 'o', 'r', 'o', 'r', 'd', 'e', 'r', 'o', 'r',
+    'g', 'a', 'n', 'i', 'z', 'a', 't', 'i', 'o', 'n', 'o', 't', 'h', 'e', 'r', 'o',
+    't', 'h', 'e', 'r', 's', 'o', 'u', 'r', 'o', 'u', 't', 'o', 'u', 't', 's', 'i',
+    'd', 'e', 'o', 'v', 'e', 'r', 'o', 'w', 'n', 'o', 'w', 'n', 'e', 'r', 'p', 'a',
+    'g', 'e', 'p', 'a', 'i', 'n', 't', 'i', 'n', 'g', 'p', 'a', 'p', 'e', 'r', 'p',
+    'a', 'r', 'e', 'n', 't', 'p', 'a', 'r', 't', 'p', 'a', 'r', 't', 'i', 'c', 'i',
+    'p', 'a', 'n', 't', 'p', 'a', 'r', 't', 'i', 'c', 'u', 'l', 'a', 'r', 'p', 'a',
+    'r', 't', 'i', 'c', 'u', 'l', 'a', 'r', 'l', 'y', 'p', 'a', 'r', 't', 'n', 'e',
+    'r', 'p', 'a', 'r', 't', 'y', 'p', 'a', 's', 's', 'p', 'a', 's', 't', 'p', 'a',
+    't', 't', 'e', 'r', 'n', 'p', 'a', 'y', 'p', 'e', 'a', 'c', 'e', 'p', 'e', 'o',
+    'p', 'l', 'e', 'p', 'e', 'r', 'p', 'e', 'r', 'f', 'o', 'r', 'm', 'p', 'e', 'r',
+    'f', 'o', 'r', 'm', 'a', 'n', 'c', 'e', 'p', 'e', 'r', 'h', 'a', 'p', 's', 'p',
+    'e', 'r', 's', 'o', 'n', 'p', 'e', 'r', 's', 'o', 'n', 'a', 'l', 'p', 'h', 'o',
+    'n', 'e', 'p', 'h', 'y', 's', 'i', 'c', 'a', 'l', 'p', 'i', 'c', 'k', 'p', 'i',
+    'c', 't', 'u', 'r', 'e', 'p', 'i', 'e', 'c', 'e', 'p', 'l', 'a', 'c', 'e', 'p',
+    'l', 'a', 'n', 'p', 'l', 'a', 'n', 't', 'p', 'l', 'a', 'y', 'p', 'l', 'a', 'y',
+    'e', 'r', 'P', 'M', 'p', 'o', 'i', 'n', 't', 'p', 'o', 'l', 'i', 'c', 'e', 'p',
+    'o', 'l', 'i', 'c', 'y', 'p', 'o', 'l', 'i', 't', 'i', 'c', 'a', 'l', 'p', 'o',
+    'l', 'i', 't', 'i', 'c', 's', 'p', 'o', 'o', 'r', 'p', 'o', 'p', 'u', 'l', 'a',
+    'r', 'p', 'o', 'p', 'u', 'l', 'a', 't', 'i', 'o', 'n', 'p', 'o', 's', 'i', 't',
+    'i', 'o', 'n', 'p', 'o', 's', 'i', 't', 'i', 'v', 'e', 'p', 'o', 's', 's', 'i',
+    'b', 'l', 'e', 'p', 'o', 'w', 'e', 'r', 'p', 'r', 'a', 'c', 't', 'i', 'c', 'e',
+    'p', 'r', 'e', 'p', 'a', 'r', 'e', 'p', 'r', 'e', 's', 'e', 'n', 't', 'p', 'r',
+    'e', 's', 'i', 'd', 'e', 'n', 't', 'p', 'r', 'e', 's', 's', 'u', 'r', 'e', 'p',
+    'r', 'e', 't', 't', 'y', 'p', 'r', 'e', 'v', 'e', 'n', 't', 'p', 'r', 'i', 'c',
+    'e', 'p', 'r', 'o', 'b', 'a', 'b', 'l', 'y', 'p', 'r', 'o', 'c', 'e', 's', 's',
+    'p', 'r', 'o', 'd', 'u', 'c', 'e', 'p', 'r', 'o', 'd', 'u', 'c', 't', 'p', 'r',
+    'o', 'd', 'u', 'c', 't', 'i', 'o', 'n', 'p', 'r', 'o', 'f', 'e', 's', 's', 'i',
+    'o', 'n', 'a', 'l', 'p', 'r', 'o', 'f', 'e', 's', 's', 'o', 'r', 'p', 'r', 'o',
+    'g', 'r', 'a', 'm', 'p', 'r', 'o', 'j', 'e', 'c', 't', 'p', 'r', 'o', 'p', 'e',
+    'r', 't', 'y', 'p', 'r', 'o', 't', 'e', 'c', 't', 'p', 'r', 'o', 'v', 'e', 'p',
+    'r', 'o', 'v', 'i', 'd', 'e', 'p', 'u', 'b', 'l', 'i', 'c', 'p', 'u', 'l', 'l',
+    'p', 'u', 'r', 'p', 'o', 's', 'e', 'p', 'u', 's', 'h', 'p', 'u', 't', 'q', 'u',
+    'a', 'l', 'i', 't', 'y', 'q', 'u', 'e', 's', 't', 'i', 'o', 'n', 'q', 'u', 'i',
+    'c', 'k', 'l', 'y', 'q', 'u', 'i', 't', 'e', 'r', 'a', 'c', 'e', 'r', 'a', 'd',
+    'i', 'o', 'r', 'a', 'i', 's', 'e', 'r', 'a', 'n', 'g', 'e', 'r', 'a', 't', 'e',
+    'r', 'a', 't', 'h', 'e', 'r', 'r', 'e', 'a', 'c', 'h', 'r', 'e', 'a', 'd', 'r',
+    'e', 'a', 'd', 'y', 'r', 'e', 'a', 'l', 'r', 'e', 'a', 'l', 'i', 't', 'y', 'r',
+    'e', 'a', 'l', 'i', 'z', 'e', 'r', 'e', 'a', 'l', 'l', 'y', 'r', 'e', 'a', 's',
+    'o', 'n', 'r', 'e', 'c', 'e', 'i', 'v', 'e', 'r', 'e', 'c', 'e', 'n', 't', 'r',
+    'e', 'c', 'e', 'n', 't', 'l', 'y', 'r', 'e', 'c', 'o', 'g', 'n', 'i', 'z', 'e',
+    'r', 'e', 'c', 'o', 'r', 'd', 'r', 'e', 'd', 'r', 'e', 'd', 'u', 'c', 'e', 'r',
+    'e', 'f', 'l', 'e', 'c', 't', 'r', 'e', 'g', 'i', 'o', 'n', 'r', 'e', 'l', 'a',
+    't', 'e', 'r', 'e', 'l', 'a', 't', 'i', 'o', 'n', 's', 'h', 'i', 'p', 'r', 'e',
+    'l', 'i', 'g', 'i', 'o', 'u', 's', 'r', 'e', 'm', 'a', 'i', 'n', 'r', 'e', 'm',
+    'e', 'm', 'b', 'e', 'r', 'r', 'e', 'p', 'o', 'r', 't', 'r', 'e', 'p', 'r', 'e',
+    's', 'e', 'n', 't', 'R', 'e', 'p', 'u', 'b', 'l', 'i', 'c', 'a', 'n', 'r', 'e',
+    'q', 'u', 'i', 'r', 'e', 'r', 'e', 's', 'e', 'a', 'r', 'c', 'h', 'r', 'e', 's',
+    'o', 'u', 'r', 'c', 'e', 'r', 'e', 's', 'p', 'o', 'n', 'd', 'r', 'e', 's', 'p',
+    'o', 'n', 's', 'e', 'r', 'e', 's', 'p', 'o', 'n', 's', 'i', 'b', 'i', 'l', 'i',
+    't', 'y', 'r', 'e', 's', 't', 'r', 'e', 's', 'u', 'l', 't', 'r', 'e', 't', 'u',
+    'r', 'n', 'r', 'e', 'v', 'e', 'a', 'l', 'r', 'i', 'c', 'h', 'r', 'i', 'g', 'h',
+    't', 'r', 'i', 's', 'e', 'r', 'i', 's', 'k', 'r', 'o', 'a', 'd', 'r', 'o', 'c',
+    'k', 'r', 'o', 'l', 'e', 'r', 'o', 'o', 'm', 'r', 'u', 'l', 'e', 'r', 'u', 'n',
+    's', 'a', 'f', 'e', 's', 'a', 'm', 'e', 's', 'a', 'v', 'e', 's', 'a', 'y', 's',
+    'c', 'e', 'n', 'e', 's', 'c', 'h', 'o', 'o', 'l', 's', 'c', 'i', 'e', 'n', 'c',
+    'e', 's', 'c', 'i', 'e', 'n', 't', 'i', 's', 't', 's', 'c', 'o', 'r', 'e', 's',
+    'e', 'a', 's', 'e', 'a', 's', 'o', 'n', 's', 'e', 'a', 't', 's', 'e', 'c', 'o',
+    'n', 'd', 's', 'e', 'c', 't', 'i', 'o', 'n', 's', 'e', 'c', 'u', 'r', 'i', 't',
+    'y', 's', 'e', 'e', 's', 'e', 'e', 'k', 's', 'e', 'e', 'm', 's', 'e', 'l', 'l',
+    's', 'e', 'n', 'd', 's', 'e', 'n', 'i', 'o', 'r', 's', 'e', 'n', 's', 'e', 's',
+    'e', 'r', 'i', 'e', 's', 's', 'e', 'r', 'i', 'o', 'u', 's', 's', 'e', 'r', 'v',
+    'e', 's', 'e', 'r', 'v', 'i', 'c', 'e', 's', 'e', 't', 's', 'e', 'v', 'e', 'n',
+    's', 'e', 'v', 'e', 'r', 'a', 'l', 's', 'h', 'a', 'k', 'e', 's', 'h', 'a', 'r',
+    'e', 's', 'h', 'e', 's', 'h', 'o', 'r', 't', 's', 'h', 'o', 'u', 'l', 'd', 's',
+    'h', 'o', 'u', 'l', 'd', 'e', 'r', 's', 'h', 'o', 'w', 's', 'i', 'd', 'e', 's',
+    'i', 'g', 'n', 's', 'i', 'g', 'n', 'i', 'f', 'i', 'c', 'a', 'n', 't', 's', 'i',
+    'm', 'i', 'l', 'a', 'r', 's', 'i', 'm', 'p', 'l', 'e', 's', 'i', 'm', 'p', 'l',
+    'y', 's', 'i', 'n', 'c', 'e', 's', 'i', 'n', 'g', 's', 'i', 'n', 'g', 'l', 'e',
+    's', 'i', 's', 't', 'e', 'r', 's', 'i', 't', 's', 'i', 't', 'e', 's', 'i', 't',
+    'u', 'a', 't', 'i', 'o', 'n', 's', 'i', 'x', 's', 'i', 'z', 'e', 's', 'k', 'i',
+    'l', 'l', 's', 'k', 'i', 'n', 's', 'm', 'a', 'l', 'l', 's', 'm', 'i', 'l', 'e',
+    's', 'o', 's', 'o', 'c', 'i', 'a', 'l', 's', 'o', 'c', 'i', 'e', 't', 'y', 's',
+    'o', 'l', 'd', 'i', 'e', 'r', 's', 'o', 'm', 'e', 's', 'o', 'm', 'e', 'b', 'o',
+    'd', 'y', 's', 'o', 'm', 'e', 'o', 'n', 'e', 's', 'o', 'm', 'e', 't', 'h', 'i',
+    'n', 'g', 's', 'o', 'm', 'e', 't', 'i', 'm', 'e', 's', 's', 'o', 'n', 's', 'o',
+    'n', 'g', 's', 'o', 'o', 'n', 's', 'o', 'r', 't', 's', 'o', 'u', 'n', 'd', 's',
+    'o', 'u', 'r', 'c', 'e', 's', 'o', 'u', 't', 'h', 's', 'o', 'u', 't', 'h', 'e',
+    'r', 'n', 's', 'p', 'a', 'c', 'e', 's', 'p', 'e', 'a', 'k', 's', 'p', 'e', 'c',
+    'i', 'a', 'l', 's', 'p', 'e', 'c', 'i', 'f', 'i', 'c', 's', 'p', 'e', 'e', 'c',
+    'h', 's', 'p', 'e', 'n', 'd', 's', 'p', 'o', 'r', 't', 's', 'p', 'r', 'i', 'n',
+    'g', 's', 't', 'a', 'f', 'f', 's', 't', 'a', 'g', 'e', 's', 't', 'a', 'n', 'd',
+    's', 't', 'a', 'n', 'd', 'a', 'r', 'd', 's', 't', 'a', 'r', 's', 't', 'a', 'r',
+    't', 's', 't', 'a', 't', 'e', 's', 't', 'a', 't', 'e', 'm', 'e', 'n', 't', 's',
+    't', 'a', 't', 'i', 'o', 'n', 's', 't', 'a', 'y', 's', 't', 'e', 'p', 's', 't',
+    'i', 'l', 'l', 's', 't', 'o', 'c', 'k', 's', 't', 'o', 'p', 's', 't', 'o', 'r',
+    'e', 's', 't', 'o', 'r', 'y', 's', 't', 'r', 'a', 't', 'e', 'g', 'y', 's', 't',
+    'r', 'e', 'e', 't', 's', 't', 'r', 'o', 'n', 'g', 's', 't', 'r', 'u', 'c', 't',
+    'u', 'r', 'e', 's', 't', 'u', 'd', 'e', 'n', 't', 's', 't', 'u', 'd', 'y', 's',
+    't', 'u', 'f', 'f', 's', 't', 'y', 'l', 'e', 's', 'u', 'b', 'j', 'e', 'c', 't',
+    's', 'u', 'c', 'c', 'e', 's', 's', 's', 'u', 'c', 'c', 'e', 's', 's', 'f', 'u',
+    'l', 's', 'u', 'c', 'h', 's', 'u', 'd', 'd', 'e', 'n', 'l', 'y', 's', 'u', 'f',
+    'f', 'e', 'r', 's', 'u', 'g', 'g', 'e', 's', 't', 's', 'u', 'm', 'm', 'e', 'r',
+    's', 'u', 'p', 'p', 'o', 'r', 't', 's', 'u', 'r', 'e', 's', 'u', 'r', 'f', 'a',
+    'c', 'e', 's', 'y', 's', 't', 'e', 'm', 't', 'a', 'b', 'l', 'e', 't', 'a', 'k',
+    'e', 't', 'a', 'l', 'k', 't', 'a', 's', 'k', 't', 'a', 'x', 't', 'e', 'a', 'c',
+    'h', 't', 'e', 'a', 'c', 'h', 'e', 'r', 't', 'e', 'a', 'm', 't', 'e', 'c', 'h',
+    'n', 'o', 'l', 'o', 'g', 'y', 't', 'e', 'l', 'e', 'v', 'i', 's', 'i', 'o', 'n',
+    't', 'e', 'l', 'l', 't', 'e', 'n', 't', 'e', 'n', 'd', 't', 'e', 'r', 'm', 't',
+    'e', 's', 't', 't', 'h', 'a', 'n', 't', 'h', 'a', 'n', 'k', 't', 'h', 'a', 't',
+    't', 'h', 'e', 't', 'h', 'e', 'i', 'r', 't', 'h', 'e', 'm', 't', 'h', 'e', 'm',
+    's', 'e', 'l', 'v', 'e', 's', 't', 'h', 'e', 'n', 't', 'h', 'e', 'o', 'r', 'y',
+    't', 'h', 'e', 'r', 'e', 't', 'h', 'e', 's', 'e', 't', 'h', 'e', 'y', 't', 'h',
+    'i', 'n', 'g', 't', 'h', 'i', 'n', 'k', 't', 'h', 'i', 'r', 'd', 't', 'h', 'i',
+    's', 't', 'h', 'o', 's', 'e', 't', 'h', 'o', 'u', 'g', 'h', 't', 'h', 'o', 'u',
+    'g', 'h', 't', 't', 'h', 'o', 'u', 's', 'a', 'n', 'd', 't', 'h', 'r', 'e', 'a',
+    't', 't', 'h', 'r', 'e', 'e', 't', 'h', 'r', 'o', 'u', 'g', 'h', 't', 'h', 'r',
+    'o', 'u', 'g', 'h', 'o', 'u', 't', 't', 'h', 'r', 'o', 'w', 't', 'h', 'u', 's',
+    't', 'i', 'm', 'e', 't', 'o', 't', 'o', 'd', 'a', 'y', 't', 'o', 'g', 'e', 't',
+    'h', 'e', 'r', 't', 'o', 'n', 'i', 'g', 'h', 't', 't', 'o', 'o', 't', 'o', 'p',
+    't', 'o', 't', 'a', 'l', 't', 'o', 'u', 'g', 'h', 't', 'o', 'w', 'a', 'r', 'd',
+    't', 'o', 'w', 'n', 't', 'r', 'a', 'd', 'e', 't', 'r', 'a', 'd', 'i', 't', 'i',
+    'o', 'n', 'a', 'l', 't', 'r', 'a', 'i', 'n', 'i', 'n', 'g', 't', 'r', 'a', 'v',
+    'e', 'l', 't', 'r', 'e', 'a', 't', 't', 'r', 'e', 'a', 't', 'm', 'e', 'n', 't',
+    't', 'r', 'e', 'e', 't', 'r', 'i', 'a', 'l', 't', 'r', 'i', 'p', 't', 'r', 'o',
+    'u', 'b', 'l', 'e', 't', 'r', 'u', 'e', 't', 'r', 'u', 't', 'h', 't', 'r', 'y',
+    't', 'u', 'r', 'n', 'T', 'V', 't', 'w', 'o', 't', 'y', 'p', 'e', 'u', 'n', 'd',
+    'e', 'r', 'u', 'n', 'd', 'e', 'r', 's', 't', 'a', 'n', 'd', 'u', 'n', 'i', 't',
+    'u', 'n', 't', 'i', 'l', 'u', 'p', 'u', 'p', 'o', 'n', 'u', 's', 'u', 's', 'e',
+    'u', 's', 'u', 'a', 'l', 'l', 'y', 'v', 'a', 'l', 'u', 'e', 'v', 'a', 'r', 'i',
+    'o', 'u', 's', 'v', 'e', 'r', 'y', 'v', 'i', 'e', 'w', 'v', 'i', 's', 'i', 't',
+    'v', 'o', 'i', 'c', 'e', 'v', 'o', 't', 'e', 'w', 'a', 'i', 't', 'w', 'a', 'l',
+    'k', 'w', 'a', 'l', 'l', 'w', 'a', 'n', 't', 'w', 'a', 'r', 'w', 'a', 't', 'c',
+    'h', 'w', 'a', 't', 'e', 'r', 'w', 'a', 'y', 'w', 'e', 'w', 'e', 'a', 'r', 'w',
+    'e', 'e', 'k', 'w', 'e', 'i', 'g', 'h', 't', 'w', 'e', 'l', 'l', 'w', 'e', 's',
+    't', 'w', 'e', 's', 't', 'e', 'r', 'n', 'w', 'h', 'a', 't', 'w', 'h', 'a', 't',
+    'e', 'v', 'e', 'r', 'w', 'h', 'e', 'n', 'w', 'h', 'e', 'r', 'e', 'w', 'h', 'e',
+    't', 'h', 'e', 'r', 'w', 'h', 'i', 'c', 'h', 'w', 'h', 'i', 'l', 'e', 'w', 'h',
+    'i', 't', 'e', 'w', 'h', 'o', 'w', 'h', 'o', 'l', 'e', 'w', 'h', 'o', 'm', 'w',
+    'h', 'o', 's', 'e', 'w', 'h', 'y', 'w', 'i', 'd', 'e', 'w', 'i', 'f', 'e', 'w',
+    'i', 'l', 'l', 'w', 'i', 'n', 'w', 'i', 'n', 'd', 'w', 'i', 'n', 'd', 'o', 'w',
+    'w', 'i', 's', 'h', 'w', 'i', 't', 'h', 'w', 'i', 't', 'h', 'i', 'n', 'w', 'i',
+    't', 'h', 'o', 'u', 't', 'w', 'o', 'm', 'a', 'n', 'w', 'o', 'n', 'd', 'e', 'r',
+    'w', 'o', 'r', 'd', 'w', 'o', 'r', 'k', 'w', 'o', 'r', 'k', 'e', 'r', 'w', 'o',
+    'r', 'l', 'd', 'w', 'o', 'r', 'r', 'y', 'w', 'o', 'u', 'l', 'd', 'w', 'r', 'i',
+    't', 'e', 'w', 'r', 'i', 't', 'e', 'r', 'w', 'r', 'o', 'n', 'g', 'y', 'a', 'r',
+    'd', 'y', 'e', 'a', 'h', 'y', 'e', 'a', 'r', 'y', 'e', 's', 'y', 'e', 't', 'y',
+    'o', 'u', 'y', 'o', 'u', 'n', 'g', 'y', 'o', 'u', 'r', 'y', 'o', 'u', 'r', 's',
+    'e', 'l', 'f',
+};
+
+static const unsigned int faker_words_offsets[] = {
+    0,
+    1,
+    8,
+    12,
+    17,
+    22,
+    28,
+    37,
+    44,
+    50,
+    53,
+    59,
+    67,
+    75,
+    78,
+    85,
+    99,
+    104,
+    109,
+    115,
+    120,
+    125,
+    132,
+    135,
+    141,
+    146,
+    149,
+    154,
+    163,
+    168,
+    171,
+    174,
+    179,
+    185,
+    190,
+    195,
+    202,
+    206,
+    214,
+    220,
+    228,
+    233,
+    239,
+    247,
+    250,
+    256,
+    263,
+    269,
+    272,
+    278,
+    286,
+    292,
+    297,
+    305,
+    309,
+    314,
+    317,
+    323,
+    329,
+    332,
+    339,
+    345,
+    347,
+    350,
+    356,
+    358,
+    364,
+    373,
+    381,
+    389,
+    395,
+    404,
+    413,
+    418,
+    422,
+    426,
+    430,
+    433,
+    436,
+    440,
+    444,
+    447,
+    451,
+    453,
+    457,
+    466,
+    473,
+    479,
+    482,
+    488,
+    493,
+    501,
+    507,
+    514,
+    521,
+    525,
+    531,
+    538,
+    544,
+    547,
+    551,
+    558,
+    561,
+    566,
+    571,
+    575,
+    580,
+    584,
+    588,
+    592,
+    596,
+    599,
+    602,
+    607,
+    612,
+    619,
+    625,
+    630,
+    638,
+    646,
+    649,
+    652,
+    654,
+    658,
+    664,
+    672,
+    675,
+    684,
+    691,
+    694,
+    698,
+    702,
+    708,
+    713,
+    717,
+    722,
+    727,
+    731,
+    737,
+    744,
+    751,
+    758,
+    767,
+    772,
+    781,
+    787,
+    793,
+    802,
+    808,
+    813,
+    818,
+    824,
+    830,
+    836,
+    843,
+    847,
+    852,
+    857,
+    862,
+    867,
+    874,
+    879,
+    884,
+    888,
+    898,
+    905,
+    910,
+    920,
+    926,
+    935,
+    942,
+    949,
+    957,
+    964,
+    973,
+    983,
+    991,
+    999,
+    1007,
+    1014,
+    1022,
+    1029,
+    1033,
+    1038,
+    1045,
+    1051,
+    1057,
+    1062,
+    1067,
+    1073,
+    1078,
+    1086,
+    1093,
+    1096,
+    1103,
+    1111,
+    1114,
+    1118,
+    1122,
+    1130,
+    1133,
+    1137,
+    1143,
+    1149,
+    1155,
+    1163,
+    1167,
+    1174,
+    1180,
+    1188,
+    1198,
+    1206,
+    1212,
+    1219,
+    1225,
+    1234,
+    1241,
+    1252,
+    1262,
+    1271,
+    1280,
+    1286,
+    1295,
+    1303,
+    1311,
+    1318,
+    1328,
+    1330,
+    1336,
+    1339,
+    1343,
+    1347,
+    1351,
+    1356,
+    1361,
+    1365,
+    1369,
+    1375,
+    1379,
+    1384,
+    1388,
+    1392,
+    1395,
+    1403,
+    1410,
+    1414,
+    1423,
+    1429,
+    1435,
+    1440,
+    1446,
+    1454,
+    1458,
+    1466,
+    1469,
+    1475,
+    1480,
+    1486,
+    1491,
+    1497,
+    1508,
+    1521,
+    1531,
+    1540,
+    1544,
+    1551,
+    1556,
+    1560,
+    1565,
+    1574,
+    1582,
+    1592,
+    1600,
+    1607,
+    1614,
+    1623,
+    1628,
+    1634,
+    1644,
+    1650,
+    1657,
+    1660,
+    1664,
+    1668,
+    1674,
+    1678,
+    1684,
+    1687,
+    1691,
+    1697,
+    1701,
+    1708,
+    1712,
+    1719,
+    1722,
+    1727,
+    1732,
+    1738,
+    1742,
+    1746,
+    1751,
+    1758,
+    1767,
+    1771,
+    1775,
+    1781,
+    1785,
+    1789,
+    1794,
+    1798,
+    1802,
+    1807,
+    1810,
+    1815,
+    1821,
+    1825,
+    1829,
+    1832,
+    1837,
+    1844,
+    1850,
+    1854,
+    1860,
+    1867,
+    1871,
+    1875,
+    1881,
+    1885,
+    1890,
+    1894,
+    1898,
+    1904,
+    1908,
+    1914,
+    1917,
+    1924,
+    1934,
+    1937,
+    1941,
+    1945,
+    1950,
+    1952,
+    1956,
+    1960,
+    1970,
+    1975,
+    1980,
+    1986,
+    1991,
+    1995,
+    2001,
+    2006,
+    2009,
+    2012,
+    2016,
+    2020,
+    2024,
+    2030,
+    2035,
+    2039,
+    2043,
+    2045,
+    2049,
+    2055,
+    2059,
+    2064,
+    2069,
+    2073,
+    2076,
+    2080,
+    2087,
+    2091,
+    2094,
+    2101,
+    2104,
+    2111,
+    2114,
+    2118,
+    2122,
+    2126,
+    2134,
+    2137,
+    2142,
+    2146,
+    2151,
+    2154,
+    2161,
+    2165,
+    2170,
+    2177,
+    2184,
+    2185,
+    2189,
+    2197,
+    2199,
+    2204,
+    2211,
+    2217,
+    2226,
+    2233,
+    2235,
+    2242,
+    2251,
+    2259,
+    2265,
+    2273,
+    2283,
+    2291,
+    2302,
+    2308,
+    2315,
+    2326,
+    2334,
+    2345,
+    2358,
+    2367,
+    2371,
+    2381,
+    2388,
+    2393,
+    2395,
+    2399,
+    2402,
+    2408,
+    2411,
+    2415,
+    2419,
+    2423,
+    2426,
+    2429,
+    2433,
+    2440,
+    2444,
+    2453,
+    2457,
+    2465,
+    2470,
+    2474,
+    2478,
+    2483,
+    2488,
+    2491,
+    2497,
+    2500,
+    2504,
+    2510,
+    2515,
+    2520,
+    2525,
+    2529,
+    2532,
+    2536,
+    2539,
+    2545,
+    2550,
+    2554,
+    2559,
+    2563,
+    2569,
+    2573,
+    2577,
+    2583,
+    2589,
+    2593,
+    2598,
+    2602,
+    2606,
+    2610,
+    2614,
+    2617,
+    2620,
+    2627,
+    2635,
+    2639,
+    2647,
+    2652,
+    2660,
+    2664,
+    2667,
+    2673,
+    2683,
+    2690,
+    2694,
+    2700,
+    2708,
+    2716,
+    2722,
+    2725,
+    2730,
+    2732,
+    2736,
+    2743,
+    2748,
+    2755,
+    2759,
+    2766,
+    2772,
+    2778,
+    2785,
+    2792,
+    2798,
+    2804,
+    2809,
+    2817,
+    2824,
+    2828,
+    2834,
+    2838,
+    2845,
+    2850,
+    2856,
+    2862,
+    2867,
+    2872,
+    2876,
+    2883,
+    2887,
+    2893,
+    2898,
+    2902,
+    2910,
+    2915,
+    2917,
+    2920,
+    2924,
+    2929,
+    2933,
+    2935,
+    2941,
+    2945,
+    2951,
+    2959,
+    2966,
+    2972,
+    2976,
+    2982,
+    2991,
+    2995,
+    3002,
+    3007,
+    3010,
+    3014,
+    3023,
+    3027,
+    3031,
+    3036,
+    3038,
+    3042,
+    3045,
+    3050,
+    3053,
+    3057,
+    3064,
+    3070,
+    3073,
+    3079,
+    3084,
+    3086,
+    3089,
+    3094,
+    3100,
+    3107,
+    3115,
+    3120,
+    3123,
+    3125,
+    3128,
+    3130,
+    3134,
+    3137,
+    3141,
+    3145,
+    3149,
+    3158,
+    3169,
+    3175,
+    3177,
+    3182,
+    3194,
+    3199,
+    3205,
+    3208,
+    3211,
+    3218,
+    3222,
+    3225,
+    3230,
+    3234,
+    3242,
+    3247,
+    3253,
+    3257,
+    3268,
+    3278,
+    3290,
+    3297,
+    3302,
+    3306,
+    3310,
+    3317,
+    3320,
+    3325,
+    3331,
+    3334,
+    3341,
+    3352,
+    3359,
+    3365,
+    3373,
+    3378,
+    3386,
+    3390,
+    3397,
+    3402,
+    3407,
+    3411,
+    3416,
+    3420,
+    3426,
+    3428,
+    3433,
+    3439,
+    3445,
+    3454,
+    3462,
+    3466,
+    3473,
+    3483,
+    3491,
+    3499,
+    3507,
+    3512,
+    3520,
+    3527,
+    3534,
+    3543,
+    3551,
+    3557,
+    3564,
+    3569,
+    3577,
+    3584,
+    3591,
+    3598,
+    3608,
+    3620,
+    3629,
+    3636,
+    3643,
+    3651,
+    3658,
+    3663,
+    3670,
+    3676,
+    3680,
+    3687,
+    3691,
+    3694,
+    3701,
+    3709,
+    3716,
+    3721,
+    3725,
+    3730,
+    3735,
+    3740,
+    3744,
+    3750,
+    3755,
+    3759,
+    3764,
+    3768,
+    3775,
+    3782,
+    3788,
+    3794,
+    3801,
+    3807,
+    3815,
+    3824,
+    3830,
+    3833,
+    3839,
+    3846,
+    3852,
+    3858,
+    3870,
+    3879,
+    3885,
+    3893,
+    3899,
+    3908,
+    3918,
+    3925,
+    3933,
+    3941,
+    3948,
+    3956,
+    3970,
+    3974,
+    3980,
+    3986,
+    3992,
+    3996,
+    4001,
+    4005,
+    4009,
+    4013,
+    4017,
+    4021,
+    4025,
+    4029,
+    4032,
+    4036,
+    4040,
+    4044,
+    4047,
+    4052,
+    4058,
+    4065,
+    4074,
+    4079,
+    4082,
+    4088,
+    4092,
+    4098,
+    4105,
+    4113,
+    4116,
+    4120,
+    4124,
+    4128,
+    4132,
+    4138,
+    4143,
+    4149,
+    4156,
+    4161,
+    4168,
+    4171,
+    4176,
+    4183,
+    4188,
+    4193,
+    4196,
+    4201,
+    4207,
+    4215,
+    4219,
+    4223,
+    4227,
+    4238,
+    4245,
+    4251,
+    4257,
+    4262,
+    4266,
+    4272,
+    4278,
+    4281,
+    4285,
+    4294,
+    4297,
+    4301,
+    4306,
+    4310,
+    4315,
+    4320,
+    4322,
+    4328,
+    4335,
+    4342,
+    4346,
+    4354,
+    4361,
+    4370,
+    4379,
+    4382,
+    4386,
+    4390,
+    4394,
+    4399,
+    4405,
+    4410,
+    4418,
+    4423,
+    4428,
+    4435,
+    4443,
+    4449,
+    4454,
+    4459,
+    4465,
+    4470,
+    4475,
+    4480,
+    4488,
+    4492,
+    4497,
+    4502,
+    4511,
+    4518,
+    4522,
+    4526,
+    4531,
+    4536,
+    4540,
+    4545,
+    4550,
+    4558,
+    4564,
+    4570,
+    4579,
+    4586,
+    4591,
+    4596,
+    4601,
+    4608,
+    4615,
+    4625,
+    4629,
+    4637,
+    4643,
+    4650,
+    4656,
+    4663,
+    4667,
+    4674,
+    4680,
+    4685,
+    4689,
+    4693,
+    4697,
+    4700,
+    4705,
+    4712,
+    4716,
+    4726,
+    4736,
+    4740,
+    4743,
+    4747,
+    4751,
+    4755,
+    4759,
+    4764,
+    4768,
+    4771,
+    4776,
+    4780,
+    4790,
+    4794,
+    4800,
+    4805,
+    4810,
+    4814,
+    4819,
+    4824,
+    4829,
+    4833,
+    4838,
+    4844,
+    4851,
+    4859,
+    4865,
+    4870,
+    4877,
+    4887,
+    4892,
+    4896,
+    4900,
+    4902,
+    4907,
+    4915,
+    4922,
+    4925,
+    4928,
+    4933,
+    4938,
+    4944,
+    4948,
+    4953,
+    4964,
+    4972,
+    4978,
+    4983,
+    4992,
+    4996,
+    5001,
+    5005,
+    5012,
+    5016,
+    5021,
+    5024,
+    5028,
+    5030,
+    5033,
+    5037,
+    5042,
+    5052,
+    5056,
+    5061,
+    5063,
+    5067,
+    5069,
+    5072,
+    5079,
+    5084,
+    5091,
+    5095,
+    5099,
+    5104,
+    5109,
+    5113,
+    5117,
+    5121,
+    5125,
+    5129,
+    5132,
+    5137,
+    5142,
+    5145,
+    5147,
+    5151,
+    5155,
+    5161,
+    5165,
+    5169,
+    5176,
+    5180,
+    5188,
+    5192,
+    5197,
+    5204,
+    5209,
+    5214,
+    5219,
+    5222,
+    5227,
+    5231,
+    5236,
+    5239,
+    5243,
+    5247,
+    5251,
+    5254,
+    5258,
+    5264,
+    5268,
+    5272,
+    5278,
+    5285,
+    5290,
+    5296,
+    5300,
+    5304,
+    5310,
+    5315,
+    5320,
+    5325,
+    5330,
+    5336,
+    5341,
+    5345,
+    5349,
+    5353,
+    5356,
+    5359,
+    5362,
+    5367,
+    5371,
+};
+
+static const unsigned char faker_words_len[] = {
+    1,
+    7,
+    4,
+    5,
+    5,
+    6,
+    9,
+    7,
+    6,
+    3,
+    6,
+    8,
+    8,
+    3,
+    7,
+    14,
+    5,
+    5,
+    6,
+    5,
+    5,
+    7,
+    3,
+    6,
+    5,
+    3,
+    5,
+    9,
+    5,
+    3,
+    3,
+    5,
+    6,
+    5,
+    5,
+    7,
+    4,
+    8,
+    6,
+    8,
+    5,
+    6,
+    8,
+    3,
+    6,
+    7,
+    6,
+    3,
+    6,
+    8,
+    6,
+    5,
+    8,
+    4,
+    5,
+    3,
+    6,
+    6,
+    3,
+    7,
+    6,
+    2,
+    3,
+    6,
+    2,
+    6,
+    9,
+    8,
+    8,
+    6,
+    9,
+    9,
+    5,
+    4,
+    4,
+    4,
+    3,
+    3,
+    4,
+    4,
+    3,
+    4,
+    2,
+    4,
+    9,
+    7,
+    6,
+    3,
+    6,
+    5,
+    8,
+    6,
+    7,
+    7,
+    4,
+    6,
+    7,
+    6,
+    3,
+    4,
+    7,
+    3,
+    5,
+    5,
+    4,
+    5,
+    4,
+    4,
+    4,
+    4,
+    3,
+    3,
+    5,
+    5,
+    7,
+    6,
+    5,
+    8,
+    8,
+    3,
+    3,
+    2,
+    4,
+    6,
+    8,
+    3,
+    9,
+    7,
+    3,
+    4,
+    4,
+    6,
+    5,
+    4,
+    5,
+    5,
+    4,
+    6,
+    7,
+    7,
+    7,
+    9,
+    5,
+    9,
+    6,
+    6,
+    9,
+    6,
+    5,
+    5,
+    6,
+    6,
+    6,
+    7,
+    4,
+    5,
+    5,
+    5,
+    5,
+    7,
+    5,
+    5,
+    4,
+    10,
+    7,
+    5,
+    10,
+    6,
+    9,
+    7,
+    7,
+    8,
+    7,
+    9,
+    10,
+    8,
+    8,
+    8,
+    7,
+    8,
+    7,
+    4,
+    5,
+    7,
+    6,
+    6,
+    5,
+    5,
+    6,
+    5,
+    8,
+    7,
+    3,
+    7,
+    8,
+    3,
+    4,
+    4,
+    8,
+    3,
+    4,
+    6,
+    6,
+    6,
+    8,
+    4,
+    7,
+    6,
+    8,
+    10,
+    8,
+    6,
+    7,
+    6,
+    9,
+    7,
+    11,
+    10,
+    9,
+    9,
+    6,
+    9,
+    8,
+    8,
+    7,
+    10,
+    2,
+    6,
+    3,
+    4,
+    4,
+    4,
+    5,
+    5,
+    4,
+    4,
+    6,
+    4,
+    5,
+    4,
+    4,
+    3,
+    8,
+    7,
+    4,
+    9,
+    6,
+    6,
+    5,
+    6,
+    8,
+    4,
+    8,
+    3,
+    6,
+    5,
+    6,
+    5,
+    6,
+    11,
+    13,
+    10,
+    9,
+    4,
+    7,
+    5,
+    4,
+    5,
+    9,
+    8,
+    10,
+    8,
+    7,
+    7,
+    9,
+    5,
+    6,
+    10,
+    6,
+    7,
+    3,
+    4,
+    4,
+    6,
+    4,
+    6,
+    3,
+    4,
+    6,
+    4,
+    7,
+    4,
+    7,
+    3,
+    5,
+    5,
+    6,
+    4,
+    4,
+    5,
+    7,
+    9,
+    4,
+    4,
+    6,
+    4,
+    4,
+    5,
+    4,
+    4,
+    5,
+    3,
+    5,
+    6,
+    4,
+    4,
+    3,
+    5,
+    7,
+    6,
+    4,
+    6,
+    7,
+    4,
+    4,
+    6,
+    4,
+    5,
+    4,
+    4,
+    6,
+    4,
+    6,
+    3,
+    7,
+    10,
+    3,
+    4,
+    4,
+    5,
+    2,
+    4,
+    4,
+    10,
+    5,
+    5,
+    6,
+    5,
+    4,
+    6,
+    5,
+    3,
+    3,
+    4,
+    4,
+    4,
+    6,
+    5,
+    4,
+    4,
+    2,
+    4,
+    6,
+    4,
+    5,
+    5,
+    4,
+    3,
+    4,
+    7,
+    4,
+    3,
+    7,
+    3,
+    7,
+    3,
+    4,
+    4,
+    4,
+    8,
+    3,
+    5,
+    4,
+    5,
+    3,
+    7,
+    4,
+    5,
+    7,
+    7,
+    1,
+    4,
+    8,
+    2,
+    5,
+    7,
+    6,
+    9,
+    7,
+    2,
+    7,
+    9,
+    8,
+    6,
+    8,
+    10,
+    8,
+    11,
+    6,
+    7,
+    11,
+    8,
+    11,
+    13,
+    9,
+    4,
+    10,
+    7,
+    5,
+    2,
+    4,
+    3,
+    6,
+    3,
+    4,
+    4,
+    4,
+    3,
+    3,
+    4,
+    7,
+    4,
+    9,
+    4,
+    8,
+    5,
+    4,
+    4,
+    5,
+    5,
+    3,
+    6,
+    3,
+    4,
+    6,
+    5,
+    5,
+    5,
+    4,
+    3,
+    4,
+    3,
+    6,
+    5,
+    4,
+    5,
+    4,
+    6,
+    4,
+    4,
+    6,
+    6,
+    4,
+    5,
+    4,
+    4,
+    4,
+    4,
+    3,
+    3,
+    7,
+    8,
+    4,
+    8,
+    5,
+    8,
+    4,
+    3,
+    6,
+    10,
+    7,
+    4,
+    6,
+    8,
+    8,
+    6,
+    3,
+    5,
+    2,
+    4,
+    7,
+    5,
+    7,
+    4,
+    7,
+    6,
+    6,
+    7,
+    7,
+    6,
+    6,
+    5,
+    8,
+    7,
+    4,
+    6,
+    4,
+    7,
+    5,
+    6,
+    6,
+    5,
+    5,
+    4,
+    7,
+    4,
+    6,
+    5,
+    4,
+    8,
+    5,
+    2,
+    3,
+    4,
+    5,
+    4,
+    2,
+    6,
+    4,
+    6,
+    8,
+    7,
+    6,
+    4,
+    6,
+    9,
+    4,
+    7,
+    5,
+    3,
+    4,
+    9,
+    4,
+    4,
+    5,
+    2,
+    4,
+    3,
+    5,
+    3,
+    4,
+    7,
+    6,
+    3,
+    6,
+    5,
+    2,
+    3,
+    5,
+    6,
+    7,
+    8,
+    5,
+    3,
+    2,
+    3,
+    2,
+    4,
+    3,
+    4,
+    4,
+    4,
+    9,
+    11,
+    6,
+    2,
+    5,
+    12,
+    5,
+    6,
+    3,
+    3,
+    7,
+    4,
+    3,
+    5,
+    4,
+    8,
+    5,
+    6,
+    4,
+    11,
+    10,
+    12,
+    7,
+    5,
+    4,
+    4,
+    7,
+    3,
+    5,
+    6,
+    3,
+    7,
+    11,
+    7,
+    6,
+    8,
+    5,
+    8,
+    4,
+    7,
+    5,
+    5,
+    4,
+    5,
+    4,
+    6,
+    2,
+    5,
+    6,
+    6,
+    9,
+    8,
+    4,
+    7,
+    10,
+    8,
+    8,
+    8,
+    5,
+    8,
+    7,
+    7,
+    9,
+    8,
+    6,
+    7,
+    5,
+    8,
+    7,
+    7,
+    7,
+    10,
+    12,
+    9,
+    7,
+    7,
+    8,
+    7,
+    5,
+    7,
+    6,
+    4,
+    7,
+    4,
+    3,
+    7,
+    8,
+    7,
+    5,
+    4,
+    5,
+    5,
+    5,
+    4,
+    6,
+    5,
+    4,
+    5,
+    4,
+    7,
+    7,
+    6,
+    6,
+    7,
+    6,
+    8,
+    9,
+    6,
+    3,
+    6,
+    7,
+    6,
+    6,
+    12,
+    9,
+    6,
+    8,
+    6,
+    9,
+    10,
+    7,
+    8,
+    8,
+    7,
+    8,
+    14,
+    4,
+    6,
+    6,
+    6,
+    4,
+    5,
+    4,
+    4,
+    4,
+    4,
+    4,
+    4,
+    4,
+    3,
+    4,
+    4,
+    4,
+    3,
+    5,
+    6,
+    7,
+    9,
+    5,
+    3,
+    6,
+    4,
+    6,
+    7,
+    8,
+    3,
+    4,
+    4,
+    4,
+    4,
+    6,
+    5,
+    6,
+    7,
+    5,
+    7,
+    3,
+    5,
+    7,
+    5,
+    5,
+    3,
+    5,
+    6,
+    8,
+    4,
+    4,
+    4,
+    11,
+    7,
+    6,
+    6,
+    5,
+    4,
+    6,
+    6,
+    3,
+    4,
+    9,
+    3,
+    4,
+    5,
+    4,
+    5,
+    5,
+    2,
+    6,
+    7,
+    7,
+    4,
+    8,
+    7,
+    9,
+    9,
+    3,
+    4,
+    4,
+    4,
+    5,
+    6,
+    5,
+    8,
+    5,
+    5,
+    7,
+    8,
+    6,
+    5,
+    5,
+    6,
+    5,
+    5,
+    5,
+    8,
+    4,
+    5,
+    5,
+    9,
+    7,
+    4,
+    4,
+    5,
+    5,
+    4,
+    5,
+    5,
+    8,
+    6,
+    6,
+    9,
+    7,
+    5,
+    5,
+    5,
+    7,
+    7,
+    10,
+    4,
+    8,
+    6,
+    7,
+    6,
+    7,
+    4,
+    7,
+    6,
+    5,
+    4,
+    4,
+    4,
+    3,
+    5,
+    7,
+    4,
+    10,
+    10,
+    4,
+    3,
+    4,
+    4,
+    4,
+    4,
+    5,
+    4,
+    3,
+    5,
+    4,
+    10,
+    4,
+    6,
+    5,
+    5,
+    4,
+    5,
+    5,
+    5,
+    4,
+    5,
+    6,
+    7,
+    8,
+    6,
+    5,
+    7,
+    10,
+    5,
+    4,
+    4,
+    2,
+    5,
+    8,
+    7,
+    3,
+    3,
+    5,
+    5,
+    6,
+    4,
+    5,
+    11,
+    8,
+    6,
+    5,
+    9,
+    4,
+    5,
+    4,
+    7,
+    4,
+    5,
+    3,
+    4,
+    2,
+    3,
+    4,
+    5,
+    10,
+    4,
+    5,
+    2,
+    4,
+    2,
+    3,
+    7,
+    5,
+    7,
+    4,
+    4,
+    5,
+    5,
+    4,
+    4,
+    4,
+    4,
+    4,
+    3,
+    5,
+    5,
+    3,
+    2,
+    4,
+    4,
+    6,
+    4,
+    4,
+    7,
+    4,
+    8,
+    4,
+    5,
+    7,
+    5,
+    5,
+    5,
+    3,
+    5,
+    4,
+    5,
+    3,
+    4,
+    4,
+    4,
+    3,
+    4,
+    6,
+    4,
+    4,
+    6,
+    7,
+    5,
+    6,
+    4,
+    4,
+    6,
+    5,
+    5,
+    5,
+    5,
+    6,
+    5,
+    4,
+    4,
+    4,
+    3,
+    3,
+    3,
+    5,
+    4,
+    8,
 };
 
 static const int faker_words_count = 971;
 
+#define FAKER_WORDS_MAX_LEN 14
+
 #endif // FAKER_DATA_H
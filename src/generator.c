@@ -5,16 +5,28 @@
 #include <string.h>
 #include <math.h>
 #include "generator.h"
+#include "checked.h"
+#include "big_alloc.h"
 #include "faker.h"
+#include "ids.h"
+#include "name_set.h"
+#include "scheduler.h"
+#include "numa.h"
+#include "progress.h"
+#include "radix_sort.h"
+#include "spill.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// Messages per text task: smaller ranges are not worth stealing
+#define GENERATOR_TEXT_GRAIN 16384
+
 // Box-Muller transform to generate standard normal distribution
-static double rand_normal() {
-    double u1 = (double)rand() / RAND_MAX;
-    double u2 = (double)rand() / RAND_MAX;
+static double rand_normal(Rng *rng) {
+    double u1 = rng_uniform(rng);
+    double u2 = rng_uniform(rng);
     
     // Avoid log(0)
     if (u1 < 1e-9) u1 = 1e-9;
@@ -23,225 +35,674 @@ static double rand_normal() {
 }
 
 // Generate an index with Gaussian distribution clamped to [0, max-1]
-static int rand_gaussian_index(int max) {
-    double mean = max / 2.0;
+static int64_t rand_gaussian_index(Rng *rng, int64_t max) {
+    double mean = (double)max / 2.0;
     // 3 sigma covers 99.7% of the range. So sigma = range / 6 ?
     // Let's say range is roughly 0 to max. So sigma = max / 6.
-    double sigma = max / 6.0;
+    double sigma = (double)max / 6.0;
     if (sigma < 1.0) sigma = 1.0;
     
-    double val = rand_normal() * sigma + mean;
-    int idx = (int)round(val);
+    double val = rand_normal(rng) * sigma + mean;
+    int64_t idx = (int64_t)llround(val);
     
     if (idx < 0) idx = 0;
     if (idx >= max) idx = max - 1;
     return idx;
 }
 
-static int compare_msgs(const void *a, const void *b) {
-    const Message *ma = (const Message *)a;
-    const Message *mb = (const Message *)b;
-    if (ma->ts < mb->ts) return -1;
-    if (ma->ts > mb->ts) return 1;
-    return 0;
+void conversation_model_defaults(ConversationModel *model) {
+    model->reply_prob = 0.1;
+    model->start_prob = 0.2;
+    model->max_open_threads = 4;
+    model->size_dist = THREAD_SIZE_POWERLAW;
+    model->size_alpha = 2.0;
+    model->size_mu = 1.0;
+    model->size_sigma = 1.0;
+    model->max_thread_size = 100000;
+    model->delay_dist = REPLY_DELAY_EXPONENTIAL;
+    model->delay_mean = 3600.0;
+    model->delay_mu = 7.0;
+    model->delay_sigma = 1.5;
+    model->max_idle = 3 * 24 * 3600;
+    model->starter_bias = 0.0;
+    model->workers = 1;
+    model->text.vocab = NULL;
+    model->text.corpus = NULL;
 }
 
-User *generate_users(int count) {
-    User *users = malloc(sizeof(User) * (size_t)count);
-    for (int i = 0; i < count; i++) {
-        faker_create_user(&users[i]);
+int conversation_thread_size(const ConversationModel *model, Rng *rng) {
+    double size;
+    if (model->size_dist == THREAD_SIZE_LOGNORMAL) {
+        size = exp(model->size_mu + model->size_sigma * rand_normal(rng));
+    } else {
+        // Pareto with x_min = 1: P(X > x) = x^-(alpha - 1)
+        double u = 1.0 - rng_uniform(rng);
+        size = pow(u, -1.0 / (model->size_alpha - 1.0));
     }
+    if (size > model->max_thread_size) return model->max_thread_size;
+    if (size < 1.0) return 1;
+    return (int)size;
+}
+
+double conversation_reply_delay(const ConversationModel *model, Rng *rng) {
+    if (model->delay_dist == REPLY_DELAY_LOGNORMAL) {
+        return exp(model->delay_mu + model->delay_sigma * rand_normal(rng));
+    }
+    return -model->delay_mean * log(1.0 - rng_uniform(rng));
+}
+
+typedef struct {
+    int64_t parent;        // Message index of the thread parent
+    int64_t parent_user;   // Author of the parent
+    double parent_ts;      // Timestamp of the parent
+    int remaining;         // Replies left before the thread closes
+    double next_due;       // Earliest timestamp of the next reply
+    double last_activity;  // Timestamp of the parent or latest reply
+} OpenThread;
+
+// Threading state of one channel
+typedef struct {
+    Rng rng;               // Per-channel stream
+    OpenThread *open;      // max_open_threads slots
+    int open_count;
+} ChannelThreads;
+
+typedef enum {
+    THREAD_ROLE_NONE,      // Top-level message outside any thread
+    THREAD_ROLE_REPLY,     // Reply to an open thread
+    THREAD_ROLE_START      // Top-level message that opens a thread
+} ThreadRole;
+
+static void channel_threads_reset(ChannelThreads *ct, uint64_t seed, int64_t ch_idx) {
+    rng_seed_stream(&ct->rng, seed, (uint64_t)ch_idx);
+    ct->open_count = 0;
+}
+
+// Decide the role of the next message of a channel. Messages must arrive
+// in timestamp order; id names the message as OpenThread.parent should it
+// open a thread. For a reply, *joined receives the thread it went to.
+static ThreadRole thread_next(const ConversationModel *model, ChannelThreads *ct, int64_t id, double ts, int64_t user_idx, double starter_weight, OpenThread *joined) {
+    OpenThread *open = ct->open;
+    
+    // Close threads that went quiet
+    for (int t = 0; t < ct->open_count; ) {
+        if (ts - open[t].last_activity > model->max_idle) {
+            open[t] = open[--ct->open_count];
+        } else {
+            t++;
+        }
+    }
+    
+    if (ct->open_count > 0 && rng_uniform(&ct->rng) < model->reply_prob) {
+        // Pick among threads that are due, weighted by replies left, so
+        // large threads keep absorbing replies.
+        double total = 0;
+        for (int t = 0; t < ct->open_count; t++) {
+            if (open[t].next_due <= ts) total += open[t].remaining;
+        }
+        if (total > 0) {
+            double pick = rng_uniform(&ct->rng) * total;
+            int t = 0;
+            for (; t < ct->open_count - 1; t++) {
+                if (open[t].next_due > ts) continue;
+                pick -= open[t].remaining;
+                if (pick < 0) break;
+            }
+            // Rounding can leave pick just above 0 on a thread that is not due
+            while (open[t].next_due > ts) t--;
+            
+            *joined = open[t];
+            open[t].last_activity = ts;
+            open[t].next_due = ts + conversation_reply_delay(model, &ct->rng);
+            if (--open[t].remaining == 0) {
+                open[t] = open[--ct->open_count];
+            }
+            return THREAD_ROLE_REPLY;
+        }
+    }
+    
+    double p_start = model->start_prob * starter_weight;
+    // A thread only opens when the channel has a free slot
+    if (ct->open_count < model->max_open_threads && rng_uniform(&ct->rng) < p_start) {
+        OpenThread *slot = &open[ct->open_count++];
+        slot->parent = id;
+        slot->parent_user = user_idx;
+        slot->parent_ts = ts;
+        slot->remaining = conversation_thread_size(model, &ct->rng);
+        slot->last_activity = ts;
+        slot->next_due = ts + conversation_reply_delay(model, &ct->rng);
+        return THREAD_ROLE_START;
+    }
+    return THREAD_ROLE_NONE;
+}
+
+double *conversation_starter_weights(const ConversationModel *model, int64_t user_count) {
+    double *weight = checked_alloc(user_count, sizeof(double));
+    double weight_sum = 0;
+    for (int64_t u = 0; u < user_count; u++) {
+        weight[u] = pow((double)u + 1.0, -model->starter_bias);
+        weight_sum += weight[u];
+    }
+    for (int64_t u = 0; u < user_count; u++) {
+        weight[u] *= (double)user_count / weight_sum;
+    }
+    return weight;
+}
+
+// Shared state of the parallel passes over in-memory messages
+typedef struct {
+    Message *messages;
+    const int64_t *order;          // Message indices grouped by channel
+    const uint64_t *text_seeds;    // By message index
+    const double *starter_weight;
+    const ConversationModel *model;
+    uint64_t seed;
+    OpenThread *open;              // slots open threads per worker
+    int slots;
+    TextArena *arenas;             // One per worker
+} MessagePass;
+
+// Thread the channel whose messages are order[begin .. end - 1]. Only
+// messages of this channel are touched, so channels can be processed
+// concurrently; the RNG stream is per channel to keep the result
+// independent of the worker count.
+static void thread_channel(void *ctx, int worker, int64_t begin, int64_t end) {
+    const MessagePass *pass = ctx;
+    Message *messages = pass->messages;
+    ChannelThreads ct = { .open = pass->open + (size_t)worker * (size_t)pass->slots };
+    channel_threads_reset(&ct, pass->seed, messages[pass->order[begin]].channel_idx);
+    
+    for (int64_t k = begin; k < end; k++) {
+        int64_t i = pass->order[k];
+        Message *msg = &messages[i];
+        OpenThread joined;
+        
+        switch (thread_next(pass->model, &ct, i, msg->ts, msg->user_idx, pass->starter_weight[msg->user_idx], &joined)) {
+            case THREAD_ROLE_REPLY: {
+                // Update parent. The reply list itself is built afterwards
+                // by generate_thread_index() from parent_idx.
+                Message *parent = &messages[joined.parent];
+                msg->thread_ts = joined.parent_ts;
+                msg->parent_idx = joined.parent;
+                parent->reply_count++;
+                parent->latest_reply = msg->ts;
+                break;
+            }
+            case THREAD_ROLE_START:
+                // Mark this message as a thread starter (Slack convention: thread_ts = ts)
+                msg->thread_ts = msg->ts;
+                break;
+            case THREAD_ROLE_NONE:
+                break;
+        }
+    }
+    progress_add(PROGRESS_THREADED, end - begin);
+}
+
+// Write the text of messages order[begin .. end - 1] into the worker's arena
+static void write_texts(void *ctx, int worker, int64_t begin, int64_t end) {
+    const MessagePass *pass = ctx;
+    for (int64_t k = begin; k < end; k++) {
+        int64_t i = pass->order[k];
+        Rng text_rng;
+        rng_seed(&text_rng, pass->text_seeds[i]);
+        Message *m = &pass->messages[i];
+        m->text = faker_message_text(&text_rng, &pass->model->text, &pass->arenas[worker], 3, 20, &m->text_len);
+    }
+    progress_add(PROGRESS_TEXT, end - begin);
+}
+
+User *generate_users(Rng *rng, int64_t count, const IdKeys *ids) {
+    User *users = checked_alloc(count, sizeof(User));
+    
+    // first.last has well under a million combinations, so large workspaces
+    // repeat names. Later holders of a name get an occurrence suffix. The
+    // set holds distinct names only, so size it for at most that many.
+    NameSet names;
+    name_set_init(&names, count < (1 << 20) ? (size_t)count : (size_t)(1 << 20));
+    for (int64_t i = 0; i < count; i++) {
+        id_format(&ids->user, 'U', (uint64_t)i, users[i].id);
+        faker_create_user(rng, &users[i]);
+        if (name_set_claim(&names, users[i].name, sizeof(users[i].name)) > 1) {
+            faker_set_user_email(&users[i]);
+        }
+    }
+    name_set_free(&names);
+    progress_add(PROGRESS_USERS, count);
     return users;
 }
 
-Channel *generate_channels(int count, const User *users, int user_count) {
-    Channel *channels = malloc(sizeof(Channel) * (size_t)count);
-    for (int i = 0; i < count; i++) {
+Channel *generate_channels(Rng *rng, int64_t count, int64_t user_count, const IdKeys *ids) {
+    Channel *channels = checked_alloc(count, sizeof(Channel));
+    int64_t *member_marks = checked_calloc(user_count, sizeof(int64_t));
+    // Channel names are archive directories, so repeats get a suffix too
+    NameSet names;
+    name_set_init(&names, count < (1 << 20) ? (size_t)count : (size_t)(1 << 20));
+    for (int64_t i = 0; i < count; i++) {
+        id_format(&ids->channel, 'C', (uint64_t)i, channels[i].id);
+        
         // Pick a random creator
-        int creator_idx = rand() % user_count;
-        faker_create_channel(&channels[i], users[creator_idx].id);
+        int64_t creator_idx = (int64_t)rng_range64(rng, (uint64_t)user_count);
+        faker_create_channel(rng, &channels[i], creator_idx);
+        name_set_claim(&names, channels[i].name, sizeof(channels[i].name));
         
         // Assign members (random subset)
         // For simplicity, let's say 20-80% of users are in each channel
-        int num_members = (rand() % (user_count / 2 + 1)) + (user_count / 5);
+        int64_t num_members = (int64_t)rng_range64(rng, (uint64_t)(user_count / 2 + 1)) + (user_count / 5);
         if (num_members > user_count) num_members = user_count;
         if (num_members < 1) num_members = 1; // At least creator
         
-        channels[i].members = malloc(sizeof(char*) * (size_t)num_members);
+        channels[i].member_idx = checked_alloc(num_members, sizeof(int64_t));
         channels[i].member_count = 0;
         
         // Always add creator first
-        channels[i].members[0] = strdup(channels[i].creator);
+        channels[i].member_idx[0] = creator_idx;
         channels[i].member_count++;
         
-        // Add others (simple shuffle or random pick avoiding duplicates is O(N^2) or O(N) with shuffle)
-        // Since user_count is small (10-100), brute force check is fine.
+        // Add others by rejection sampling. A channel-stamped marker per user
+        // makes the duplicate check O(1), so large workspaces stay linear.
+        member_marks[creator_idx] = i + 1;
         while (channels[i].member_count < num_members) {
-            int u_idx = rand() % user_count;
-            const char *uid = users[u_idx].id;
-            
-            // Check existence
-            int exists = 0;
-            for (int k = 0; k < channels[i].member_count; k++) {
-                if (strcmp(channels[i].members[k], uid) == 0) {
-                    exists = 1;
-                    break;
-                }
-            }
+            int64_t u_idx = (int64_t)rng_range64(rng, (uint64_t)user_count);
             
-            if (!exists) {
-                channels[i].members[channels[i].member_count] = strdup(uid);
+            if (member_marks[u_idx] != i + 1) {
+                member_marks[u_idx] = i + 1;
+                channels[i].member_idx[channels[i].member_count] = u_idx;
                 channels[i].member_count++;
             }
         }
     }
+    name_set_free(&names);
+    free(member_marks);
+    progress_add(PROGRESS_CHANNELS, count);
     return channels;
 }
 
-Message *generate_messages(int count, const Channel *channels, int channel_count, const User *users, int user_count, double thread_prob) {
-    (void)user_count;
+// Draw the channel, author and timestamp of one message
+static double draw_message(Rng *rng, const Channel *channels, int64_t channel_count, time_t start, time_t now, int64_t *ch_idx, int64_t *user_idx) {
+    // Pick Channel using Gaussian
+    *ch_idx = rand_gaussian_index(rng, channel_count);
+    const Channel *ch = &channels[*ch_idx];
     
-    Message *messages = malloc(sizeof(Message) * (size_t)count);
+    // Pick User from Channel Members
+    // We can just pick uniformly from members for now, or Gaussian if we want "loud" users
+    if (ch->member_count > 0) {
+        int64_t m_idx = (int64_t)rng_range64(rng, (uint64_t)ch->member_count);
+        *user_idx = ch->member_idx[m_idx];
+    } else {
+        // Fallback (shouldn't happen)
+        *user_idx = 0;
+    }
     
-    // Sort channels? No, we access by index.
+    return faker_get_timestamp(rng, start, now);
+}
+
+Message *generate_messages(Rng *rng, int64_t count, const Channel *channels, int64_t channel_count, int64_t user_count, const ConversationModel *model, TextArena *text_arena) {
+    Message *messages = big_alloc(count, sizeof(Message));
     
     // Time window: Last 30 days
     time_t now = time(NULL);
     time_t start = now - (30 * 24 * 3600);
     
-    for (int i = 0; i < count; i++) {
-        // Pick Channel using Gaussian
-        int ch_idx = rand_gaussian_index(channel_count);
-        const Channel *ch = &channels[ch_idx];
-        
-        // Pick User from Channel Members
-        // We can just pick uniformly from members for now, or Gaussian if we want "loud" users
-        if (ch->member_count > 0) {
-            int m_idx = rand() % ch->member_count;
-            // Find the user object to verify? No need, we have the ID.
-            strcpy(messages[i].user, ch->members[m_idx]);
-        } else {
-            // Fallback (shouldn't happen)
-            strcpy(messages[i].user, users[0].id);
-        }
-        
-        // Store Channel ID for grouping later
-        strcpy(messages[i].channel, ch->id);
-        
-        strcpy(messages[i].type, "message");
-        messages[i].ts = faker_get_timestamp(start, now);
-        messages[i].text = faker_lorem_sentence(3, 20);
+    // Text is written later, in parallel, from a seed drawn per message.
+    // The draws match generate_messages_spilled, so both give the same text.
+    uint64_t *text_seeds = big_alloc(count, sizeof(uint64_t));
+    progress_phase(PROGRESS_PHASE_GENERATE, count);
+    for (int64_t i = 0; i < count; i++) {
+        messages[i].ts = draw_message(rng, channels, channel_count, start, now, &messages[i].channel_idx, &messages[i].user_idx);
+        text_seeds[i] = rng_next(rng);
+        messages[i].text = NULL;
+        messages[i].text_len = 0;
         
         // Initialize thread fields
         messages[i].thread_ts = 0;
-        messages[i].parent_user_id[0] = '\0';
+        messages[i].parent_idx = -1;
         messages[i].reply_count = 0;
-        messages[i].replies = NULL;
-        messages[i].replies_capacity = 0;
         messages[i].latest_reply = 0;
+        if ((i + 1) % PROGRESS_BATCH == 0) progress_add(PROGRESS_GENERATED, PROGRESS_BATCH);
     }
+    progress_add(PROGRESS_GENERATED, count % PROGRESS_BATCH);
     
-    // Sort messages by timestamp
-    qsort(messages, (size_t)count, sizeof(Message), compare_msgs);
+    // Sort messages by timestamp: radix sort the timestamps in microseconds
+    // with an index permutation, then move each message once.
+    uint64_t *ts_keys = big_alloc(count, sizeof(uint64_t));
+    int64_t *perm = big_alloc(count, sizeof(int64_t));
+    progress_phase(PROGRESS_PHASE_SORT, count);
+    for (int64_t i = 0; i < count; i++) {
+        ts_keys[i] = (uint64_t)llround(messages[i].ts * 1e6);
+        perm[i] = i;
+    }
+    radix_sort_pairs(ts_keys, perm, (size_t)count, model->workers);
+    // The sorted keys are spent: reuse them for the seeds in sorted order
+    for (int64_t i = 0; i < count; i++) {
+        ts_keys[i] = text_seeds[perm[i]];
+    }
+    big_free(text_seeds);
+    text_seeds = ts_keys;
+    radix_apply_permutation(messages, sizeof(Message), perm, (size_t)count);
+    big_free(perm);
     
     // Threading Pass
-    // Map channel ID to active thread index
-    // Since channel IDs are strings, we need a lookup or store index in a simpler way.
-    // We can assume channels array order is static. We can lookup index.
-    int *active_threads = malloc(sizeof(int) * (size_t)channel_count);
-    for(int i=0; i<channel_count; i++) active_threads[i] = -1;
-
-    for (int i = 0; i < count; i++) {
-        // Find channel index
-        int ch_idx = -1;
-        for(int c=0; c<channel_count; c++) {
-            if (strcmp(channels[c].id, messages[i].channel) == 0) {
-                ch_idx = c;
-                break;
-            }
+    // Group message indices by channel (stable, so each channel stays in
+    // timestamp order), then thread every channel independently.
+    int64_t *ch_offsets = checked_calloc(channel_count + 1, sizeof(int64_t));
+    int64_t *order = big_alloc(count, sizeof(int64_t));
+    for (int64_t i = 0; i < count; i++) {
+        ch_offsets[messages[i].channel_idx + 1]++;
+    }
+    for (int64_t c = 0; c < channel_count; c++) {
+        ch_offsets[c + 1] += ch_offsets[c];
+    }
+    int64_t *cursor = checked_alloc(channel_count, sizeof(int64_t));
+    memcpy(cursor, ch_offsets, sizeof(int64_t) * (size_t)channel_count);
+    for (int64_t i = 0; i < count; i++) {
+        order[cursor[messages[i].channel_idx]++] = i;
+    }
+    free(cursor);
+    
+    double *starter_weight = conversation_starter_weights(model, user_count);
+    int workers = model->workers > 0 ? model->workers : 1;
+    MessagePass pass = {
+        .messages = messages,
+        .order = order,
+        .text_seeds = text_seeds,
+        .starter_weight = starter_weight,
+        .model = model,
+        .seed = rng_next(rng),
+        .slots = model->max_open_threads > 0 ? model->max_open_threads : 1,
+        .arenas = checked_alloc(workers, sizeof(TextArena)),
+    };
+    pass.open = checked_alloc((int64_t)workers * pass.slots, sizeof(OpenThread));
+    
+    // Channel sizes are skewed by orders of magnitude, so channels are
+    // scheduled by size and stolen by idle workers. A channel is threaded
+    // in timestamp order and cannot be split.
+    WorkTask *tasks = checked_alloc(channel_count, sizeof(WorkTask));
+    for (int64_t c = 0; c < channel_count; c++) {
+        tasks[c].begin = ch_offsets[c];
+        tasks[c].end = ch_offsets[c + 1];
+        tasks[c].node = numa_owner(c);
+    }
+    progress_phase(PROGRESS_PHASE_THREAD, count);
+    scheduler_run(workers, tasks, channel_count, 0, thread_channel, &pass);
+    
+    // Text depends only on its seed, so channels can be split anywhere.
+    // Each worker writes into an arena on its own node.
+    for (int w = 0; w < workers; w++) {
+        text_arena_init(&pass.arenas[w], text_arena->chunk_size);
+        pass.arenas[w].node = numa_worker_node(w);
+    }
+    for (int64_t c = 0; c < channel_count; c++) {
+        tasks[c].begin = ch_offsets[c];
+        tasks[c].end = ch_offsets[c + 1];
+        tasks[c].node = numa_owner(c);
+    }
+    progress_phase(PROGRESS_PHASE_TEXT, count);
+    scheduler_run(workers, tasks, channel_count, GENERATOR_TEXT_GRAIN, write_texts, &pass);
+    free(tasks);
+    for (int w = 0; w < workers; w++) {
+        text_arena_merge(text_arena, &pass.arenas[w]);
+    }
+    
+    free(pass.arenas);
+    free(pass.open);
+    free(starter_weight);
+    big_free(text_seeds);
+    big_free(order);
+    free(ch_offsets);
+    
+    return messages;
+}
+
+// Message as spilled before threading, keyed by channel then microseconds
+typedef struct {
+    uint64_t key;
+    double ts;
+    uint64_t text_seed;
+    int64_t user_idx;
+    int64_t channel_idx;
+} SpillMessage;
+
+// Message after threading, written in export order
+typedef struct {
+    double ts;
+    double thread_ts;
+    uint64_t text_seed;
+    int64_t user_idx;
+    int64_t channel_idx;
+    int64_t parent_user;   // -1 unless a reply
+} ThreadedMessage;
+
+// Reply keyed by the export position of its parent
+typedef struct {
+    uint64_t key;
+    double ts;
+    int64_t user_idx;
+} SpillReply;
+
+struct MessageSpill {
+    FILE *threaded;        // ThreadedMessage records in export order
+    SpillSorter replies;   // SpillReply records by parent position
+    uint64_t position;     // Export position of the next message
+    size_t runs;
+    TextSource text;
+    TextArena arena;       // Text of the current message
+    ReplyRef *reply_buf;
+    size_t reply_capacity;
+};
+
+static int bit_width(uint64_t v) {
+    int bits = 0;
+    while (v) {
+        bits++;
+        v >>= 1;
+    }
+    return bits;
+}
+
+MessageSpill *generate_messages_spilled(Rng *rng, int64_t count, const Channel *channels, int64_t channel_count, int64_t user_count, const ConversationModel *model, size_t memory, const char *spill_dir) {
+    time_t now = time(NULL);
+    time_t start = now - (30 * 24 * 3600);
+    
+    // Key layout: channel index above microseconds since the window start
+    uint64_t start_us = (uint64_t)start * 1000000;
+    int ts_bits = bit_width((uint64_t)(now - start + 1) * 1000000);
+    if (ts_bits + bit_width((uint64_t)channel_count) > 64) {
+        fprintf(stderr, "Error: Too many channels to spill messages\n");
+        return NULL;
+    }
+    
+    // Half the budget sorts messages, the other half sorts replies while
+    // the messages are merged
+    SpillSorter sorter;
+    spill_sorter_init(&sorter, sizeof(SpillMessage), memory / 2, spill_dir, model->workers);
+    progress_phase(PROGRESS_PHASE_GENERATE, count);
+    for (int64_t i = 0; i < count; i++) {
+        SpillMessage rec;
+        rec.ts = draw_message(rng, channels, channel_count, start, now, &rec.channel_idx, &rec.user_idx);
+        rec.text_seed = rng_next(rng);
+        rec.key = ((uint64_t)rec.channel_idx << ts_bits) | ((uint64_t)llround(rec.ts * 1e6) - start_us);
+        spill_sorter_add(&sorter, &rec);
+        if ((i + 1) % PROGRESS_BATCH == 0) progress_add(PROGRESS_GENERATED, PROGRESS_BATCH);
+    }
+    progress_add(PROGRESS_GENERATED, count % PROGRESS_BATCH);
+    progress_phase(PROGRESS_PHASE_SORT, count);
+    spill_sorter_finish(&sorter);
+    
+    MessageSpill *spill = calloc(1, sizeof(MessageSpill));
+    spill->threaded = spill_temp_file(spill_dir);
+    spill_sorter_init(&spill->replies, sizeof(SpillReply), memory / 2, spill_dir, model->workers);
+    spill->text = model->text;
+    text_arena_init(&spill->arena, 0);
+    
+    // Threading pass over the merged stream. Channels arrive one after
+    // another in timestamp order, which is all thread_next needs, and each
+    // gets the same RNG stream as in the in-memory pass.
+    double *starter_weight = conversation_starter_weights(model, user_count);
+    int slots = model->max_open_threads > 0 ? model->max_open_threads : 1;
+    ChannelThreads ct = { .open = malloc(sizeof(OpenThread) * (size_t)slots) };
+    uint64_t seed = rng_next(rng);
+    int64_t current_channel = -1;
+    
+    SpillMessage rec;
+    int64_t position;
+    progress_phase(PROGRESS_PHASE_THREAD, count);
+    for (position = 0; spill_sorter_next(&sorter, &rec); position++) {
+        if (rec.channel_idx != current_channel) {
+            current_channel = rec.channel_idx;
+            channel_threads_reset(&ct, seed, current_channel);
         }
         
-        if (ch_idx == -1) continue; // Should not happen
-
-        bool made_reply = false;
-        if (active_threads[ch_idx] != -1) {
-            // Check if we reply (thread_prob)
-            // Ensure we don't reply to a message in the future (already sorted so ok)
-            // Ensure thread is recent? (e.g. within 2 days). Slack threads can be old, but usually recent.
-            // Let's enforce 3 day limit for realism.
-            Message *parent = &messages[active_threads[ch_idx]];
-            double time_diff = messages[i].ts - parent->ts;
-            
-            if (time_diff < 3 * 24 * 3600 && ((double)rand() / RAND_MAX < thread_prob)) {
-                // Reply
-                messages[i].thread_ts = parent->ts;
-                strcpy(messages[i].parent_user_id, parent->user);
-                
-                // Update parent
-                parent->reply_count++;
-                parent->latest_reply = messages[i].ts;
-                
-                // Add to replies array
-                if (parent->reply_count > parent->replies_capacity) {
-                    int new_cap = parent->replies_capacity == 0 ? 4 : parent->replies_capacity * 2;
-                    ReplyInfo *tmp = realloc(parent->replies, sizeof(ReplyInfo) * (size_t)new_cap);
-                    if (tmp) {
-                        parent->replies = tmp;
-                        parent->replies_capacity = new_cap;
-                        
-                        ReplyInfo *rep = &parent->replies[parent->reply_count - 1];
-                        strcpy(rep->user, messages[i].user);
-                        rep->ts = messages[i].ts;
-                        
-                        made_reply = true;
-                    }
-                } else {
-                    ReplyInfo *rep = &parent->replies[parent->reply_count - 1];
-                    strcpy(rep->user, messages[i].user);
-                    rep->ts = messages[i].ts;
-                    made_reply = true;
-                }
+        ThreadedMessage out = {
+            .ts = rec.ts,
+            .thread_ts = 0,
+            .text_seed = rec.text_seed,
+            .user_idx = rec.user_idx,
+            .channel_idx = rec.channel_idx,
+            .parent_user = -1,
+        };
+        OpenThread joined;
+        switch (thread_next(model, &ct, position, rec.ts, rec.user_idx, starter_weight[rec.user_idx], &joined)) {
+            case THREAD_ROLE_REPLY: {
+                out.thread_ts = joined.parent_ts;
+                out.parent_user = joined.parent_user;
+                SpillReply reply = { .key = (uint64_t)joined.parent, .ts = rec.ts, .user_idx = rec.user_idx };
+                spill_sorter_add(&spill->replies, &reply);
+                break;
             }
+            case THREAD_ROLE_START:
+                out.thread_ts = rec.ts;
+                break;
+            case THREAD_ROLE_NONE:
+                break;
         }
-        
-        if (!made_reply) {
-            // Chance to become new active thread
-            // 20% chance to start a thread context
-            if ((double)rand() / RAND_MAX < 0.2) {
-                active_threads[ch_idx] = i;
-                // Mark this message as a thread starter (Slack convention: thread_ts = ts)
-                // But in JSON export, usually thread_ts is present on PARENT too?
-                // Analysis said: "Parent Message: Contains thread_ts (equal to its own ts)"
-                messages[i].thread_ts = messages[i].ts;
+        if (fwrite(&out, sizeof(out), 1, spill->threaded) != 1) {
+            perror("Failed to write spill file");
+            exit(1);
+        }
+        if ((position + 1) % PROGRESS_BATCH == 0) progress_add(PROGRESS_THREADED, PROGRESS_BATCH);
+    }
+    progress_add(PROGRESS_THREADED, position % PROGRESS_BATCH);
+    
+    free(ct.open);
+    free(starter_weight);
+    spill->runs = spill_sorter_runs(&sorter);
+    spill_sorter_free(&sorter);
+    
+    spill_sorter_finish(&spill->replies);
+    spill->runs += spill_sorter_runs(&spill->replies);
+    rewind(spill->threaded);
+    return spill;
+}
+
+bool message_spill_next(MessageSpill *spill, StreamedMessage *out) {
+    ThreadedMessage rec;
+    if (fread(&rec, sizeof(rec), 1, spill->threaded) != 1) return false;
+    uint64_t position = spill->position++;
+    
+    // Replies were sorted by parent position, so this message's replies are
+    // next in line, in timestamp order
+    int64_t reply_count = 0;
+    uint64_t key;
+    while (spill_sorter_peek(&spill->replies, &key) && key == position) {
+        SpillReply reply;
+        spill_sorter_next(&spill->replies, &reply);
+        if ((size_t)reply_count == spill->reply_capacity) {
+            spill->reply_capacity = spill->reply_capacity ? checked_mul(spill->reply_capacity, 2) : 64;
+            spill->reply_buf = realloc(spill->reply_buf, checked_mul(sizeof(ReplyRef), spill->reply_capacity));
+            if (!spill->reply_buf) {
+                fprintf(stderr, "Failed to allocate reply buffer\n");
+                exit(1);
             }
         }
+        spill->reply_buf[reply_count].ts = reply.ts;
+        spill->reply_buf[reply_count].user_idx = reply.user_idx;
+        reply_count++;
     }
-    free(active_threads);
     
-    return messages;
+    Rng text_rng;
+    rng_seed(&text_rng, rec.text_seed);
+    text_arena_reset(&spill->arena);
+    
+    Message *m = &out->msg;
+    m->ts = rec.ts;
+    m->text = faker_message_text(&text_rng, &spill->text, &spill->arena, 3, 20, &m->text_len);
+    m->user_idx = rec.user_idx;
+    m->channel_idx = rec.channel_idx;
+    m->thread_ts = rec.thread_ts;
+    m->parent_idx = -1;
+    m->reply_count = reply_count;
+    m->latest_reply = reply_count > 0 ? spill->reply_buf[reply_count - 1].ts : 0;
+    out->parent_user_idx = rec.parent_user;
+    out->replies = spill->reply_buf;
+    return true;
+}
+
+size_t message_spill_runs(const MessageSpill *spill) {
+    return spill->runs;
+}
+
+uint64_t message_spill_disk_bytes(int64_t messages, int64_t replies) {
+    // The merged message runs are only dropped after threading has written
+    // every record out again and spilled the replies
+    return (uint64_t)messages * (sizeof(SpillMessage) + sizeof(ThreadedMessage)) +
+           (uint64_t)replies * sizeof(SpillReply);
+}
+
+void message_spill_free(MessageSpill *spill) {
+    if (!spill) return;
+    fclose(spill->threaded);
+    spill_sorter_free(&spill->replies);
+    text_arena_free(&spill->arena);
+    free(spill->reply_buf);
+    free(spill);
+}
+
+void generate_thread_index(const Message *messages, int64_t count, ThreadIndex *threads) {
+    int64_t *offsets = big_alloc(count + 1, sizeof(int64_t));
+    
+    // Inclusive prefix sum of reply counts: offsets[i] is the end of i's range
+    int64_t total = 0;
+    for (int64_t i = 0; i < count; i++) {
+        total += messages[i].reply_count;
+        offsets[i] = total;
+    }
+    offsets[count] = total;
+    
+    // Fill back to front so each offsets[p] walks down to the start of its
+    // range, leaving children of the same parent in timestamp order.
+    int64_t *children = big_alloc(total, sizeof(int64_t));
+    for (int64_t i = count - 1; i >= 0; i--) {
+        int64_t p = messages[i].parent_idx;
+        if (p >= 0) {
+            children[--offsets[p]] = i;
+        }
+    }
+    
+    threads->offsets = offsets;
+    threads->children = children;
+}
+
+void free_thread_index(ThreadIndex *threads) {
+    big_free(threads->offsets);
+    big_free(threads->children);
+    threads->offsets = NULL;
+    threads->children = NULL;
 }
 
-void free_users(User *users, int count) {
+void free_users(User *users, int64_t count) {
     (void)count; // unused
     free(users);
 }
 
-void free_channels(Channel *channels, int count) {
-    for (int i = 0; i < count; i++) {
-        for (int j = 0; j < channels[i].member_count; j++) {
-            free(channels[i].members[j]);
-        }
-        free(channels[i].members);
+void free_channels(Channel *channels, int64_t count) {
+    for (int64_t i = 0; i < count; i++) {
+        free(channels[i].member_idx);
     }
     free(channels);
 }
 
-void free_messages(Message *messages, int count) {
-    for (int i = 0; i < count; i++) {
-        free(messages[i].text);
-        if (messages[i].replies) {
-            free(messages[i].replies);
-        }
-    }
-    free(messages);
+void free_messages(Message *messages, int64_t count) {
+    (void)count; // unused, text lives in the caller's arena
+    big_free(messages);
 }
@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "history.h"
+#include "checked.h"
+#include "faker.h"
+#include "rng.h"
+
+// Sample threads drawn to calibrate replies per top-level message
+#define HISTORY_CALIBRATION_THREADS 65536
+
+// Spreads channel indices over the seed space
+#define HISTORY_CHANNEL_MIX 0x9E3779B97F4A7C15ULL
+
+static double normal_cdf(double x) {
+    return 0.5 * erfc(-x / sqrt(2.0));
+}
+
+// Replies of a thread opened at ts_us. Each reply waits a drawn delay
+// after the one before; the thread goes quiet at a delay longer than
+// max_idle and cannot pass the end of the window. The replies and their
+// text seeds are stored if replies is not NULL.
+static int64_t draw_thread(const History *h, Rng *rng, const Channel *ch, int64_t ts_us, ReplyRef *replies, uint64_t *seeds) {
+    const ConversationModel *model = h->model;
+    int size = conversation_thread_size(model, rng);
+    int64_t t = ts_us;
+    int64_t count = 0;
+    for (int k = 0; k < size; k++) {
+        double delay = conversation_reply_delay(model, rng);
+        if (delay > model->max_idle) break;
+        int64_t step = llround(delay * 1e6);
+        t += step > 0 ? step : 1;
+        if (t >= h->end_us) break;
+        int64_t user = ch->member_idx[rng_range64(rng, (uint64_t)ch->member_count)];
+        uint64_t seed = rng_next(rng);
+        if (replies) {
+            replies[count].ts = (double)t / 1e6;
+            replies[count].user_idx = user;
+            seeds[count] = seed;
+        }
+        count++;
+    }
+    return count;
+}
+
+void history_init(History *h, uint64_t seed, int64_t messages, const Channel *channels, int64_t channel_count,
+                  int64_t user_count, const ConversationModel *model, time_t now) {
+    memset(h, 0, sizeof(*h));
+    h->channels = channels;
+    h->channel_count = channel_count;
+    h->model = model;
+    uint64_t x = seed;
+    h->block_seed = rng_splitmix64(&x);
+    h->message_seed = rng_splitmix64(&x);
+    h->end_us = (int64_t)now * 1000000;
+    h->start_us = h->end_us - (int64_t)30 * 24 * 3600 * 1000000;
+    h->starter_weight = conversation_starter_weights(model, user_count);
+
+    // Replies per thread, from sample threads opened across the window
+    if (model->max_open_threads > 0 && model->start_prob > 0) {
+        Rng rng;
+        rng_seed(&rng, rng_splitmix64(&x));
+        double replies = 0;
+        for (int i = 0; i < HISTORY_CALIBRATION_THREADS; i++) {
+            const Channel *ch = &channels[rng_range64(&rng, (uint64_t)channel_count)];
+            int64_t ts = h->start_us + (int64_t)rng_range64(&rng, (uint64_t)(h->end_us - h->start_us));
+            replies += (double)draw_thread(h, &rng, ch, ts, NULL, NULL);
+        }
+        h->replies_per_message = model->start_prob * replies / HISTORY_CALIBRATION_THREADS;
+    }
+    int64_t top_level = llround((double)messages / (1.0 + h->replies_per_message));
+    if (top_level < 1) top_level = 1;
+
+    // Channels take the shares the Gaussian channel choice gives them
+    double mean = (double)channel_count / 2.0;
+    double sigma = (double)channel_count / 6.0;
+    if (sigma < 1.0) sigma = 1.0;
+    h->offsets = checked_alloc(channel_count + 1, sizeof(int64_t));
+    h->offsets[0] = 0;
+    for (int64_t c = 1; c < channel_count; c++) {
+        double below = normal_cdf(((double)c - 0.5 - mean) / sigma);
+        h->offsets[c] = llround((double)top_level * below);
+    }
+    h->offsets[channel_count] = top_level;
+}
+
+void history_free(History *h) {
+    free(h->offsets);
+    free(h->starter_weight);
+    h->offsets = NULL;
+    h->starter_weight = NULL;
+}
+
+int64_t history_count(const History *h, int64_t channel) {
+    return h->offsets[channel + 1] - h->offsets[channel];
+}
+
+int64_t history_total(const History *h) {
+    return h->offsets[h->channel_count];
+}
+
+void history_reader_init(HistoryReader *r) {
+    memset(r, 0, sizeof(*r));
+    r->channel = -1;
+    r->block = -1;
+    text_arena_init(&r->arena, 1 << 20);
+}
+
+void history_reader_free(HistoryReader *r) {
+    free(r->replies);
+    free(r->reply_seeds);
+    text_arena_free(&r->arena);
+}
+
+// --- Blocks ---
+
+// Start of block b's share of the window; b may be the block count
+static int64_t span_begin(const History *h, int64_t count, int64_t b) {
+    double share = (double)(b * HISTORY_BLOCK) / (double)count;
+    if (share >= 1.0) return h->end_us;
+    return h->start_us + (int64_t)(share * (double)(h->end_us - h->start_us));
+}
+
+static int compare_ts(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Timestamps of block b, sorted and, room permitting, distinct: Slack
+// addresses messages by channel and timestamp
+static void load_block(const History *h, HistoryReader *r, int64_t channel, int64_t b) {
+    if (r->channel == channel && r->block == b) return;
+    int64_t count = history_count(h, channel);
+    int64_t n = count - b * HISTORY_BLOCK < HISTORY_BLOCK ? count - b * HISTORY_BLOCK : HISTORY_BLOCK;
+    int64_t begin = span_begin(h, count, b);
+    uint64_t span = (uint64_t)(span_begin(h, count, b + 1) - begin);
+    if (span == 0) span = 1;
+
+    Rng rng;
+    rng_seed_stream(&rng, h->block_seed + (uint64_t)channel * HISTORY_CHANNEL_MIX, (uint64_t)b);
+    for (int64_t i = 0; i < n; i++) {
+        r->ts[i] = begin + (int64_t)rng_range64(&rng, span);
+    }
+    qsort(r->ts, (size_t)n, sizeof(int64_t), compare_ts);
+    for (int round = 0; span >= (uint64_t)n && round < 64; round++) {
+        bool repeated = false;
+        for (int64_t i = 1; i < n; i++) {
+            if (r->ts[i] == r->ts[i - 1]) {
+                r->ts[i] = begin + (int64_t)rng_range64(&rng, span);
+                repeated = true;
+            }
+        }
+        if (!repeated) break;
+        qsort(r->ts, (size_t)n, sizeof(int64_t), compare_ts);
+    }
+    r->channel = channel;
+    r->block = b;
+}
+
+int64_t history_rank(const History *h, HistoryReader *r, int64_t channel, int64_t ts_us) {
+    int64_t count = history_count(h, channel);
+    if (count == 0 || ts_us <= h->start_us) return 0;
+    if (ts_us >= h->end_us) return count;
+
+    // Guess the block from the even spans, then step to the right one
+    int64_t blocks = (count + HISTORY_BLOCK - 1) / HISTORY_BLOCK;
+    double share = (double)(ts_us - h->start_us) / (double)(h->end_us - h->start_us);
+    int64_t b = (int64_t)(share * (double)count) / HISTORY_BLOCK;
+    if (b >= blocks) b = blocks - 1;
+    while (b > 0 && span_begin(h, count, b) > ts_us) b--;
+    while (b + 1 < blocks && span_begin(h, count, b + 1) <= ts_us) b++;
+
+    load_block(h, r, channel, b);
+    int64_t n = count - b * HISTORY_BLOCK < HISTORY_BLOCK ? count - b * HISTORY_BLOCK : HISTORY_BLOCK;
+    int64_t lo = 0, hi = n;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (r->ts[mid] < ts_us) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return b * HISTORY_BLOCK + lo;
+}
+
+// --- Messages ---
+
+static const char *message_text(const History *h, HistoryReader *r, uint64_t seed, size_t *len) {
+    Rng rng;
+    rng_seed(&rng, seed);
+    return faker_message_text(&rng, &h->model->text, &r->arena, 3, 20, len);
+}
+
+void history_get(const History *h, HistoryReader *r, int64_t channel, int64_t pos, HistoryMessage *out) {
+    load_block(h, r, channel, pos / HISTORY_BLOCK);
+    int64_t ts_us = r->ts[pos % HISTORY_BLOCK];
+    const Channel *ch = &h->channels[channel];
+    const ConversationModel *model = h->model;
+
+    // Draws in a fixed order from the message's own stream
+    Rng rng;
+    rng_seed_stream(&rng, h->message_seed + (uint64_t)channel * HISTORY_CHANNEL_MIX, (uint64_t)pos);
+    Message *m = &out->msg;
+    m->ts = (double)ts_us / 1e6;
+    m->user_idx = ch->member_idx[rng_range64(&rng, (uint64_t)ch->member_count)];
+    m->channel_idx = channel;
+    uint64_t text_seed = rng_next(&rng);
+    m->thread_ts = 0;
+    m->parent_idx = -1;
+    m->reply_count = 0;
+    m->latest_reply = 0;
+    out->replies = r->replies;
+    out->reply_seeds = r->reply_seeds;
+
+    if (model->max_open_threads > 0 && rng_uniform(&rng) < model->start_prob * h->starter_weight[m->user_idx]) {
+        m->thread_ts = m->ts;
+        // Threads are capped at max_thread_size replies
+        size_t need = (size_t)model->max_thread_size;
+        if (need > r->reply_capacity) {
+            r->replies = realloc(r->replies, checked_mul(need, sizeof(ReplyRef)));
+            r->reply_seeds = realloc(r->reply_seeds, checked_mul(need, sizeof(uint64_t)));
+            if (!r->replies || !r->reply_seeds) {
+                fprintf(stderr, "Error: Out of memory\n");
+                exit(1);
+            }
+            r->reply_capacity = need;
+        }
+        m->reply_count = draw_thread(h, &rng, ch, ts_us, r->replies, r->reply_seeds);
+        if (m->reply_count > 0) m->latest_reply = r->replies[m->reply_count - 1].ts;
+        out->replies = r->replies;
+        out->reply_seeds = r->reply_seeds;
+    }
+    m->text = message_text(h, r, text_seed, &m->text_len);
+}
+
+void history_reply(const History *h, HistoryReader *r, const HistoryMessage *parent, int64_t k, Message *out) {
+    const ReplyRef *reply = &parent->replies[k];
+    out->ts = reply->ts;
+    out->user_idx = reply->user_idx;
+    out->channel_idx = parent->msg.channel_idx;
+    out->thread_ts = parent->msg.ts;
+    out->parent_idx = -1;
+    out->reply_count = 0;
+    out->latest_reply = 0;
+    out->text = message_text(h, r, parent->reply_seeds[k], &out->text_len);
+}
@@ -0,0 +1,94 @@
+#include "ids.h"
+#include "rng.h"
+
+// The Feistel network runs on 52 bits (2^52 > 36^10) as two 26-bit halves.
+// Values that land outside [0, 36^10) are permuted again (cycle walking);
+// with 2^52 / 36^10 ~ 1.23 this takes 1.23 rounds on average.
+#define ID_HALF_BITS 26
+#define ID_HALF_MASK ((1ULL << ID_HALF_BITS) - 1)
+
+void id_key_init(IdKey *key, uint64_t seed, uint64_t tweak) {
+    uint64_t x = seed ^ (tweak * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < ID_FEISTEL_ROUNDS; i++) {
+        key->round_keys[i] = rng_splitmix64(&x);
+    }
+}
+
+void id_keys_init(IdKeys *keys, uint64_t seed) {
+    id_key_init(&keys->user, seed, 'U');
+    id_key_init(&keys->channel, seed, 'C');
+}
+
+static uint64_t round_function(uint64_t half, uint64_t round_key) {
+    uint64_t z = (half ^ round_key) * 0x9E3779B97F4A7C15ULL;
+    z ^= z >> 32;
+    z *= 0xBF58476D1CE4E5B9ULL;
+    return (z >> 29) & ID_HALF_MASK;
+}
+
+static uint64_t feistel(const IdKey *key, uint64_t value) {
+    uint64_t left = value >> ID_HALF_BITS;
+    uint64_t right = value & ID_HALF_MASK;
+    for (int i = 0; i < ID_FEISTEL_ROUNDS; i++) {
+        uint64_t next = left ^ round_function(right, key->round_keys[i]);
+        left = right;
+        right = next;
+    }
+    return (left << ID_HALF_BITS) | right;
+}
+
+static uint64_t feistel_inverse(const IdKey *key, uint64_t value) {
+    uint64_t left = value >> ID_HALF_BITS;
+    uint64_t right = value & ID_HALF_MASK;
+    for (int i = ID_FEISTEL_ROUNDS - 1; i >= 0; i--) {
+        uint64_t previous = right ^ round_function(left, key->round_keys[i]);
+        right = left;
+        left = previous;
+    }
+    return (left << ID_HALF_BITS) | right;
+}
+
+uint64_t id_permute(const IdKey *key, uint64_t index) {
+    uint64_t value = feistel(key, index);
+    while (value >= ID_SPACE) {
+        value = feistel(key, value);
+    }
+    return value;
+}
+
+uint64_t id_unpermute(const IdKey *key, uint64_t value) {
+    // Walking the cycle backwards leaves [0, ID_SPACE) at the same point
+    uint64_t index = feistel_inverse(key, value);
+    while (index >= ID_SPACE) {
+        index = feistel_inverse(key, index);
+    }
+    return index;
+}
+
+int64_t id_parse(const IdKey *key, char prefix, const char *id) {
+    if (id[0] != prefix) return -1;
+    uint64_t value = 0;
+    for (int i = 1; i <= ID_SUFFIX_LEN; i++) {
+        char c = id[i];
+        if (c >= '0' && c <= '9') {
+            value = value * 36 + (uint64_t)(c - '0');
+        } else if (c >= 'A' && c <= 'Z') {
+            value = value * 36 + (uint64_t)(c - 'A' + 10);
+        } else {
+            return -1;
+        }
+    }
+    if (id[ID_SUFFIX_LEN + 1] != '\0') return -1;
+    return (int64_t)id_unpermute(key, value);
+}
+
+void id_format(const IdKey *key, char prefix, uint64_t index, char *out) {
+    static const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    uint64_t value = id_permute(key, index);
+    out[0] = prefix;
+    for (int i = ID_SUFFIX_LEN; i >= 1; i--) {
+        out[i] = charset[value % 36];
+        value /= 36;
+    }
+    out[ID_SUFFIX_LEN + 1] = '\0';
+}
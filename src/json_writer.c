@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "json_writer.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JSON_WRITER_X86 1
+#include <immintrin.h>
+#endif
+
+// --- Escape scanning ---
+
+static size_t scan_scalar(const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c < 0x20 || c == '"' || c == '\\') return i;
+    }
+    return len;
+}
+
+#ifdef JSON_WRITER_X86
+__attribute__((target("sse2")))
+static size_t scan_sse2(const char *s, size_t len) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i ctrl_max = _mm_set1_epi8(0x1F);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        // v <= 0x1F (unsigned) exactly when min(v, 0x1F) == v
+        __m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl_max), v);
+        __m128i hit = _mm_or_si128(ctrl, _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+        int mask = _mm_movemask_epi8(hit);
+        if (mask) return i + (size_t)__builtin_ctz((unsigned int)mask);
+    }
+    return i + scan_scalar(s + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const char *s, size_t len) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i ctrl_max = _mm256_set1_epi8(0x1F);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(s + i));
+        __m256i ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl_max), v);
+        __m256i hit = _mm256_or_si256(ctrl, _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(hit);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    return i + scan_sse2(s + i, len - i);
+}
+#endif
+
+static size_t (*scan_impl)(const char *, size_t) = scan_scalar;
+static pthread_once_t scan_once = PTHREAD_ONCE_INIT;
+
+static void select_scan_impl(void) {
+#ifdef JSON_WRITER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        scan_impl = scan_avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        scan_impl = scan_sse2;
+    }
+#endif
+}
+
+size_t json_escape_scan(const char *s, size_t len) {
+    pthread_once(&scan_once, select_scan_impl);
+    return scan_impl(s, len);
+}
+
+// --- Buffer ---
+
+static void reserve(JsonWriter *w, size_t extra) {
+    if (w->len + extra <= w->cap) return;
+    size_t cap = w->cap ? w->cap : 256;
+    while (cap < w->len + extra) cap *= 2;
+    char *data = realloc(w->data, cap);
+    if (!data) {
+        fprintf(stderr, "json_writer: out of memory\n");
+        exit(1);
+    }
+    w->data = data;
+    w->cap = cap;
+}
+
+static void put(JsonWriter *w, const char *s, size_t len) {
+    reserve(w, len);
+    memcpy(w->data + w->len, s, len);
+    w->len += len;
+}
+
+static void put_char(JsonWriter *w, char c) {
+    reserve(w, 1);
+    w->data[w->len++] = c;
+}
+
+static void put_tabs(JsonWriter *w, int count) {
+    reserve(w, (size_t)count);
+    memset(w->data + w->len, '\t', (size_t)count);
+    w->len += (size_t)count;
+}
+
+void json_writer_init(JsonWriter *w, size_t initial_cap) {
+    w->data = NULL;
+    w->len = 0;
+    w->cap = 0;
+    w->depth = 0;
+    if (initial_cap > 0) reserve(w, initial_cap);
+}
+
+void json_writer_reset(JsonWriter *w) {
+    w->len = 0;
+    w->depth = 0;
+}
+
+void json_writer_drain(JsonWriter *w) {
+    w->len = 0;
+}
+
+void json_writer_free(JsonWriter *w) {
+    free(w->data);
+    w->data = NULL;
+    w->len = w->cap = 0;
+}
+
+// --- Structure ---
+
+// Separator before a value; object members get theirs from json_key
+static void begin_value(JsonWriter *w) {
+    if (w->depth > 0 && w->is_array[w->depth - 1]) {
+        if (!w->is_empty[w->depth - 1]) put(w, ", ", 2);
+        w->is_empty[w->depth - 1] = false;
+    }
+}
+
+static void push(JsonWriter *w, bool is_array) {
+    if (w->depth == JSON_WRITER_MAX_DEPTH) {
+        fprintf(stderr, "json_writer: nesting too deep\n");
+        exit(1);
+    }
+    w->is_array[w->depth] = is_array;
+    w->is_empty[w->depth] = true;
+    w->depth++;
+}
+
+void json_begin_object(JsonWriter *w) {
+    begin_value(w);
+    put(w, "{\n", 2);
+    push(w, false);
+}
+
+void json_end_object(JsonWriter *w) {
+    if (!w->is_empty[w->depth - 1]) put_char(w, '\n');
+    w->depth--;
+    put_tabs(w, w->depth);
+    put_char(w, '}');
+}
+
+void json_begin_array(JsonWriter *w) {
+    begin_value(w);
+    put_char(w, '[');
+    push(w, true);
+}
+
+void json_continue_array(JsonWriter *w) {
+    push(w, true);
+    w->is_empty[w->depth - 1] = false;
+}
+
+void json_end_array(JsonWriter *w) {
+    w->depth--;
+    put_char(w, ']');
+}
+
+static void put_string(JsonWriter *w, const char *s, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    // Worst case every byte becomes \u00XX
+    reserve(w, len * 6 + 2);
+    char *out = w->data + w->len;
+    *out++ = '"';
+    
+    size_t i = 0;
+    while (i < len) {
+        size_t clean = json_escape_scan(s + i, len - i);
+        memcpy(out, s + i, clean);
+        out += clean;
+        i += clean;
+        if (i == len) break;
+        
+        unsigned char c = (unsigned char)s[i++];
+        *out++ = '\\';
+        switch (c) {
+            case '"': *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '\b': *out++ = 'b'; break;
+            case '\f': *out++ = 'f'; break;
+            case '\n': *out++ = 'n'; break;
+            case '\r': *out++ = 'r'; break;
+            case '\t': *out++ = 't'; break;
+            default:
+                *out++ = 'u';
+                *out++ = '0';
+                *out++ = '0';
+                *out++ = hex[c >> 4];
+                *out++ = hex[c & 0xF];
+                break;
+        }
+    }
+    *out++ = '"';
+    w->len = (size_t)(out - w->data);
+}
+
+void json_key(JsonWriter *w, const char *key) {
+    if (!w->is_empty[w->depth - 1]) put(w, ",\n", 2);
+    w->is_empty[w->depth - 1] = false;
+    put_tabs(w, w->depth);
+    put_string(w, key, strlen(key));
+    put(w, ":\t", 2);
+}
+
+// --- Values ---
+
+void json_string(JsonWriter *w, const char *s, size_t len) {
+    begin_value(w);
+    put_string(w, s, len);
+}
+
+void json_cstring(JsonWriter *w, const char *s) {
+    json_string(w, s, strlen(s));
+}
+
+void json_int(JsonWriter *w, long long value) {
+    char buf[24];
+    int n = snprintf(buf, sizeof(buf), "%lld", value);
+    begin_value(w);
+    put(w, buf, (size_t)n);
+}
+
+void json_bool(JsonWriter *w, bool value) {
+    begin_value(w);
+    if (value) {
+        put(w, "true", 4);
+    } else {
+        put(w, "false", 5);
+    }
+}
@@ -3,96 +3,509 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
-#include "faker.h"
-#include "generator.h"
-#include "export_manager.h"
+#include <errno.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <signal.h>
+#include <pthread.h>
+#include "syngen.h"
+#include "numa.h"
+#include "big_alloc.h"
+#include "progress.h"
+#include "trace.h"
+#include "metrics.h"
 
 void print_usage(const char *prog_name) {
-    fprintf(stderr, "Usage: %s -c <channels> -m <messages> -u <users> -t <thread_probability> <output_filename>\n", prog_name);
+    fprintf(stderr, "Usage: %s -c <channels> -m <messages> -u <users> -t <thread_probability> [options] <output_filename>\n", prog_name);
+    fprintf(stderr, "       %s serve -c <channels> -m <messages> -u <users> [options]\n", prog_name);
     fprintf(stderr, "Defaults: -c 25 -m 1000 -u 10 -t 0.1\n");
+    fprintf(stderr, "Counts accept K, M, G and T suffixes (powers of 1000), e.g. -m 5G\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -j, --jobs N                 Worker threads (default: online CPUs)\n");
+    fprintf(stderr, "  -s, --seed N                 Random seed (default: current time)\n");
+    fprintf(stderr, "  --thread-start P             Chance a top-level message opens a thread (default: 0.2)\n");
+    fprintf(stderr, "  --max-open-threads N         Concurrent open threads per channel (default: 4)\n");
+    fprintf(stderr, "  --thread-size DIST           powerlaw:ALPHA or lognormal:MU,SIGMA (default: powerlaw:2.0)\n");
+    fprintf(stderr, "  --max-thread-size N          Cap on replies per thread (default: 100000)\n");
+    fprintf(stderr, "  --reply-delay DIST           exp:MEAN or lognormal:MU,SIGMA in seconds (default: exp:3600)\n");
+    fprintf(stderr, "  --thread-idle SECONDS        Close threads idle this long (default: 259200)\n");
+    fprintf(stderr, "  --starter-bias S             Zipf exponent biasing thread starters (default: 0)\n");
+    fprintf(stderr, "  --vocab-size N               Draw text from N synthetic words (default: built-in list)\n");
+    fprintf(stderr, "  --zipf S                     Zipf exponent for synthetic word frequencies (default: 1.0)\n");
+    fprintf(stderr, "  --corpus FILE                Sample message text from the lines of FILE\n");
+    fprintf(stderr, "  --corpus-sentences           Split the corpus into sentences instead of lines\n");
+    fprintf(stderr, "  --max-memory SIZE            Spill messages to disk beyond SIZE bytes (K/M/G suffixes)\n");
+    fprintf(stderr, "  --fsync                      fsync every exported file before closing it\n");
+    fprintf(stderr, "  --io BACKEND                 auto, uring, threads or sync file writes (default: auto)\n");
+    fprintf(stderr, "  --huge-pages MODE            transparent, explicit or off for large arrays (default: transparent)\n");
+    fprintf(stderr, "  --estimate                   Predict output size, memory and time from a small sample; write nothing\n");
+    fprintf(stderr, "  --target-bytes SIZE          Draw messages until the output is SIZE bytes of JSON (K/M/G/T suffixes; -m is ignored)\n");
+    fprintf(stderr, "  --target-archive             Apply --target-bytes to the ZIP archive instead\n");
+    fprintf(stderr, "  --unpacked                   Write a directory of JSON files instead of a ZIP archive\n");
+    fprintf(stderr, "  --numa                       Pin workers to NUMA nodes and keep their memory local\n");
+    fprintf(stderr, "  --progress SECONDS           Report progress this often, 0 for never (default: 1 on a terminal)\n");
+    fprintf(stderr, "  --trace FILE                 Write per-thread spans as Chrome trace-event JSON to FILE\n");
+    fprintf(stderr, "  --metrics-file FILE          Rewrite FILE with Prometheus metrics every second\n");
+    fprintf(stderr, "  --metrics-port PORT          Serve Prometheus metrics on 127.0.0.1:PORT\n");
+    fprintf(stderr, "Serve options (the Slack Web API on 127.0.0.1, computed page by page):\n");
+    fprintf(stderr, "  --port PORT                  Listen on PORT, 0 for any free port (default: 8080)\n");
+    fprintf(stderr, "  --rate-limit N               Answer ratelimited beyond N requests a minute per method (default: none)\n");
+}
+
+enum {
+    OPT_THREAD_START = 256,
+    OPT_MAX_OPEN_THREADS,
+    OPT_THREAD_SIZE,
+    OPT_MAX_THREAD_SIZE,
+    OPT_REPLY_DELAY,
+    OPT_THREAD_IDLE,
+    OPT_STARTER_BIAS,
+    OPT_VOCAB_SIZE,
+    OPT_ZIPF,
+    OPT_CORPUS,
+    OPT_CORPUS_SENTENCES,
+    OPT_MAX_MEMORY,
+    OPT_HUGE_PAGES,
+    OPT_FSYNC,
+    OPT_IO,
+    OPT_UNPACKED,
+    OPT_NUMA,
+    OPT_PROGRESS,
+    OPT_TRACE,
+    OPT_METRICS_FILE,
+    OPT_METRICS_PORT,
+    OPT_ESTIMATE,
+    OPT_TARGET_BYTES,
+    OPT_TARGET_ARCHIVE,
+    OPT_PORT,
+    OPT_RATE_LIMIT
+};
+
+static const struct option long_options[] = {
+    {"jobs", required_argument, NULL, 'j'},
+    {"seed", required_argument, NULL, 's'},
+    {"thread-start", required_argument, NULL, OPT_THREAD_START},
+    {"max-open-threads", required_argument, NULL, OPT_MAX_OPEN_THREADS},
+    {"thread-size", required_argument, NULL, OPT_THREAD_SIZE},
+    {"max-thread-size", required_argument, NULL, OPT_MAX_THREAD_SIZE},
+    {"reply-delay", required_argument, NULL, OPT_REPLY_DELAY},
+    {"thread-idle", required_argument, NULL, OPT_THREAD_IDLE},
+    {"starter-bias", required_argument, NULL, OPT_STARTER_BIAS},
+    {"vocab-size", required_argument, NULL, OPT_VOCAB_SIZE},
+    {"zipf", required_argument, NULL, OPT_ZIPF},
+    {"corpus", required_argument, NULL, OPT_CORPUS},
+    {"corpus-sentences", no_argument, NULL, OPT_CORPUS_SENTENCES},
+    {"max-memory", required_argument, NULL, OPT_MAX_MEMORY},
+    {"huge-pages", required_argument, NULL, OPT_HUGE_PAGES},
+    {"fsync", no_argument, NULL, OPT_FSYNC},
+    {"io", required_argument, NULL, OPT_IO},
+    {"unpacked", no_argument, NULL, OPT_UNPACKED},
+    {"numa", no_argument, NULL, OPT_NUMA},
+    {"progress", required_argument, NULL, OPT_PROGRESS},
+    {"trace", required_argument, NULL, OPT_TRACE},
+    {"metrics-file", required_argument, NULL, OPT_METRICS_FILE},
+    {"metrics-port", required_argument, NULL, OPT_METRICS_PORT},
+    {"estimate", no_argument, NULL, OPT_ESTIMATE},
+    {"target-bytes", required_argument, NULL, OPT_TARGET_BYTES},
+    {"target-archive", no_argument, NULL, OPT_TARGET_ARCHIVE},
+    {"port", required_argument, NULL, OPT_PORT},
+    {"rate-limit", required_argument, NULL, OPT_RATE_LIMIT},
+    {NULL, 0, NULL, 0}
+};
+
+// Parse "powerlaw:ALPHA" or "lognormal:MU,SIGMA"
+static int parse_thread_size(const char *arg, ConversationModel *model) {
+    if (sscanf(arg, "powerlaw:%lf", &model->size_alpha) == 1) {
+        model->size_dist = THREAD_SIZE_POWERLAW;
+        return model->size_alpha > 1.0 ? 0 : -1;
+    }
+    if (sscanf(arg, "lognormal:%lf,%lf", &model->size_mu, &model->size_sigma) == 2) {
+        model->size_dist = THREAD_SIZE_LOGNORMAL;
+        return model->size_sigma >= 0.0 ? 0 : -1;
+    }
+    return -1;
+}
+
+// Parse "exp:MEAN" or "lognormal:MU,SIGMA"
+static int parse_reply_delay(const char *arg, ConversationModel *model) {
+    if (sscanf(arg, "exp:%lf", &model->delay_mean) == 1) {
+        model->delay_dist = REPLY_DELAY_EXPONENTIAL;
+        return model->delay_mean >= 0.0 ? 0 : -1;
+    }
+    if (sscanf(arg, "lognormal:%lf,%lf", &model->delay_mu, &model->delay_sigma) == 2) {
+        model->delay_dist = REPLY_DELAY_LOGNORMAL;
+        return model->delay_sigma >= 0.0 ? 0 : -1;
+    }
+    return -1;
+}
+
+// Parse a decimal integer with an optional K, M, G or T suffix multiplying
+// it by unit, unit^2, unit^3 or unit^4. Signs, blanks, trailing characters
+// and results above max are rejected.
+static int parse_scaled(const char *arg, uint64_t unit, uint64_t max, uint64_t *out) {
+    if (*arg < '0' || *arg > '9') return -1;
+    char *end;
+    errno = 0;
+    unsigned long long value = strtoull(arg, &end, 10);
+    if (errno == ERANGE) return -1;
+    
+    int power = 0;
+    switch (*end) {
+        case 'K': case 'k': power = 1; break;
+        case 'M': case 'm': power = 2; break;
+        case 'G': case 'g': power = 3; break;
+        case 'T': case 't': power = 4; break;
+        default: break;
+    }
+    if (power > 0) end++;
+    if (*end != '\0') return -1;
+    
+    for (int i = 0; i < power; i++) {
+        if (value > max / unit) return -1;
+        value *= unit;
+    }
+    if (value > max) return -1;
+    *out = value;
+    return 0;
+}
+
+// Entity counts take decimal suffixes: 100M messages is 10^8
+static int parse_count(const char *arg, int64_t *count) {
+    uint64_t value;
+    if (parse_scaled(arg, 1000, INT64_MAX, &value) != 0 || value == 0) return -1;
+    *count = (int64_t)value;
+    return 0;
+}
+
+// Byte sizes take binary suffixes: 64M is 64 MiB
+static int parse_size(const char *arg, size_t *size) {
+    uint64_t value;
+    if (parse_scaled(arg, 1024, SIZE_MAX, &value) != 0 || value == 0) return -1;
+    *size = (size_t)value;
+    return 0;
+}
+
+// Serve until SIGINT or SIGTERM
+static int serve(Syngen *run, int port, int rate_limit) {
+    // Blocked before the server threads start, so only sigwait takes them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    int bound = syngen_serve(run, port, rate_limit);
+    if (bound < 0) {
+        syngen_close(run);
+        return 1;
+    }
+    printf("Serving: http://127.0.0.1:%d/api/ (Ctrl-C to stop)\n", bound);
+    fflush(stdout);
+    int sig;
+    sigwait(&signals, &sig);
+    int64_t requests = syngen_serve_stop(run);
+    syngen_close(run);
+    printf("Stopped after %lld requests\n", (long long)requests);
+    return 0;
 }
 
 int main(int argc, char *argv[]) {
-    int c_count = 25;
-    int m_count = 1000;
-    int u_count = 10;
-    double thread_prob = 0.1;
-    const char *output_filename = NULL;
+    SyngenConfig config;
+    syngen_config_defaults(&config);
+    config.seed = (unsigned long long)time(NULL);
+    config.log = stdout;
+    BigPages huge_pages = BIG_PAGES_TRANSPARENT;
+    bool numa = false;
+    double progress_interval = isatty(STDERR_FILENO) ? 1.0 : 0.0;
+    const char *trace_path = NULL;
+    const char *metrics_path = NULL;
+    int metrics_port = 0;
+    bool estimate = false;
+    bool serving = false;
+    int port = 8080;
+    int rate_limit = 0;
+    bool serve_options = false;
+    
+    // "syngen serve ..." takes the same options, less the output
+    if (argc > 1 && strcmp(argv[1], "serve") == 0) {
+        serving = true;
+        argv[1] = argv[0];
+        argv++;
+        argc--;
+    }
+    
+    ConversationModel *model = &config.model;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    model->workers = cpus > 0 ? (int)cpus : 1;
     
     int opt;
-    while ((opt = getopt(argc, argv, "c:m:u:t:")) != -1) {
+    while ((opt = getopt_long(argc, argv, "c:m:u:t:j:s:", long_options, NULL)) != -1) {
         switch (opt) {
             case 'c':
-                c_count = atoi(optarg);
+                if (parse_count(optarg, &config.channels) != 0) {
+                    fprintf(stderr, "Error: Invalid channel count '%s'\n", optarg);
+                    return 1;
+                }
                 break;
             case 'm':
-                m_count = atoi(optarg);
+                if (parse_count(optarg, &config.messages) != 0) {
+                    fprintf(stderr, "Error: Invalid message count '%s'\n", optarg);
+                    return 1;
+                }
                 break;
             case 'u':
-                u_count = atoi(optarg);
+                if (parse_count(optarg, &config.users) != 0) {
+                    fprintf(stderr, "Error: Invalid user count '%s'\n", optarg);
+                    return 1;
+                }
                 break;
             case 't':
-                thread_prob = atof(optarg);
-                if (thread_prob < 0.0 || thread_prob > 1.0) {
+                model->reply_prob = atof(optarg);
+                if (model->reply_prob < 0.0 || model->reply_prob > 1.0) {
                     fprintf(stderr, "Error: Thread probability must be between 0.0 and 1.0\n");
                     return 1;
                 }
                 break;
+            case 'j':
+                model->workers = atoi(optarg);
+                if (model->workers <= 0) {
+                    fprintf(stderr, "Error: Jobs must be a positive integer\n");
+                    return 1;
+                }
+                break;
+            case 's':
+                config.seed = strtoull(optarg, NULL, 0);
+                break;
+            case OPT_THREAD_START:
+                model->start_prob = atof(optarg);
+                if (model->start_prob < 0.0 || model->start_prob > 1.0) {
+                    fprintf(stderr, "Error: Thread start probability must be between 0.0 and 1.0\n");
+                    return 1;
+                }
+                break;
+            case OPT_MAX_OPEN_THREADS:
+                model->max_open_threads = atoi(optarg);
+                if (model->max_open_threads < 0) {
+                    fprintf(stderr, "Error: Max open threads must not be negative\n");
+                    return 1;
+                }
+                break;
+            case OPT_THREAD_SIZE:
+                if (parse_thread_size(optarg, model) != 0) {
+                    fprintf(stderr, "Error: Invalid thread size distribution '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case OPT_MAX_THREAD_SIZE:
+                model->max_thread_size = atoi(optarg);
+                if (model->max_thread_size <= 0) {
+                    fprintf(stderr, "Error: Max thread size must be a positive integer\n");
+                    return 1;
+                }
+                break;
+            case OPT_REPLY_DELAY:
+                if (parse_reply_delay(optarg, model) != 0) {
+                    fprintf(stderr, "Error: Invalid reply delay distribution '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case OPT_THREAD_IDLE:
+                model->max_idle = atof(optarg);
+                if (model->max_idle <= 0.0) {
+                    fprintf(stderr, "Error: Thread idle window must be positive\n");
+                    return 1;
+                }
+                break;
+            case OPT_STARTER_BIAS:
+                model->starter_bias = atof(optarg);
+                if (model->starter_bias < 0.0) {
+                    fprintf(stderr, "Error: Starter bias must not be negative\n");
+                    return 1;
+                }
+                break;
+            case OPT_VOCAB_SIZE:
+                config.vocab_size = atoll(optarg);
+                if (config.vocab_size <= 0 || config.vocab_size > VOCAB_MAX_SIZE) {
+                    fprintf(stderr, "Error: Vocabulary size must be between 1 and %lld\n", VOCAB_MAX_SIZE);
+                    return 1;
+                }
+                break;
+            case OPT_ZIPF:
+                config.zipf = atof(optarg);
+                if (config.zipf <= 0.0) {
+                    fprintf(stderr, "Error: Zipf exponent must be positive\n");
+                    return 1;
+                }
+                break;
+            case OPT_CORPUS:
+                config.corpus_path = optarg;
+                break;
+            case OPT_CORPUS_SENTENCES:
+                config.corpus_unit = CORPUS_SENTENCES;
+                break;
+            case OPT_MAX_MEMORY:
+                if (parse_size(optarg, &config.max_memory) != 0) {
+                    fprintf(stderr, "Error: Invalid memory size '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case OPT_HUGE_PAGES:
+                if (big_pages_parse(optarg, &huge_pages) != 0) {
+                    fprintf(stderr, "Error: Huge pages mode must be transparent, explicit or off\n");
+                    return 1;
+                }
+                break;
+            case OPT_FSYNC:
+                config.sync = true;
+                break;
+            case OPT_IO:
+                if (export_io_backend_parse(optarg, &config.io) != 0) {
+                    fprintf(stderr, "Error: I/O backend must be auto, uring, threads or sync\n");
+                    return 1;
+                }
+                break;
+            case OPT_UNPACKED:
+                config.unpacked = true;
+                break;
+            case OPT_NUMA:
+                numa = true;
+                break;
+            case OPT_PROGRESS:
+                progress_interval = atof(optarg);
+                if (progress_interval < 0.0) {
+                    fprintf(stderr, "Error: Progress interval must not be negative\n");
+                    return 1;
+                }
+                break;
+            case OPT_TRACE:
+                trace_path = optarg;
+                break;
+            case OPT_ESTIMATE:
+                estimate = true;
+                break;
+            case OPT_TARGET_BYTES:
+                if (parse_size(optarg, &config.target_bytes) != 0) {
+                    fprintf(stderr, "Error: Invalid target size '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case OPT_TARGET_ARCHIVE:
+                config.target_archive = true;
+                break;
+            case OPT_METRICS_FILE:
+                metrics_path = optarg;
+                break;
+            case OPT_METRICS_PORT:
+                metrics_port = atoi(optarg);
+                if (metrics_port <= 0 || metrics_port > 65535) {
+                    fprintf(stderr, "Error: Metrics port must be between 1 and 65535\n");
+                    return 1;
+                }
+                break;
+            case OPT_PORT:
+                serve_options = true;
+                port = atoi(optarg);
+                if (port < 0 || port > 65535) {
+                    fprintf(stderr, "Error: Port must be between 0 and 65535\n");
+                    return 1;
+                }
+                break;
+            case OPT_RATE_LIMIT:
+                serve_options = true;
+                rate_limit = atoi(optarg);
+                if (rate_limit <= 0) {
+                    fprintf(stderr, "Error: Rate limit must be a positive integer\n");
+                    return 1;
+                }
+                break;
             default:
                 print_usage(argv[0]);
                 return 1;
         }
     }
     
+    if (serve_options && !serving) {
+        fprintf(stderr, "Error: --port and --rate-limit apply to serve\n");
+        return 1;
+    }
+    if (serving && (optind < argc || estimate || config.target_bytes > 0)) {
+        fprintf(stderr, "Error: serve takes no output filename, --estimate or --target-bytes\n");
+        return 1;
+    }
     if (optind < argc) {
-        output_filename = argv[optind];
-    } else {
+        config.output = argv[optind];
+    } else if (!estimate && !serving) {
         fprintf(stderr, "Error: Missing output filename.\n");
         print_usage(argv[0]);
         return 1;
     }
-    
-    if (c_count <= 0 || m_count <= 0 || u_count <= 0) {
-        fprintf(stderr, "Error: Counts must be positive integers.\n");
+    if (config.target_archive && (config.target_bytes == 0 || config.unpacked)) {
+        fprintf(stderr, "Error: --target-archive needs --target-bytes and a ZIP output\n");
         return 1;
     }
+
+    // Mappings that do not fit in memory fall back to files next to the spill runs
+    big_alloc_configure(huge_pages, config.spill_dir);
+    int numa_nodes = numa ? numa_init() : 0;
     
     printf("Syngen - Synthetic Slack Export Generator\n");
     printf("Configuration:\n");
-    printf("  Users:    %d\n", u_count);
-    printf("  Channels: %d\n", c_count);
-    printf("  Messages: %d\n", m_count);
-    printf("  Output:   %s\n", output_filename);
-    
-    faker_init();
+    printf("  Users:    %lld\n", (long long)config.users);
+    printf("  Channels: %lld\n", (long long)config.channels);
+    if (config.target_bytes > 0) {
+        printf("  Target:   %zu bytes (%s)\n", config.target_bytes, config.target_archive ? "archive" : "uncompressed");
+    } else {
+        printf("  Messages: %lld\n", (long long)config.messages);
+    }
+    printf("  Jobs:     %d\n", model->workers);
+    if (numa) {
+        printf("  NUMA:     %d node%s\n", numa_nodes, numa_nodes == 1 ? "" : "s");
+    }
+    if (config.output) {
+        printf("  Output:   %s\n", config.output);
+    }
+    if (metrics_port) {
+        printf("  Metrics:  http://127.0.0.1:%d/metrics\n", metrics_port);
+    }
+    printf("  Seed:     %llu\n", config.seed);
     
-    // Create temporary directory for generation
-    char temp_dir[64];
-    snprintf(temp_dir, sizeof(temp_dir), "syngen_temp_%d", getpid());
+    Syngen *run = syngen_open(&config);
+    if (!run) {
+        return 1;
+    }
+    if (estimate) {
+        syngen_estimate(run, stdout);
+        syngen_close(run);
+        return 0;
+    }
+    if (serving) {
+        return serve(run, port, rate_limit);
+    }
     
     printf("Generating data...\n");
-    User *users = generate_users(u_count);
-    Channel *channels = generate_channels(c_count, users, u_count);
-    Message *messages = generate_messages(m_count, channels, c_count, users, u_count, thread_prob);
-    
-    printf("Exporting data to %s...\n", temp_dir);
-    export_init(temp_dir);
-    export_write_users(temp_dir, users, u_count);
-    export_write_channels(temp_dir, channels, c_count);
-    export_write_messages(temp_dir, messages, m_count, channels, c_count);
-    
-    export_finalize(temp_dir, output_filename);
-    
-    // Cleanup temporary directory
-    printf("Cleaning up...\n");
-    char cmd[128];
-    snprintf(cmd, sizeof(cmd), "rm -rf %s", temp_dir);
-    system(cmd);
-    
-    free_messages(messages, m_count);
-    free_channels(channels, c_count);
-    free_users(users, u_count);
+    fflush(stdout);
+    if (trace_path && trace_open(trace_path) != 0) {
+        return 1;
+    }
+    // Before any worker thread, which must inherit the blocked SIGUSR1
+    progress_start(progress_interval);
+    if (metrics_start(metrics_path, metrics_port) != 0) {
+        return 1;
+    }
+    if (syngen_run(run, NULL) != 0) {
+        return 1;
+    }
+    if (config.target_bytes > 0) {
+        uint64_t reached = syngen_reached(run);
+        progress_clear();
+        printf("  Output:   %llu bytes (%+.2f%% of the target)\n", (unsigned long long)reached,
+               100.0 * ((double)reached - (double)config.target_bytes) / (double)config.target_bytes);
+    }
+    syngen_close(run);
     
+    progress_stop();
+    metrics_stop();
+    trace_close();
     printf("Success!\n");
 
     return 0;
@@ -0,0 +1,301 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "metrics.h"
+#include "progress.h"
+#include "arena.h"
+
+#define METRICS_FILE_INTERVAL_NS 1000000000LL
+// The thread checks for scrapes and for stopping this often (milliseconds)
+#define METRICS_POLL_MS 100
+#define METRICS_MAX_GAUGES 128
+#define METRICS_MAX_BUCKETS 16
+
+typedef struct {
+    char name[48];
+    char labels[64];
+    MetricsGaugeFn read;
+    void *ctx;
+} Gauge;
+
+typedef struct {
+    const char *name;
+    const char *help;
+    double unit;                // Raw values per reported unit, e.g. 1e9 ns per second
+    int bucket_count;
+    int64_t bounds[METRICS_MAX_BUCKETS];
+    int64_t buckets[METRICS_MAX_BUCKETS + 1];   // Last one is +Inf
+    int64_t sum;
+} Histogram;
+
+// Counters in ProgressCounter order
+static const struct {
+    const char *name;
+    const char *help;
+} counters[PROGRESS_COUNTERS] = {
+    {"syngen_users_generated_total", "Users generated."},
+    {"syngen_channels_generated_total", "Channels generated."},
+    {"syngen_messages_generated_total", "Messages drawn."},
+    {"syngen_messages_threaded_total", "Messages through the threading pass."},
+    {"syngen_messages_text_total", "Message texts written."},
+    {"syngen_messages_exported_total", "Messages serialised into the output."},
+    {"syngen_bytes_written_total", "Bytes written to output files."},
+    {"syngen_files_written_total", "Output files or archive members completed."},
+};
+
+static Histogram histograms[METRICS_HISTOGRAMS] = {
+    {"syngen_file_bytes", "Uncompressed size of each exported file.", 1, 10,
+     {1 << 10, 4 << 10, 16 << 10, 64 << 10, 256 << 10, 1 << 20, 4 << 20, 16 << 20, 64 << 20, 256 << 20},
+     {0}, 0},
+    {"syngen_serialise_seconds", "Time to serialise one piece of a file.", 1e9, 12,
+     {100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000, 25000000, 50000000,
+      100000000, 250000000, 1000000000},
+     {0}, 0},
+};
+
+static Gauge gauges[METRICS_MAX_GAUGES];
+static int gauge_count = 0;
+static pthread_mutex_t gauge_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool metrics_on = false;
+static int stopping = 0;
+static pthread_t metrics_thread;
+static const char *metrics_path = NULL;
+static char *metrics_temp = NULL;
+static int listen_fd = -1;
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int64_t metrics_clock(void) {
+    return metrics_on && !progress_paused() ? now_ns() : 0;
+}
+
+void metrics_observe(MetricsHistogram which, int64_t value) {
+    if (!metrics_on || progress_paused()) return;
+    Histogram *h = &histograms[which];
+    int b = 0;
+    while (b < h->bucket_count && value > h->bounds[b]) b++;
+    __atomic_add_fetch(&h->buckets[b], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&h->sum, value, __ATOMIC_RELAXED);
+}
+
+void metrics_gauge_add(const char *name, const char *labels, MetricsGaugeFn read, void *ctx) {
+    if (!metrics_on) return;
+    pthread_mutex_lock(&gauge_lock);
+    if (gauge_count < METRICS_MAX_GAUGES) {
+        Gauge *g = &gauges[gauge_count++];
+        snprintf(g->name, sizeof(g->name), "%s", name);
+        snprintf(g->labels, sizeof(g->labels), "%s", labels);
+        g->read = read;
+        g->ctx = ctx;
+    }
+    pthread_mutex_unlock(&gauge_lock);
+}
+
+void metrics_gauge_remove(const void *ctx) {
+    if (!metrics_on) return;
+    pthread_mutex_lock(&gauge_lock);
+    int kept = 0;
+    for (int i = 0; i < gauge_count; i++) {
+        if (gauges[i].ctx != ctx) gauges[kept++] = gauges[i];
+    }
+    gauge_count = kept;
+    pthread_mutex_unlock(&gauge_lock);
+}
+
+// --- Rendering ---
+
+static void render(FILE *out) {
+    int64_t totals[PROGRESS_COUNTERS];
+    progress_totals(totals);
+    for (int c = 0; c < PROGRESS_COUNTERS; c++) {
+        fprintf(out, "# HELP %s %s\n# TYPE %s counter\n%s %lld\n",
+                counters[c].name, counters[c].help, counters[c].name, counters[c].name, (long long)totals[c]);
+    }
+
+    ProgressPhase current = progress_current_phase();
+    fputs("# HELP syngen_phase Phase the run is in (1) or not (0).\n# TYPE syngen_phase gauge\n", out);
+    for (int p = 0; p < PROGRESS_PHASES; p++) {
+        fprintf(out, "syngen_phase{phase=\"%s\"} %d\n", progress_phase_name((ProgressPhase)p), p == (int)current);
+    }
+    fprintf(out, "# HELP syngen_resident_bytes Resident set size.\n# TYPE syngen_resident_bytes gauge\n"
+            "syngen_resident_bytes %lld\n", (long long)progress_resident_bytes());
+    fprintf(out, "# HELP syngen_arena_bytes Chunk capacity held by the text arenas.\n# TYPE syngen_arena_bytes gauge\n"
+            "syngen_arena_bytes %zu\n", text_arena_total_bytes());
+
+    // Registered gauges, one TYPE line per name
+    pthread_mutex_lock(&gauge_lock);
+    for (int i = 0; i < gauge_count; i++) {
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++) seen = strcmp(gauges[j].name, gauges[i].name) == 0;
+        if (!seen) fprintf(out, "# TYPE %s gauge\n", gauges[i].name);
+    }
+    for (int i = 0; i < gauge_count; i++) {
+        const Gauge *g = &gauges[i];
+        fprintf(out, g->labels[0] ? "%s{%s} %lld\n" : "%s%s %lld\n", g->name, g->labels, (long long)g->read(g->ctx));
+    }
+    pthread_mutex_unlock(&gauge_lock);
+
+    for (int k = 0; k < METRICS_HISTOGRAMS; k++) {
+        const Histogram *h = &histograms[k];
+        fprintf(out, "# HELP %s %s\n# TYPE %s histogram\n", h->name, h->help, h->name);
+        int64_t cumulative = 0;
+        for (int b = 0; b <= h->bucket_count; b++) {
+            cumulative += __atomic_load_n(&h->buckets[b], __ATOMIC_RELAXED);
+            if (b < h->bucket_count) {
+                fprintf(out, "%s_bucket{le=\"%.15g\"} %lld\n", h->name, (double)h->bounds[b] / h->unit, (long long)cumulative);
+            } else {
+                fprintf(out, "%s_bucket{le=\"+Inf\"} %lld\n", h->name, (long long)cumulative);
+            }
+        }
+        fprintf(out, "%s_sum %.15g\n%s_count %lld\n", h->name,
+                (double)__atomic_load_n(&h->sum, __ATOMIC_RELAXED) / h->unit, h->name, (long long)cumulative);
+    }
+}
+
+static int write_file(void) {
+    FILE *f = fopen(metrics_temp, "w");
+    if (!f) {
+        perror(metrics_temp);
+        return -1;
+    }
+    render(f);
+    if (fclose(f) != 0 || rename(metrics_temp, metrics_path) != 0) {
+        perror(metrics_path);
+        return -1;
+    }
+    return 0;
+}
+
+static void send_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+// Answer one scrape. Anything but GET /metrics (or /) gets a 404.
+static void serve_client(int fd) {
+    char request[1024];
+    struct pollfd pfd = {fd, POLLIN, 0};
+    ssize_t n = poll(&pfd, 1, 1000) == 1 ? recv(fd, request, sizeof(request) - 1, 0) : -1;
+    if (n <= 0) return;
+    request[n] = '\0';
+
+    bool found = strncmp(request, "GET /metrics ", 13) == 0 || strncmp(request, "GET / ", 6) == 0;
+    char *body = NULL;
+    size_t body_len = 0;
+    FILE *out = open_memstream(&body, &body_len);
+    if (!out) return;
+    if (found) {
+        render(out);
+    } else {
+        fputs("Not found\n", out);
+    }
+    fclose(out);
+
+    char header[160];
+    int header_len = snprintf(header, sizeof(header),
+                              "HTTP/1.1 %s\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                              "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+                              found ? "200 OK" : "404 Not Found", body_len);
+    send_all(fd, header, (size_t)header_len);
+    send_all(fd, body, body_len);
+    free(body);
+}
+
+static void *metrics_main(void *arg) {
+    (void)arg;
+    int64_t next_write = now_ns() + METRICS_FILE_INTERVAL_NS;
+    while (!__atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) {
+        if (listen_fd >= 0) {
+            struct pollfd pfd = {listen_fd, POLLIN, 0};
+            if (poll(&pfd, 1, METRICS_POLL_MS) == 1) {
+                int fd = accept(listen_fd, NULL, NULL);
+                if (fd >= 0) {
+                    serve_client(fd);
+                    close(fd);
+                }
+            }
+        } else {
+            struct timespec tick = {0, METRICS_POLL_MS * 1000000L};
+            nanosleep(&tick, NULL);
+        }
+        if (metrics_path && now_ns() >= next_write) {
+            write_file();
+            next_write += METRICS_FILE_INTERVAL_NS;
+        }
+    }
+    return NULL;
+}
+
+static int listen_local(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 8) != 0) {
+        fprintf(stderr, "Error: Cannot serve metrics on port %d: %s\n", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int metrics_start(const char *path, int port) {
+    if (!path && port == 0) return 0;
+    if (path) {
+        size_t len = strlen(path) + 5;
+        metrics_temp = malloc(len);
+        if (!metrics_temp) return -1;
+        snprintf(metrics_temp, len, "%s.tmp", path);
+        metrics_path = path;
+    }
+    if (port != 0 && (listen_fd = listen_local(port)) < 0) return -1;
+    metrics_on = true;
+    if (path && write_file() != 0) return -1;
+    if (pthread_create(&metrics_thread, NULL, metrics_main, NULL) != 0) {
+        fprintf(stderr, "Error: Cannot start metrics thread\n");
+        return -1;
+    }
+    return 0;
+}
+
+void metrics_stop(void) {
+    if (!metrics_on) return;
+    __atomic_store_n(&stopping, 1, __ATOMIC_RELEASE);
+    pthread_join(metrics_thread, NULL);
+    if (metrics_path) write_file();
+    if (listen_fd >= 0) close(listen_fd);
+    listen_fd = -1;
+    free(metrics_temp);
+    metrics_temp = NULL;
+    metrics_on = false;
+}
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "name_set.h"
+
+#define NAME_SET_DEFAULT_CAPACITY 1024
+
+// FNV-1a, forced non-zero so 0 can mark empty slots
+static uint64_t name_hash(const char *s, size_t *len) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    const char *p = s;
+    for (; *p; p++) {
+        h ^= (unsigned char)*p;
+        h *= 0x100000001b3ULL;
+    }
+    *len = (size_t)(p - s);
+    return h ? h : 1;
+}
+
+static void name_set_alloc(NameSet *set, size_t capacity) {
+    set->slots = calloc(capacity, sizeof(NameSlot));
+    if (!set->slots) {
+        fprintf(stderr, "Failed to allocate name set\n");
+        exit(1);
+    }
+    set->capacity = capacity;
+    set->used = 0;
+}
+
+void name_set_init(NameSet *set, size_t expected) {
+    size_t capacity = NAME_SET_DEFAULT_CAPACITY;
+    while (capacity / 2 < expected) capacity *= 2;
+    name_set_alloc(set, capacity);
+}
+
+static void name_set_grow(NameSet *set) {
+    NameSlot *old = set->slots;
+    size_t old_capacity = set->capacity;
+    name_set_alloc(set, old_capacity * 2);
+
+    size_t mask = set->capacity - 1;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!old[i].hash) continue;
+        size_t pos = (size_t)old[i].hash & mask;
+        while (set->slots[pos].hash) pos = (pos + 1) & mask;
+        set->slots[pos] = old[i];
+        set->used++;
+    }
+    free(old);
+}
+
+uint32_t name_set_claim(NameSet *set, char *buf, size_t buf_size) {
+    // Keep the load factor at or below 1/2 so probe runs stay short
+    if (set->used + 1 > set->capacity / 2) name_set_grow(set);
+
+    size_t len;
+    uint64_t h = name_hash(buf, &len);
+    size_t mask = set->capacity - 1;
+    size_t pos = (size_t)h & mask;
+
+    // Full strings are only compared when the 64-bit hashes already match
+    while (set->slots[pos].hash) {
+        NameSlot *slot = &set->slots[pos];
+        if (slot->hash == h && strcmp(slot->name, buf) == 0) {
+            slot->count++;
+            snprintf(buf + len, buf_size - len, "%u", (unsigned)slot->count);
+            return slot->count;
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    set->slots[pos].hash = h;
+    set->slots[pos].name = buf;
+    set->slots[pos].count = 1;
+    set->used++;
+    return 1;
+}
+
+void name_set_free(NameSet *set) {
+    free(set->slots);
+    set->slots = NULL;
+    set->capacity = 0;
+    set->used = 0;
+}
@@ -0,0 +1,121 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "numa.h"
+
+#define NUMA_SYSFS "/sys/devices/system/node"
+
+// Memory policies from <linux/mempolicy.h>
+#define NUMA_MPOL_PREFERRED 1
+#define NUMA_MPOL_INTERLEAVE 3
+
+typedef struct {
+    int id;                 // Kernel node number
+    cpu_set_t cpus;         // Allowed CPUs on the node
+} NumaNode;
+
+static NumaNode numa_nodes[NUMA_MAX_NODES];
+static int numa_count = 1;
+static bool numa_active = false;
+static cpu_set_t numa_allowed;
+
+// Parse a sysfs CPU or node list such as "0-3,8,10-11" into set
+static int parse_list(const char *list, cpu_set_t *set) {
+    CPU_ZERO(set);
+    const char *p = list;
+    while (*p && *p != '\n') {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0) return -1;
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first) return -1;
+        }
+        for (long c = first; c <= last && c < CPU_SETSIZE; c++) {
+            CPU_SET((size_t)c, set);
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+    return 0;
+}
+
+static int read_list(const char *path, cpu_set_t *set) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char line[4096];
+    int rc = fgets(line, sizeof(line), f) ? parse_list(line, set) : -1;
+    fclose(f);
+    return rc;
+}
+
+int numa_init(void) {
+    if (sched_getaffinity(0, sizeof(numa_allowed), &numa_allowed) != 0) return numa_count;
+    cpu_set_t online;
+    if (read_list(NUMA_SYSFS "/online", &online) != 0) return numa_count;
+
+    int count = 0;
+    for (int id = 0; id < NUMA_MAX_NODES; id++) {
+        if (!CPU_ISSET((size_t)id, &online)) continue;
+        char path[128];
+        snprintf(path, sizeof(path), NUMA_SYSFS "/node%d/cpulist", id);
+        NumaNode *node = &numa_nodes[count];
+        if (read_list(path, &node->cpus) != 0) continue;
+        CPU_AND(&node->cpus, &node->cpus, &numa_allowed);
+        // Memory-only nodes and nodes outside our CPU binding run no workers
+        if (CPU_COUNT(&node->cpus) == 0) continue;
+        node->id = id;
+        count++;
+    }
+    if (count > 0) {
+        numa_count = count;
+        numa_active = true;
+    }
+    return numa_count;
+}
+
+int numa_node_count(void) {
+    return numa_count;
+}
+
+int numa_worker_node(int worker) {
+    return worker % numa_count;
+}
+
+int numa_owner(int64_t item) {
+    return (int)(item % numa_count);
+}
+
+void numa_pin_worker(int worker) {
+    if (!numa_active) return;
+    sched_setaffinity(0, sizeof(cpu_set_t), &numa_nodes[numa_worker_node(worker)].cpus);
+}
+
+void numa_unpin(void) {
+    if (!numa_active) return;
+    sched_setaffinity(0, sizeof(cpu_set_t), &numa_allowed);
+}
+
+void numa_place(void *addr, size_t len, int node) {
+    if (!numa_active || len == 0) return;
+    // The kernel reads maxnode - 1 bits; two words leave room for that
+    unsigned long mask[2] = {0, 0};
+    int mode;
+    if (node >= 0) {
+        mode = NUMA_MPOL_PREFERRED;
+        mask[0] = 1ul << numa_nodes[node % numa_count].id;
+    } else {
+        // One node has nothing to interleave over
+        if (numa_count == 1) return;
+        mode = NUMA_MPOL_INTERLEAVE;
+        for (int n = 0; n < numa_count; n++) {
+            mask[0] |= 1ul << numa_nodes[n].id;
+        }
+    }
+    syscall(SYS_mbind, addr, len, mode, mask, (unsigned long)NUMA_MAX_NODES + 1, 0u);
+}
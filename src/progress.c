@@ -0,0 +1,298 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "progress.h"
+#include "trace.h"
+
+// Threads beyond this share the last line, still correctly but contended
+#define PROGRESS_LINES 256
+// The reporter checks for SIGUSR1 and for stopping this often
+#define PROGRESS_TICK_NS (100 * 1000 * 1000)
+
+typedef struct {
+    int64_t count[PROGRESS_COUNTERS];
+    char pad[64 - (PROGRESS_COUNTERS * sizeof(int64_t)) % 64];
+} ProgressLine;
+
+static const char *const counter_names[PROGRESS_COUNTERS] = {
+    "users", "channels", "generated", "threaded", "text", "exported", "bytes", "files"
+};
+
+static const char *const phase_names[PROGRESS_PHASES] = {
+    "setup", "generate", "sort", "thread", "text", "export"
+};
+
+// Counter whose progress a phase reports, or -1 if it has none
+static const int phase_counters[PROGRESS_PHASES] = {
+    -1, PROGRESS_GENERATED, -1, PROGRESS_THREADED, PROGRESS_TEXT, PROGRESS_EXPORTED
+};
+
+static ProgressLine lines[PROGRESS_LINES];
+static int lines_used = 0;
+static __thread int my_line = -1;
+
+static int paused = 0;                   // Depth of progress_pause calls
+static int current_phase = PROGRESS_PHASE_SETUP;
+static int64_t phase_start_ns[PROGRESS_PHASES];
+static int64_t phase_end_ns[PROGRESS_PHASES];
+static int64_t phase_total[PROGRESS_PHASES];
+static int64_t phase_trace_begin = 0;    // Phases are spans on the main thread's track
+
+static pthread_t reporter;
+static bool reporter_running = false;
+static int stopping = 0;
+static double report_interval = 0;
+static bool on_tty = false;
+static int64_t start_ns = 0;
+// Serialises terminal output between the reporter and progress_clear
+static pthread_mutex_t tty_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool line_drawn = false;
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void progress_pause(void) {
+    __atomic_add_fetch(&paused, 1, __ATOMIC_RELEASE);
+}
+
+void progress_resume(void) {
+    __atomic_sub_fetch(&paused, 1, __ATOMIC_RELEASE);
+}
+
+bool progress_paused(void) {
+    return __atomic_load_n(&paused, __ATOMIC_ACQUIRE) > 0;
+}
+
+void progress_add(ProgressCounter counter, int64_t n) {
+    if (progress_paused()) return;
+    if (my_line < 0) {
+        int line = __atomic_fetch_add(&lines_used, 1, __ATOMIC_RELAXED);
+        my_line = line < PROGRESS_LINES ? line : PROGRESS_LINES - 1;
+    }
+    __atomic_fetch_add(&lines[my_line].count[counter], n, __ATOMIC_RELAXED);
+}
+
+void progress_totals(int64_t *out) {
+    memset(out, 0, sizeof(int64_t) * PROGRESS_COUNTERS);
+    int used = __atomic_load_n(&lines_used, __ATOMIC_RELAXED);
+    if (used > PROGRESS_LINES) used = PROGRESS_LINES;
+    for (int l = 0; l < used; l++) {
+        for (int c = 0; c < PROGRESS_COUNTERS; c++) {
+            out[c] += __atomic_load_n(&lines[l].count[c], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void progress_phase(ProgressPhase phase, int64_t total) {
+    if (progress_paused()) return;
+    int64_t now = now_ns();
+    int previous = __atomic_load_n(&current_phase, __ATOMIC_RELAXED);
+    int64_t begun = __atomic_exchange_n(&phase_trace_begin, trace_clock(), __ATOMIC_RELAXED);
+    trace_span(phase_names[previous], begun, NULL);
+    __atomic_store_n(&phase_end_ns[previous], now, __ATOMIC_RELAXED);
+    __atomic_store_n(&phase_total[phase], total, __ATOMIC_RELAXED);
+    __atomic_store_n(&phase_start_ns[phase], now, __ATOMIC_RELAXED);
+    __atomic_store_n(&phase_end_ns[phase], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&current_phase, (int)phase, __ATOMIC_RELEASE);
+}
+
+// --- Reporting ---
+
+// Scale v to at most four significant characters with a k/M/G/T suffix
+static void format_count(char *buf, size_t size, double v, double unit, const char *const *suffixes) {
+    int s = 0;
+    while (v >= unit && suffixes[s + 1]) {
+        v /= unit;
+        s++;
+    }
+    snprintf(buf, size, s == 0 ? "%.0f%s" : "%.1f%s", v, suffixes[s]);
+}
+
+static void format_duration(char *buf, size_t size, double seconds) {
+    long s = (long)seconds;
+    if (s >= 3600) {
+        snprintf(buf, size, "%ldh%02ldm", s / 3600, s / 60 % 60);
+    } else {
+        snprintf(buf, size, "%ldm%02lds", s / 60, s % 60);
+    }
+}
+
+ProgressPhase progress_current_phase(void) {
+    return (ProgressPhase)__atomic_load_n(&current_phase, __ATOMIC_ACQUIRE);
+}
+
+const char *progress_phase_name(ProgressPhase phase) {
+    return phase_names[phase];
+}
+
+int64_t progress_resident_bytes(void) {
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return -1;
+    long long size, resident;
+    int n = fscanf(f, "%lld %lld", &size, &resident);
+    fclose(f);
+    return n == 2 ? resident * (int64_t)sysconf(_SC_PAGESIZE) : -1;
+}
+
+typedef struct {
+    int64_t last_ns;            // Previous report
+    int64_t last_done;          // Phase units done at the previous report
+    int last_phase;
+} ReportState;
+
+static void report_status(ReportState *rs, bool final) {
+    static const char *const units[] = {"", "k", "M", "G", "T", NULL};
+    static const char *const bytes_units[] = {"B", "KiB", "MiB", "GiB", "TiB", NULL};
+    int64_t counts[PROGRESS_COUNTERS];
+    progress_totals(counts);
+    int phase = __atomic_load_n(&current_phase, __ATOMIC_ACQUIRE);
+    int64_t now = now_ns();
+    int counter = phase_counters[phase];
+    int64_t done = counter >= 0 ? counts[counter] : 0;
+    int64_t total = __atomic_load_n(&phase_total[phase], __ATOMIC_RELAXED);
+    if (phase != rs->last_phase) {
+        rs->last_done = 0;
+        rs->last_ns = __atomic_load_n(&phase_start_ns[phase], __ATOMIC_RELAXED);
+        rs->last_phase = phase;
+    }
+    double span = (double)(now - rs->last_ns) / 1e9;
+    double rate = span > 0 ? (double)(done - rs->last_done) / span : 0;
+    // The ETA uses the phase's average rate, which is steadier
+    double phase_elapsed = (double)(now - __atomic_load_n(&phase_start_ns[phase], __ATOMIC_RELAXED)) / 1e9;
+    double eta = counter >= 0 && done > 0 && total > done ? (double)(total - done) * phase_elapsed / (double)done : -1;
+    rs->last_ns = now;
+    rs->last_done = done;
+    double elapsed = (double)(now - start_ns) / 1e9;
+
+    if (on_tty) {
+        pthread_mutex_lock(&tty_lock);
+        char done_str[16], total_str[16], rate_str[16], bytes_str[16], files_str[16], eta_str[16];
+        format_count(done_str, sizeof(done_str), (double)done, 1000, units);
+        format_count(total_str, sizeof(total_str), (double)total, 1000, units);
+        format_count(rate_str, sizeof(rate_str), rate, 1000, units);
+        format_count(bytes_str, sizeof(bytes_str), (double)counts[PROGRESS_BYTES], 1024, bytes_units);
+        format_count(files_str, sizeof(files_str), (double)counts[PROGRESS_FILES], 1000, units);
+        if (eta >= 0) {
+            format_duration(eta_str, sizeof(eta_str), eta);
+        } else {
+            snprintf(eta_str, sizeof(eta_str), "--");
+        }
+        if (counter >= 0) {
+            fprintf(stderr, "\r\033[K[%s] %s/%s msgs  %s msg/s  %s written  %s files  ETA %s",
+                    phase_names[phase], done_str, total_str, rate_str, bytes_str, files_str, eta_str);
+        } else {
+            fprintf(stderr, "\r\033[K[%s] %s written  %s files", phase_names[phase], bytes_str, files_str);
+        }
+        if (final) fputc('\n', stderr);
+        line_drawn = !final;
+        fflush(stderr);
+        pthread_mutex_unlock(&tty_lock);
+    } else {
+        fprintf(stderr, "{\"event\":\"%s\",\"elapsed\":%.3f,\"phase\":\"%s\",\"done\":%lld,\"total\":%lld,"
+                "\"rate\":%.1f,\"bytes\":%lld,\"files\":%lld,\"eta\":",
+                final ? "done" : "progress", elapsed, phase_names[phase], (long long)done, (long long)total,
+                rate, (long long)counts[PROGRESS_BYTES], (long long)counts[PROGRESS_FILES]);
+        if (eta >= 0) {
+            fprintf(stderr, "%.1f}\n", eta);
+        } else {
+            fprintf(stderr, "null}\n");
+        }
+        fflush(stderr);
+    }
+}
+
+// Every counter and phase timing as one JSON line
+static void report_snapshot(void) {
+    int64_t counts[PROGRESS_COUNTERS];
+    progress_totals(counts);
+    int phase = __atomic_load_n(&current_phase, __ATOMIC_ACQUIRE);
+    int64_t now = now_ns();
+
+    pthread_mutex_lock(&tty_lock);
+    if (line_drawn) fputs("\r\033[K", stderr);
+    line_drawn = false;
+    fprintf(stderr, "{\"event\":\"snapshot\",\"elapsed\":%.3f,\"phase\":\"%s\",\"counters\":{",
+            (double)(now - start_ns) / 1e9, phase_names[phase]);
+    for (int c = 0; c < PROGRESS_COUNTERS; c++) {
+        fprintf(stderr, "%s\"%s\":%lld", c ? "," : "", counter_names[c], (long long)counts[c]);
+    }
+    fputs("},\"phases\":{", stderr);
+    bool first = true;
+    for (int p = 0; p <= phase; p++) {
+        int64_t begin = __atomic_load_n(&phase_start_ns[p], __ATOMIC_RELAXED);
+        if (begin == 0) continue;   // Skipped
+        int64_t end = p == phase ? now : __atomic_load_n(&phase_end_ns[p], __ATOMIC_RELAXED);
+        fprintf(stderr, "%s\"%s\":{\"seconds\":%.3f,\"total\":%lld}", first ? "" : ",", phase_names[p],
+                (double)(end - begin) / 1e9, (long long)__atomic_load_n(&phase_total[p], __ATOMIC_RELAXED));
+        first = false;
+    }
+    fprintf(stderr, "},\"threads\":%d,\"rss_bytes\":%lld}\n",
+            __atomic_load_n(&lines_used, __ATOMIC_RELAXED), (long long)progress_resident_bytes());
+    fflush(stderr);
+    pthread_mutex_unlock(&tty_lock);
+}
+
+static void *reporter_main(void *arg) {
+    (void)arg;
+    sigset_t usr1;
+    sigemptyset(&usr1);
+    sigaddset(&usr1, SIGUSR1);
+    ReportState rs = {start_ns, 0, PROGRESS_PHASE_SETUP};
+    int64_t interval_ns = (int64_t)(report_interval * 1e9);
+    int64_t next_report = start_ns + interval_ns;
+    struct timespec tick = {0, PROGRESS_TICK_NS};
+
+    while (!__atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) {
+        if (sigtimedwait(&usr1, NULL, &tick) == SIGUSR1) {
+            report_snapshot();
+        }
+        if (interval_ns > 0 && now_ns() >= next_report) {
+            report_status(&rs, false);
+            next_report += interval_ns;
+        }
+    }
+    if (interval_ns > 0) report_status(&rs, true);
+    return NULL;
+}
+
+void progress_start(double interval) {
+    start_ns = now_ns();
+    phase_start_ns[PROGRESS_PHASE_SETUP] = start_ns;
+    phase_trace_begin = trace_clock();
+    report_interval = interval;
+    on_tty = isatty(STDERR_FILENO);
+
+    // Block SIGUSR1 here so every later thread inherits the mask; the
+    // reporter collects it with sigtimedwait
+    sigset_t usr1;
+    sigemptyset(&usr1);
+    sigaddset(&usr1, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &usr1, NULL);
+    reporter_running = pthread_create(&reporter, NULL, reporter_main, NULL) == 0;
+}
+
+void progress_stop(void) {
+    trace_span(phase_names[current_phase], phase_trace_begin, NULL);
+    if (!reporter_running) return;
+    __atomic_store_n(&stopping, 1, __ATOMIC_RELEASE);
+    pthread_join(reporter, NULL);
+    reporter_running = false;
+}
+
+void progress_clear(void) {
+    pthread_mutex_lock(&tty_lock);
+    if (line_drawn) {
+        fputs("\r\033[K", stderr);
+        fflush(stderr);
+        line_drawn = false;
+    }
+    pthread_mutex_unlock(&tty_lock);
+}
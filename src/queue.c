@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include <time.h>
+#include "queue.h"
+
+void queue_init(TaskQueue *q, size_t capacity, int producers) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    q->cells = malloc(sizeof(QueueCell) * size);
+    if (!q->cells) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < size; i++) {
+        q->cells[i].seq = i;
+        q->cells[i].item = NULL;
+    }
+    q->mask = size - 1;
+    q->head = 0;
+    q->tail = 0;
+    q->producers = producers;
+}
+
+void queue_free(TaskQueue *q) {
+    free(q->cells);
+    q->cells = NULL;
+}
+
+bool queue_try_push(TaskQueue *q, void *item) {
+    size_t pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    for (;;) {
+        QueueCell *cell = &q->cells[pos & q->mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            // The cell is free for this lap: claim the position
+            if (__atomic_compare_exchange_n(&q->head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->item = item;
+                __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;   // Full: the consumer has not freed this cell yet
+        } else {
+            pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+bool queue_try_pop(TaskQueue *q, void **item) {
+    size_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        QueueCell *cell = &q->cells[pos & q->mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *item = cell->item;
+                // Hand the cell to the producer one lap ahead
+                __atomic_store_n(&cell->seq, pos + q->mask + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;   // Empty
+        } else {
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void queue_backoff(unsigned attempt) {
+    if (attempt < 64) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#endif
+    } else if (attempt < 128) {
+        sched_yield();
+    } else {
+        struct timespec pause = {0, 50 * 1000};
+        nanosleep(&pause, NULL);
+    }
+}
+
+void queue_push(TaskQueue *q, void *item) {
+    for (unsigned attempt = 0; !queue_try_push(q, item); attempt++) {
+        queue_backoff(attempt);
+    }
+}
+
+bool queue_pop(TaskQueue *q, void **item) {
+    for (unsigned attempt = 0;; attempt++) {
+        if (queue_try_pop(q, item)) return true;
+        if (__atomic_load_n(&q->producers, __ATOMIC_ACQUIRE) == 0) {
+            // Every push happened before the last queue_done
+            return queue_try_pop(q, item);
+        }
+        queue_backoff(attempt);
+    }
+}
+
+void queue_done(TaskQueue *q) {
+    __atomic_sub_fetch(&q->producers, 1, __ATOMIC_RELEASE);
+}
+
+bool queue_closed(TaskQueue *q) {
+    return __atomic_load_n(&q->producers, __ATOMIC_ACQUIRE) == 0;
+}
+
+size_t queue_depth(TaskQueue *q) {
+    size_t tail = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    size_t head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    // The two loads are not a snapshot: a pop between them can put tail ahead
+    return head > tail ? head - tail : 0;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "radix_sort.h"
+#include "big_alloc.h"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+// Below this many keys per worker, thread start-up outweighs the pass
+#define RADIX_MIN_PER_WORKER (1 << 16)
+
+typedef struct {
+    const uint64_t *src_keys;
+    const int64_t *src_vals;
+    uint64_t *dst_keys;
+    int64_t *dst_vals;
+    size_t begin;
+    size_t end;
+    int shift;
+    size_t counts[RADIX_BUCKETS];  // Histogram, then scatter positions
+} RadixChunk;
+
+static void *radix_count(void *arg) {
+    RadixChunk *c = (RadixChunk *)arg;
+    memset(c->counts, 0, sizeof(c->counts));
+    for (size_t i = c->begin; i < c->end; i++) {
+        c->counts[(c->src_keys[i] >> c->shift) & (RADIX_BUCKETS - 1)]++;
+    }
+    return NULL;
+}
+
+static void *radix_scatter(void *arg) {
+    RadixChunk *c = (RadixChunk *)arg;
+    for (size_t i = c->begin; i < c->end; i++) {
+        uint64_t key = c->src_keys[i];
+        size_t pos = c->counts[(key >> c->shift) & (RADIX_BUCKETS - 1)]++;
+        c->dst_keys[pos] = key;
+        c->dst_vals[pos] = c->src_vals[i];
+    }
+    return NULL;
+}
+
+// Run fn over every chunk, chunk 0 on the calling thread
+static void radix_run(RadixChunk *chunks, pthread_t *tids, int workers, void *(*fn)(void *)) {
+    int started = 1;
+    for (; started < workers; started++) {
+        if (pthread_create(&tids[started], NULL, fn, &chunks[started]) != 0) break;
+    }
+    fn(&chunks[0]);
+    // Chunks whose thread failed to start run here instead
+    for (int w = started; w < workers; w++) fn(&chunks[w]);
+    for (int w = 1; w < started; w++) pthread_join(tids[w], NULL);
+}
+
+void radix_sort_pairs(uint64_t *keys, int64_t *vals, size_t n, int workers) {
+    if (n < 2) return;
+    if (workers < 1) workers = 1;
+    if ((size_t)workers > n / RADIX_MIN_PER_WORKER) {
+        workers = (int)(n / RADIX_MIN_PER_WORKER);
+        if (workers < 1) workers = 1;
+    }
+    
+    // A pass is needed only for bytes where some keys differ
+    uint64_t all_or = 0, all_and = ~0ULL;
+    for (size_t i = 0; i < n; i++) {
+        all_or |= keys[i];
+        all_and &= keys[i];
+    }
+    uint64_t varying = all_or ^ all_and;
+    if (varying == 0) return;
+    
+    uint64_t *tmp_keys = big_alloc((int64_t)n, sizeof(uint64_t));
+    int64_t *tmp_vals = big_alloc((int64_t)n, sizeof(int64_t));
+    RadixChunk *chunks = malloc(sizeof(RadixChunk) * (size_t)workers);
+    pthread_t *tids = malloc(sizeof(pthread_t) * (size_t)workers);
+    if (!chunks || !tids) {
+        fprintf(stderr, "Failed to allocate radix sort buffers\n");
+        exit(1);
+    }
+    
+    uint64_t *src_keys = keys, *dst_keys = tmp_keys;
+    int64_t *src_vals = vals, *dst_vals = tmp_vals;
+    
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+        if (((varying >> shift) & (RADIX_BUCKETS - 1)) == 0) continue;
+        
+        for (int w = 0; w < workers; w++) {
+            chunks[w].src_keys = src_keys;
+            chunks[w].src_vals = src_vals;
+            chunks[w].dst_keys = dst_keys;
+            chunks[w].dst_vals = dst_vals;
+            chunks[w].begin = n * (size_t)w / (size_t)workers;
+            chunks[w].end = n * (size_t)(w + 1) / (size_t)workers;
+            chunks[w].shift = shift;
+        }
+        radix_run(chunks, tids, workers, radix_count);
+        
+        // Exclusive prefix over (bucket, worker): each worker writes its
+        // share of a bucket after the earlier workers', keeping it stable.
+        size_t pos = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            for (int w = 0; w < workers; w++) {
+                size_t c = chunks[w].counts[b];
+                chunks[w].counts[b] = pos;
+                pos += c;
+            }
+        }
+        radix_run(chunks, tids, workers, radix_scatter);
+        
+        uint64_t *k = src_keys; src_keys = dst_keys; dst_keys = k;
+        int64_t *v = src_vals; src_vals = dst_vals; dst_vals = v;
+    }
+    
+    if (src_keys != keys) {
+        memcpy(keys, src_keys, sizeof(uint64_t) * n);
+        memcpy(vals, src_vals, sizeof(int64_t) * n);
+    }
+    
+    free(tids);
+    free(chunks);
+    big_free(tmp_vals);
+    big_free(tmp_keys);
+}
+
+void radix_apply_permutation(void *records, size_t size, int64_t *perm, size_t n) {
+    char *base = (char *)records;
+    char *hold = malloc(size);
+    if (!hold) {
+        fprintf(stderr, "Failed to allocate permutation buffer\n");
+        exit(1);
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        if ((size_t)perm[i] == i) continue;
+        
+        // Walk the cycle through i, pulling each record into place
+        memcpy(hold, base + i * size, size);
+        size_t j = i;
+        for (;;) {
+            size_t k = (size_t)perm[j];
+            perm[j] = (int64_t)j;
+            if (k == i) break;
+            memcpy(base + j * size, base + k * size, size);
+            j = k;
+        }
+        memcpy(base + j * size, hold, size);
+    }
+    
+    free(hold);
+}
@@ -0,0 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "render.h"
+#include "checked.h"
+
+static void write_avatar_url(JsonWriter *w, const char *key, const char *hash, int size) {
+    char img_url[256];
+    int len = snprintf(img_url, sizeof(img_url), "https://secure.gravatar.com/avatar/%s.jpg?s=%d&d=identicon", hash, size);
+    json_key(w, key);
+    json_string(w, img_url, (size_t)len);
+}
+
+void render_user(JsonWriter *w, const User *user) {
+    json_begin_object(w);
+    json_key(w, "id");
+    json_cstring(w, user->id);
+    json_key(w, "name");
+    json_cstring(w, user->name);
+    json_key(w, "real_name");
+    json_cstring(w, user->real_name);
+    json_key(w, "team_id");
+    json_cstring(w, "T012345678"); // Fake Team ID
+
+    // Profile
+    json_key(w, "profile");
+    json_begin_object(w);
+    json_key(w, "email");
+    json_cstring(w, user->email);
+    json_key(w, "real_name");
+    json_cstring(w, user->real_name);
+    json_key(w, "display_name");
+    json_cstring(w, user->name);
+
+    json_key(w, "avatar_hash");
+    json_cstring(w, user->avatar_hash);
+
+    write_avatar_url(w, "image_original", user->avatar_hash, 1024);
+    write_avatar_url(w, "image_24", user->avatar_hash, 24);
+    write_avatar_url(w, "image_32", user->avatar_hash, 32);
+    write_avatar_url(w, "image_48", user->avatar_hash, 48);
+    write_avatar_url(w, "image_72", user->avatar_hash, 72);
+    write_avatar_url(w, "image_192", user->avatar_hash, 192);
+    write_avatar_url(w, "image_512", user->avatar_hash, 512);
+    write_avatar_url(w, "image_1024", user->avatar_hash, 1024);
+    json_end_object(w);
+
+    json_key(w, "is_admin");
+    json_bool(w, user->is_admin);
+    json_key(w, "is_owner");
+    json_bool(w, user->is_admin); // Make admins owners for simplicity
+    json_key(w, "is_bot");
+    json_bool(w, user->is_bot);
+    json_key(w, "deleted");
+    json_bool(w, false);
+    json_end_object(w);
+}
+
+void render_channel(JsonWriter *w, const Channel *channel, const IdKeys *ids) {
+    char user_id[12];
+    json_begin_object(w);
+    json_key(w, "id");
+    json_cstring(w, channel->id);
+    json_key(w, "name");
+    json_cstring(w, channel->name);
+    json_key(w, "created");
+    json_int(w, channel->created);
+    json_key(w, "creator");
+    id_format(&ids->user, 'U', (uint64_t)channel->creator_idx, user_id);
+    json_string(w, user_id, sizeof(user_id) - 1);
+    json_key(w, "is_archived");
+    json_bool(w, false);
+    json_key(w, "is_general");
+    json_bool(w, false);
+
+    json_key(w, "members");
+    json_begin_array(w);
+    for (int64_t k = 0; k < channel->member_count; k++) {
+        id_format(&ids->user, 'U', (uint64_t)channel->member_idx[k], user_id);
+        json_string(w, user_id, sizeof(user_id) - 1);
+    }
+    json_end_array(w);
+    json_end_object(w);
+}
+
+// Distinct reply authors in first-reply order, into ru->unique
+static int64_t reply_users_collect(ReplyUsers *ru, const ReplyRef *replies, int64_t count) {
+    size_t size = 16;
+    while (size < (size_t)count * 2) size <<= 1;
+    if (size > ru->slot_capacity) {
+        free(ru->slots);
+        ru->slots = checked_alloc((int64_t)size, sizeof(int64_t));
+        ru->slot_capacity = size;
+    }
+    if ((size_t)count > ru->unique_capacity) {
+        free(ru->unique);
+        ru->unique = checked_alloc(count, sizeof(int64_t));
+        ru->unique_capacity = (size_t)count;
+    }
+    memset(ru->slots, 0, size * sizeof(int64_t));
+
+    int64_t unique_count = 0;
+    for (int64_t r = 0; r < count; r++) {
+        int64_t user = replies[r].user_idx;
+        size_t i = (size_t)(((uint64_t)user * 0x9E3779B97F4A7C15ull) >> 32) & (size - 1);
+        while (ru->slots[i] != 0 && ru->slots[i] != user + 1) {
+            i = (i + 1) & (size - 1);
+        }
+        if (ru->slots[i] == 0) {
+            ru->slots[i] = user + 1;
+            ru->unique[unique_count++] = user;
+        }
+    }
+    return unique_count;
+}
+
+void render_message(JsonWriter *w, const IdKeys *ids, ReplyUsers *ru, const Message *m, int64_t parent_user, const ReplyRef *replies) {
+    char user_id[12];
+
+    json_begin_object(w);
+    json_key(w, "user");
+    id_format(&ids->user, 'U', (uint64_t)m->user_idx, user_id);
+    json_string(w, user_id, sizeof(user_id) - 1);
+    json_key(w, "type");
+    json_cstring(w, "message");
+
+    char ts_str[32];
+    int ts_len = snprintf(ts_str, sizeof(ts_str), "%.6f", m->ts);
+    json_key(w, "ts");
+    json_string(w, ts_str, (size_t)ts_len);
+
+    json_key(w, "text");
+    json_string(w, m->text, m->text_len);
+
+    // Threading
+    if (m->thread_ts > 0) {
+        char thread_ts_str[32];
+        int thread_ts_len = snprintf(thread_ts_str, sizeof(thread_ts_str), "%.6f", m->thread_ts);
+        json_key(w, "thread_ts");
+        json_string(w, thread_ts_str, (size_t)thread_ts_len);
+
+        // If it's a child message (has a parent)
+        if (parent_user >= 0) {
+            json_key(w, "parent_user_id");
+            id_format(&ids->user, 'U', (uint64_t)parent_user, user_id);
+            json_string(w, user_id, sizeof(user_id) - 1);
+        }
+
+        // If it's a parent message (has replies)
+        if (m->reply_count > 0) {
+            json_key(w, "reply_count");
+            json_int(w, m->reply_count);
+
+            char latest_reply_str[32];
+            int latest_len = snprintf(latest_reply_str, sizeof(latest_reply_str), "%.6f", m->latest_reply);
+            json_key(w, "latest_reply");
+            json_string(w, latest_reply_str, (size_t)latest_len);
+
+            // The count precedes the list in the output, so the users are
+            // collected first
+            int64_t unique_count = reply_users_collect(ru, replies, m->reply_count);
+            json_key(w, "reply_users_count");
+            json_int(w, unique_count);
+
+            json_key(w, "reply_users");
+            json_begin_array(w);
+            for (int64_t u = 0; u < unique_count; u++) {
+                id_format(&ids->user, 'U', (uint64_t)ru->unique[u], user_id);
+                json_string(w, user_id, sizeof(user_id) - 1);
+            }
+            json_end_array(w);
+
+            json_key(w, "replies");
+            json_begin_array(w);
+            for (int64_t r = 0; r < m->reply_count; r++) {
+                json_begin_object(w);
+                json_key(w, "user");
+                id_format(&ids->user, 'U', (uint64_t)replies[r].user_idx, user_id);
+                json_string(w, user_id, sizeof(user_id) - 1);
+                char r_ts_str[32];
+                int r_ts_len = snprintf(r_ts_str, sizeof(r_ts_str), "%.6f", replies[r].ts);
+                json_key(w, "ts");
+                json_string(w, r_ts_str, (size_t)r_ts_len);
+                json_end_object(w);
+            }
+            json_end_array(w);
+
+            json_key(w, "is_locked");
+            json_bool(w, false);
+            json_key(w, "subscribed");
+            json_bool(w, false);
+        }
+    }
+
+    json_end_object(w);
+}
+
+void reply_users_free(ReplyUsers *ru) {
+    free(ru->slots);
+    free(ru->unique);
+    ru->slots = ru->unique = NULL;
+    ru->slot_capacity = ru->unique_capacity = 0;
+}
@@ -0,0 +1,85 @@
+#include <string.h>
+#include "rng.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define RNG_SSE2 1
+#include <emmintrin.h>
+#endif
+
+uint64_t rng_splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = rng_splitmix64(&seed);
+    }
+}
+
+void rng_seed_stream(Rng *rng, uint64_t seed, uint64_t stream) {
+    uint64_t x = stream;
+    rng_seed(rng, seed ^ rng_splitmix64(&x));
+}
+
+void rng_fill(Rng *rng, uint64_t *out, size_t n) {
+    // Work on a local copy so the state stays in registers
+    Rng local = *rng;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = rng_next(&local);
+    }
+    *rng = local;
+}
+
+// Convert 8 bytes into 16 hex characters without branches
+#ifdef RNG_SSE2
+__attribute__((target("sse2")))
+static void hex16(uint64_t word, char *out) {
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i digit_base = _mm_set1_epi8('0');
+    const __m128i letter_gap = _mm_set1_epi8('a' - '0' - 10);
+    
+    __m128i v = _mm_cvtsi64_si128((long long)word);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble);
+    __m128i lo = _mm_and_si128(v, low_nibble);
+    __m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+    // Nibbles above 9 get shifted from the digit range into 'a'..'f'
+    __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine), letter_gap);
+    __m128i chars = _mm_add_epi8(_mm_add_epi8(nibbles, digit_base), letters);
+    _mm_storeu_si128((__m128i *)out, chars);
+}
+#else
+static void hex16(uint64_t word, char *out) {
+    // Same order as the SSE2 path: bytes from the least significant,
+    // high nibble first within each byte
+    for (int i = 0; i < 16; i++) {
+        unsigned int nib = (unsigned int)(word >> (8 * (i / 2) + (i % 2 ? 0 : 4))) & 0xF;
+        // (9 - nib) >> 8 is all ones exactly when nib > 9
+        out[i] = (char)('0' + nib + (((9u - nib) >> 8) & ('a' - '0' - 10)));
+    }
+}
+#endif
+
+void rng_hex(Rng *rng, char *out, size_t len) {
+    uint64_t words[8];
+    char chunk[16];
+    while (len > 0) {
+        size_t n_words = (len + 15) / 16;
+        if (n_words > 8) n_words = 8;
+        rng_fill(rng, words, n_words);
+        for (size_t i = 0; i < n_words; i++) {
+            if (len >= 16) {
+                hex16(words[i], out);
+                out += 16;
+                len -= 16;
+            } else {
+                hex16(words[i], chunk);
+                memcpy(out, chunk, len);
+                len = 0;
+            }
+        }
+    }
+}
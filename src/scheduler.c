@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "scheduler.h"
+#include "queue.h"
+#include "checked.h"
+#include "numa.h"
+#include "trace.h"
+
+// Splits outstanding at once are bounded by the bits in a range length
+#define SCHEDULER_SPLIT_SLOTS 64
+
+// Chase-Lev deque on a fixed ring. The owner pushes and takes at the
+// bottom, thieves take at the top. The ring is sized so the bottom never
+// laps the top; a push that would is refused and the task runs unsplit.
+typedef struct {
+    WorkTask *tasks;
+    int64_t mask;
+    char pad0[64];
+    int64_t top;
+    char pad1[64];
+    int64_t bottom;
+    char pad2[64];
+} WorkDeque;
+
+typedef struct Scheduler Scheduler;
+
+typedef struct {
+    Scheduler *sched;
+    int index;
+    WorkDeque deque;
+} SchedulerWorker;
+
+struct Scheduler {
+    SchedulerWorker *workers;
+    int worker_count;
+    int64_t grain;
+    WorkFn fn;
+    void *ctx;
+    int64_t remaining;      // Units not yet processed
+};
+
+// Slots are read by thieves while the owner may be taking the same one,
+// so both halves are accessed atomically
+static void slot_store(WorkDeque *d, int64_t i, WorkTask task) {
+    WorkTask *slot = &d->tasks[i & d->mask];
+    __atomic_store_n(&slot->begin, task.begin, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->end, task.end, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->node, task.node, __ATOMIC_RELAXED);
+}
+
+static WorkTask slot_load(WorkDeque *d, int64_t i) {
+    WorkTask *slot = &d->tasks[i & d->mask];
+    WorkTask task;
+    task.begin = __atomic_load_n(&slot->begin, __ATOMIC_RELAXED);
+    task.end = __atomic_load_n(&slot->end, __ATOMIC_RELAXED);
+    task.node = __atomic_load_n(&slot->node, __ATOMIC_RELAXED);
+    return task;
+}
+
+static bool deque_push(WorkDeque *d, WorkTask task) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    if (b - t > d->mask) return false;
+    slot_store(d, b, task);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool deque_take(WorkDeque *d, WorkTask *task) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+    if (t > b) {
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    *task = slot_load(d, b);
+    if (t < b) return true;
+    // Last task: race the thieves for it
+    bool won = __atomic_compare_exchange_n(&d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    return won;
+}
+
+static bool deque_steal(WorkDeque *d, WorkTask *task) {
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) return false;
+    *task = slot_load(d, t);
+    return __atomic_compare_exchange_n(&d->top, &t, t + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+static void run_task(Scheduler *s, SchedulerWorker *self, WorkTask task) {
+    // Keep the front half, offer the back half to thieves
+    while (s->grain > 0 && task.end - task.begin > s->grain) {
+        int64_t mid = task.begin + (task.end - task.begin) / 2;
+        WorkTask back = {mid, task.end, task.node};
+        if (!deque_push(&self->deque, back)) break;
+        task.end = mid;
+    }
+    int64_t begin = trace_clock();
+    s->fn(s->ctx, self->index, task.begin, task.end);
+    trace_span("task", begin, "%lld+%lld", (long long)task.begin, (long long)(task.end - task.begin));
+    __atomic_sub_fetch(&s->remaining, task.end - task.begin, __ATOMIC_RELEASE);
+}
+
+// Try workers on the thief's node, then the rest
+static bool steal_any(Scheduler *s, int thief, WorkTask *task) {
+    int node = numa_worker_node(thief);
+    for (int local = 1; local >= 0; local--) {
+        for (int k = 1; k < s->worker_count; k++) {
+            int victim = (thief + k) % s->worker_count;
+            if ((numa_worker_node(victim) == node) != local) continue;
+            if (deque_steal(&s->workers[victim].deque, task)) return true;
+        }
+    }
+    return false;
+}
+
+static void *scheduler_worker(void *arg) {
+    SchedulerWorker *self = arg;
+    Scheduler *s = self->sched;
+    numa_pin_worker(self->index);
+    if (self->index > 0) trace_thread_name("worker %d", self->index);
+    unsigned attempt = 0;
+    while (__atomic_load_n(&s->remaining, __ATOMIC_ACQUIRE) > 0) {
+        WorkTask task;
+        if (deque_take(&self->deque, &task) || steal_any(s, self->index, &task)) {
+            run_task(s, self, task);
+            attempt = 0;
+        } else {
+            // Everything left is running elsewhere and may still split
+            queue_backoff(attempt++);
+        }
+    }
+    return NULL;
+}
+
+// Heaviest first
+static int compare_tasks(const void *a, const void *b) {
+    int64_t la = ((const WorkTask *)a)->end - ((const WorkTask *)a)->begin;
+    int64_t lb = ((const WorkTask *)b)->end - ((const WorkTask *)b)->begin;
+    return (la < lb) - (la > lb);
+}
+
+void scheduler_run(int workers, WorkTask *tasks, int64_t task_count, int64_t grain, WorkFn fn, void *ctx) {
+    qsort(tasks, (size_t)task_count, sizeof(WorkTask), compare_tasks);
+    while (task_count > 0 && tasks[task_count - 1].end <= tasks[task_count - 1].begin) task_count--;
+    if (task_count == 0) return;
+    if (workers < 1) workers = 1;
+    // Without splitting, workers beyond the task count would only spin
+    if (grain == 0 && workers > task_count) workers = (int)task_count;
+
+    Scheduler s = {
+        .workers = checked_alloc(workers, sizeof(SchedulerWorker)),
+        .worker_count = workers,
+        .grain = grain,
+        .fn = fn,
+        .ctx = ctx,
+        .remaining = 0,
+    };
+
+    // Deal each task to the next worker on its node (node n has workers
+    // n, n + nodes, ...), or round robin when no worker is on it. Shares
+    // are pushed lightest first, so each owner starts on its heaviest task
+    // and thieves take light ones.
+    int nodes = numa_node_count();
+    int *assigned = checked_alloc(task_count, sizeof(int));
+    int64_t *share = checked_calloc(workers, sizeof(int64_t));
+    int64_t *node_next = checked_calloc(nodes, sizeof(int64_t));
+    int64_t any_next = 0;
+    for (int64_t i = 0; i < task_count; i++) {
+        int node = tasks[i].node;
+        int w;
+        if (node >= 0 && node < nodes && node < workers) {
+            int on_node = (workers - node + nodes - 1) / nodes;
+            w = node + (int)(node_next[node]++ % on_node) * nodes;
+        } else {
+            w = (int)(any_next++ % workers);
+        }
+        assigned[i] = w;
+        share[w]++;
+    }
+    for (int w = 0; w < workers; w++) {
+        SchedulerWorker *sw = &s.workers[w];
+        int64_t capacity = 1;
+        while (capacity < share[w] + SCHEDULER_SPLIT_SLOTS) capacity <<= 1;
+        sw->sched = &s;
+        sw->index = w;
+        sw->deque.tasks = checked_alloc(capacity, sizeof(WorkTask));
+        sw->deque.mask = capacity - 1;
+        sw->deque.top = 0;
+        sw->deque.bottom = 0;
+    }
+    for (int64_t i = task_count - 1; i >= 0; i--) {
+        deque_push(&s.workers[assigned[i]].deque, tasks[i]);
+        s.remaining += tasks[i].end - tasks[i].begin;
+    }
+    free(node_next);
+    free(share);
+    free(assigned);
+
+    // A worker that fails to start leaves its deque to be stolen
+    pthread_t *tids = checked_alloc(workers, sizeof(pthread_t));
+    bool *started = checked_calloc(workers, sizeof(bool));
+    for (int w = 1; w < workers; w++) {
+        started[w] = pthread_create(&tids[w], NULL, scheduler_worker, &s.workers[w]) == 0;
+    }
+    scheduler_worker(&s.workers[0]);
+    numa_unpin();
+    for (int w = 1; w < workers; w++) {
+        if (started[w]) pthread_join(tids[w], NULL);
+    }
+
+    for (int w = 0; w < workers; w++) {
+        free(s.workers[w].deque.tasks);
+    }
+    free(started);
+    free(tids);
+    free(s.workers);
+}
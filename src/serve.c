@@ -0,0 +1,939 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "serve.h"
+#include "render.h"
+#include "json_writer.h"
+#include "checked.h"
+
+// The poller checks for idle connections this often (milliseconds)
+#define SERVE_POLL_MS 100
+// An idle connection is closed after this long (milliseconds)
+#define SERVE_IDLE_MS 30000
+// Largest request, headers and body together
+#define SERVE_REQUEST_MAX 65536
+// Page size without a limit argument, and the largest allowed
+#define SERVE_LIMIT_DEFAULT 100
+#define SERVE_LIMIT_MAX 1000
+
+typedef enum {
+    API_USERS_LIST,
+    API_CONVERSATIONS_LIST,
+    API_CONVERSATIONS_HISTORY,
+    API_CONVERSATIONS_REPLIES,
+    API_METHODS
+} ApiMethod;
+
+static const char *method_names[API_METHODS] = {
+    "users.list", "conversations.list", "conversations.history", "conversations.replies"
+};
+
+// Cursors are base64 of "<kind>:<position>", and only fit their method
+static const char *cursor_kinds[API_METHODS] = {"user", "channel", "history", "reply"};
+
+// Token bucket holding up to a minute's worth of requests
+typedef struct {
+    double tokens;
+    int64_t updated_ns;
+} Bucket;
+
+typedef struct Worker Worker;
+
+// A client connection. Between requests it waits in the poller's set and
+// keeps only the bytes received past the last request.
+typedef struct Connection {
+    int fd;
+    char *pending;              // pending_len bytes, or NULL
+    size_t pending_len;
+    int64_t idle_since_ns;      // When it last went back to the poller
+    struct Connection *next;    // In the ready or returned list
+} Connection;
+
+struct Server {
+    ServeData data;
+    ServeOptions opts;
+    int listen_fd;
+    int port;
+    int stopping;
+    int64_t requests;
+    Worker *workers;
+    pthread_t poller;
+    bool poller_started;
+    int wake[2];                // Pipe that interrupts the poller
+    pthread_mutex_t conn_lock;
+    pthread_cond_t conn_ready;
+    Connection *ready;          // Data waiting, for the workers, oldest first
+    Connection *ready_last;
+    Connection *returned;       // Back from the workers, for the poller
+    pthread_mutex_t limit_lock;
+    Bucket buckets[API_METHODS];
+};
+
+struct Worker {
+    Server *server;
+    pthread_t thread;
+    bool started;
+    HistoryReader reader;
+    JsonWriter json;
+    ReplyUsers ru;
+    char *request;              // SERVE_REQUEST_MAX bytes
+};
+
+// Arguments of a request, URL-decoded; absent ones are empty
+typedef struct {
+    char channel[16];
+    char cursor[128];
+    char ts[32];
+    char latest[32];
+    char oldest[32];
+    char limit[16];
+    char inclusive[8];
+} Params;
+
+static const struct {
+    const char *name;
+    size_t offset;
+    size_t size;
+} param_fields[] = {
+    {"channel", offsetof(Params, channel), sizeof(((Params *)0)->channel)},
+    {"cursor", offsetof(Params, cursor), sizeof(((Params *)0)->cursor)},
+    {"ts", offsetof(Params, ts), sizeof(((Params *)0)->ts)},
+    {"latest", offsetof(Params, latest), sizeof(((Params *)0)->latest)},
+    {"oldest", offsetof(Params, oldest), sizeof(((Params *)0)->oldest)},
+    {"limit", offsetof(Params, limit), sizeof(((Params *)0)->limit)},
+    {"inclusive", offsetof(Params, inclusive), sizeof(((Params *)0)->inclusive)},
+};
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// --- Arguments ---
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Decode len bytes of a form value into out, cut short to fit capacity
+static void url_decode(const char *s, size_t len, char *out, size_t capacity) {
+    size_t n = 0;
+    for (size_t i = 0; i < len && n + 1 < capacity; i++) {
+        char c = s[i];
+        if (c == '+') {
+            c = ' ';
+        } else if (c == '%' && i + 2 < len && hex_value(s[i + 1]) >= 0 && hex_value(s[i + 2]) >= 0) {
+            c = (char)(hex_value(s[i + 1]) * 16 + hex_value(s[i + 2]));
+            i += 2;
+        }
+        out[n++] = c;
+    }
+    out[n] = '\0';
+}
+
+// Read the known arguments of an application/x-www-form-urlencoded string
+static void parse_params(const char *s, size_t len, Params *p) {
+    const char *end = s + len;
+    while (s < end) {
+        const char *amp = memchr(s, '&', (size_t)(end - s));
+        if (!amp) amp = end;
+        const char *eq = memchr(s, '=', (size_t)(amp - s));
+        if (eq) {
+            char key[16];
+            url_decode(s, (size_t)(eq - s), key, sizeof(key));
+            for (size_t i = 0; i < sizeof(param_fields) / sizeof(param_fields[0]); i++) {
+                if (strcmp(key, param_fields[i].name) == 0) {
+                    url_decode(eq + 1, (size_t)(amp - eq - 1), (char *)p + param_fields[i].offset, param_fields[i].size);
+                }
+            }
+        }
+        s = amp + 1;
+    }
+}
+
+// A Slack timestamp, seconds with up to six decimals, in microseconds
+static bool parse_ts(const char *s, int64_t *us) {
+    int64_t seconds = 0;
+    int64_t micros = 0;
+    int digits = 0;
+    if (*s < '0' || *s > '9') return false;
+    while (*s >= '0' && *s <= '9') {
+        seconds = seconds * 10 + (*s++ - '0');
+        if (seconds > 1000000000000LL) return false;
+    }
+    if (*s == '.') {
+        s++;
+        while (*s >= '0' && *s <= '9') {
+            if (digits < 6) {
+                micros = micros * 10 + (*s - '0');
+                digits++;
+            }
+            s++;
+        }
+    }
+    if (*s != '\0') return false;
+    for (; digits < 6; digits++) micros *= 10;
+    *us = seconds * 1000000 + micros;
+    return true;
+}
+
+static int64_t page_limit(const Params *p) {
+    long long limit = atoll(p->limit);
+    if (limit <= 0) return SERVE_LIMIT_DEFAULT;
+    return limit < SERVE_LIMIT_MAX ? limit : SERVE_LIMIT_MAX;
+}
+
+static bool param_true(const char *value) {
+    return strcmp(value, "1") == 0 || strcmp(value, "true") == 0;
+}
+
+// Index of the channel argument, or -1 if it names no channel
+static int64_t channel_param(const ServeData *d, const Params *p) {
+    int64_t channel = id_parse(&d->ids->channel, 'C', p->channel);
+    return channel >= 0 && channel < d->channel_count ? channel : -1;
+}
+
+// --- Cursors ---
+
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static void cursor_encode(ApiMethod method, int64_t pos, char *out) {
+    char plain[48];
+    int len = snprintf(plain, sizeof(plain), "%s:%lld", cursor_kinds[method], (long long)pos);
+    const unsigned char *in = (const unsigned char *)plain;
+    size_t n = 0;
+    for (int i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+        out[n++] = base64_chars[(v >> 18) & 63];
+        out[n++] = base64_chars[(v >> 12) & 63];
+        out[n++] = i + 1 < len ? base64_chars[(v >> 6) & 63] : '=';
+        out[n++] = i + 2 < len ? base64_chars[v & 63] : '=';
+    }
+    out[n] = '\0';
+}
+
+// Position held by the cursor argument, or fallback without one. False if
+// the cursor is malformed, belongs to another method or passes max.
+static bool cursor_position(const Params *p, ApiMethod method, int64_t fallback, int64_t max, int64_t *pos) {
+    if (p->cursor[0] == '\0') {
+        *pos = fallback;
+        return true;
+    }
+    char plain[sizeof(p->cursor)];
+    size_t n = 0;
+    uint32_t v = 0;
+    int bits = 0;
+    for (const char *c = p->cursor; *c && *c != '='; c++) {
+        const char *at = strchr(base64_chars, *c);
+        if (!at) return false;
+        v = (v << 6) | (uint32_t)(at - base64_chars);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            plain[n++] = (char)((v >> bits) & 0xFF);
+        }
+    }
+    plain[n] = '\0';
+
+    size_t kind_len = strlen(cursor_kinds[method]);
+    if (strncmp(plain, cursor_kinds[method], kind_len) != 0 || plain[kind_len] != ':') return false;
+    const char *digits = plain + kind_len + 1;
+    if (*digits < '0' || *digits > '9') return false;
+    char *end;
+    long long value = strtoll(digits, &end, 10);
+    if (*end != '\0' || value > max) return false;
+    *pos = value;
+    return true;
+}
+
+// --- Responses ---
+
+static void begin_ok(JsonWriter *w) {
+    json_writer_reset(w);
+    json_begin_object(w);
+    json_key(w, "ok");
+    json_bool(w, true);
+}
+
+// Close a page, next being the position the next page starts at or -1
+static int end_page(JsonWriter *w, ApiMethod method, int64_t next) {
+    char cursor[72] = "";
+    if (next >= 0) cursor_encode(method, next, cursor);
+    json_key(w, "response_metadata");
+    json_begin_object(w);
+    json_key(w, "next_cursor");
+    json_cstring(w, cursor);
+    json_end_object(w);
+    json_end_object(w);
+    return 200;
+}
+
+static int fail(JsonWriter *w, int status, const char *error) {
+    json_writer_reset(w);
+    json_begin_object(w);
+    json_key(w, "ok");
+    json_bool(w, false);
+    json_key(w, "error");
+    json_cstring(w, error);
+    json_end_object(w);
+    return status;
+}
+
+// A channel as the API describes it, rather than as channels.json does
+static void render_api_channel(JsonWriter *w, const Channel *channel, const IdKeys *ids) {
+    char user_id[12];
+    id_format(&ids->user, 'U', (uint64_t)channel->creator_idx, user_id);
+    json_begin_object(w);
+    json_key(w, "id");
+    json_cstring(w, channel->id);
+    json_key(w, "name");
+    json_cstring(w, channel->name);
+    json_key(w, "is_channel");
+    json_bool(w, true);
+    json_key(w, "is_group");
+    json_bool(w, false);
+    json_key(w, "is_im");
+    json_bool(w, false);
+    json_key(w, "is_private");
+    json_bool(w, false);
+    json_key(w, "created");
+    json_int(w, channel->created);
+    json_key(w, "creator");
+    json_string(w, user_id, sizeof(user_id) - 1);
+    json_key(w, "is_archived");
+    json_bool(w, false);
+    json_key(w, "is_general");
+    json_bool(w, false);
+    json_key(w, "name_normalized");
+    json_cstring(w, channel->name);
+    json_key(w, "num_members");
+    json_int(w, channel->member_count);
+    const char *texts[] = {"topic", "purpose"};
+    for (int i = 0; i < 2; i++) {
+        json_key(w, texts[i]);
+        json_begin_object(w);
+        json_key(w, "value");
+        json_cstring(w, "");
+        json_key(w, "creator");
+        json_cstring(w, "");
+        json_key(w, "last_set");
+        json_int(w, 0);
+        json_end_object(w);
+    }
+    json_end_object(w);
+}
+
+// --- Methods ---
+
+static int users_list(Worker *wk, const Params *p) {
+    const ServeData *d = &wk->server->data;
+    JsonWriter *w = &wk->json;
+    int64_t pos;
+    if (!cursor_position(p, API_USERS_LIST, 0, d->user_count, &pos)) return fail(w, 200, "invalid_cursor");
+    int64_t end = pos + page_limit(p) < d->user_count ? pos + page_limit(p) : d->user_count;
+
+    begin_ok(w);
+    json_key(w, "members");
+    json_begin_array(w);
+    for (int64_t i = pos; i < end; i++) render_user(w, &d->users[i]);
+    json_end_array(w);
+    return end_page(w, API_USERS_LIST, end < d->user_count ? end : -1);
+}
+
+static int conversations_list(Worker *wk, const Params *p) {
+    const ServeData *d = &wk->server->data;
+    JsonWriter *w = &wk->json;
+    int64_t pos;
+    if (!cursor_position(p, API_CONVERSATIONS_LIST, 0, d->channel_count, &pos)) return fail(w, 200, "invalid_cursor");
+    int64_t end = pos + page_limit(p) < d->channel_count ? pos + page_limit(p) : d->channel_count;
+
+    begin_ok(w);
+    json_key(w, "channels");
+    json_begin_array(w);
+    for (int64_t i = pos; i < end; i++) render_api_channel(w, &d->channels[i], d->ids);
+    json_end_array(w);
+    return end_page(w, API_CONVERSATIONS_LIST, end < d->channel_count ? end : -1);
+}
+
+// Newest first. The cursor holds the position below which the next page
+// starts, so pages stay put however far back they go.
+static int conversations_history(Worker *wk, const Params *p) {
+    const ServeData *d = &wk->server->data;
+    const History *h = d->history;
+    HistoryReader *r = &wk->reader;
+    JsonWriter *w = &wk->json;
+    int64_t channel = channel_param(d, p);
+    if (channel < 0) return fail(w, 200, "channel_not_found");
+    int64_t oldest = 0;
+    int64_t latest = h->end_us;
+    if (p->oldest[0] && !parse_ts(p->oldest, &oldest)) return fail(w, 200, "invalid_ts_oldest");
+    if (p->latest[0] && !parse_ts(p->latest, &latest)) return fail(w, 200, "invalid_ts_latest");
+    bool inclusive = param_true(p->inclusive);
+
+    int64_t lo = history_rank(h, r, channel, inclusive ? oldest : oldest + 1);
+    int64_t hi = history_rank(h, r, channel, inclusive ? latest + 1 : latest);
+    if (hi < lo) hi = lo;
+    int64_t pos;
+    if (!cursor_position(p, API_CONVERSATIONS_HISTORY, hi, hi, &pos)) return fail(w, 200, "invalid_cursor");
+    int64_t start = pos - page_limit(p) > lo ? pos - page_limit(p) : lo;
+
+    begin_ok(w);
+    json_key(w, "messages");
+    json_begin_array(w);
+    for (int64_t i = pos - 1; i >= start; i--) {
+        HistoryMessage hm;
+        history_get(h, r, channel, i, &hm);
+        render_message(w, d->ids, &wk->ru, &hm.msg, -1, hm.replies);
+    }
+    json_end_array(w);
+    json_key(w, "has_more");
+    json_bool(w, start > lo);
+    return end_page(w, API_CONVERSATIONS_HISTORY, start > lo ? start : -1);
+}
+
+// The parent, then its replies, oldest first. Position k is the parent
+// for 0 and reply k - 1 after it.
+static int conversations_replies(Worker *wk, const Params *p) {
+    const ServeData *d = &wk->server->data;
+    const History *h = d->history;
+    HistoryReader *r = &wk->reader;
+    JsonWriter *w = &wk->json;
+    int64_t channel = channel_param(d, p);
+    if (channel < 0) return fail(w, 200, "channel_not_found");
+    int64_t ts;
+    if (!parse_ts(p->ts, &ts)) return fail(w, 200, "thread_not_found");
+    int64_t parent = history_rank(h, r, channel, ts);
+    if (parent >= history_count(h, channel)) return fail(w, 200, "thread_not_found");
+    HistoryMessage hm;
+    history_get(h, r, channel, parent, &hm);
+    if (llround(hm.msg.ts * 1e6) != ts) return fail(w, 200, "thread_not_found");
+
+    int64_t oldest = 0;
+    int64_t latest = h->end_us;
+    if (p->oldest[0] && !parse_ts(p->oldest, &oldest)) return fail(w, 200, "invalid_ts_oldest");
+    if (p->latest[0] && !parse_ts(p->latest, &latest)) return fail(w, 200, "invalid_ts_latest");
+    bool inclusive = param_true(p->inclusive);
+    int64_t lo = 0;
+    int64_t hi = 0;
+    for (int64_t k = 0; k <= hm.msg.reply_count; k++) {
+        int64_t at = k == 0 ? ts : llround(hm.replies[k - 1].ts * 1e6);
+        if (at < oldest || (at == oldest && !inclusive)) lo = k + 1;
+        if (at < latest || (at == latest && inclusive)) hi = k + 1;
+    }
+    if (hi < lo) hi = lo;
+    int64_t pos;
+    if (!cursor_position(p, API_CONVERSATIONS_REPLIES, lo, hi, &pos)) return fail(w, 200, "invalid_cursor");
+    if (pos < lo) pos = lo;
+    int64_t end = pos + page_limit(p) < hi ? pos + page_limit(p) : hi;
+
+    begin_ok(w);
+    json_key(w, "messages");
+    json_begin_array(w);
+    for (int64_t k = pos; k < end; k++) {
+        if (k == 0) {
+            render_message(w, d->ids, &wk->ru, &hm.msg, -1, hm.replies);
+        } else {
+            Message reply;
+            history_reply(h, r, &hm, k - 1, &reply);
+            render_message(w, d->ids, &wk->ru, &reply, hm.msg.user_idx, NULL);
+        }
+    }
+    json_end_array(w);
+    json_key(w, "has_more");
+    json_bool(w, end < hi);
+    return end_page(w, API_CONVERSATIONS_REPLIES, end < hi ? end : -1);
+}
+
+// Take a request from the method's bucket. Returns 0, or the seconds
+// until one is allowed.
+static int rate_limit_take(Server *s, ApiMethod method) {
+    if (s->opts.rate_limit <= 0) return 0;
+    double per_ns = (double)s->opts.rate_limit / 60e9;
+    int64_t now = now_ns();
+    int wait = 0;
+    pthread_mutex_lock(&s->limit_lock);
+    Bucket *b = &s->buckets[method];
+    b->tokens += (double)(now - b->updated_ns) * per_ns;
+    if (b->tokens > s->opts.rate_limit) b->tokens = s->opts.rate_limit;
+    b->updated_ns = now;
+    if (b->tokens >= 1.0) {
+        b->tokens -= 1.0;
+    } else {
+        wait = (int)ceil((1.0 - b->tokens) / per_ns / 1e9);
+    }
+    pthread_mutex_unlock(&s->limit_lock);
+    return wait;
+}
+
+// Answer the request for path into wk->json. Returns the HTTP status.
+static int dispatch(Worker *wk, const char *path, size_t path_len, const Params *p, int *retry_after) {
+    ApiMethod method = API_METHODS;
+    if (path_len > 5 && memcmp(path, "/api/", 5) == 0) {
+        for (int i = 0; i < API_METHODS; i++) {
+            if (path_len - 5 == strlen(method_names[i]) && memcmp(path + 5, method_names[i], path_len - 5) == 0) {
+                method = (ApiMethod)i;
+            }
+        }
+    }
+    if (method == API_METHODS) return fail(&wk->json, 404, "unknown_method");
+    *retry_after = rate_limit_take(wk->server, method);
+    if (*retry_after > 0) return fail(&wk->json, 429, "ratelimited");
+
+    text_arena_reset(&wk->reader.arena);
+    switch (method) {
+    case API_USERS_LIST:
+        return users_list(wk, p);
+    case API_CONVERSATIONS_LIST:
+        return conversations_list(wk, p);
+    case API_CONVERSATIONS_HISTORY:
+        return conversations_history(wk, p);
+    default:
+        return conversations_replies(wk, p);
+    }
+}
+
+// --- HTTP ---
+
+static void send_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static void respond(Worker *wk, int fd, int status, int retry_after, bool keep_alive) {
+    const char *reason = status == 200 ? "OK" :
+                         status == 404 ? "Not Found" :
+                         status == 413 ? "Payload Too Large" :
+                         status == 429 ? "Too Many Requests" : "Bad Request";
+    char header[256];
+    int len = snprintf(header, sizeof(header),
+                       "HTTP/1.1 %d %s\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: %zu\r\n",
+                       status, reason, wk->json.len);
+    if (retry_after > 0) len += snprintf(header + len, sizeof(header) - (size_t)len, "Retry-After: %d\r\n", retry_after);
+    len += snprintf(header + len, sizeof(header) - (size_t)len, "%s\r\n", keep_alive ? "" : "Connection: close\r\n");
+    send_all(fd, header, (size_t)len);
+    send_all(fd, wk->json.data, wk->json.len);
+    __atomic_add_fetch(&wk->server->requests, 1, __ATOMIC_RELAXED);
+}
+
+// Value of header name in the header block, or NULL. *len gets its length.
+static const char *header_value(const char *headers, size_t headers_len, const char *name, size_t *len) {
+    size_t name_len = strlen(name);
+    const char *end = headers + headers_len;
+    const char *line = headers;
+    while (line < end) {
+        const char *eol = memchr(line, '\n', (size_t)(end - line));
+        if (!eol) eol = end;
+        if ((size_t)(eol - line) > name_len && strncasecmp(line, name, name_len) == 0 && line[name_len] == ':') {
+            const char *v = line + name_len + 1;
+            while (v < eol && (*v == ' ' || *v == '\t')) v++;
+            const char *v_end = eol;
+            while (v_end > v && (v_end[-1] == '\r' || v_end[-1] == ' ')) v_end--;
+            *len = (size_t)(v_end - v);
+            return v;
+        }
+        line = eol + 1;
+    }
+    return NULL;
+}
+
+// The empty line ending the headers in buf, or NULL
+static char *find_blank_line(char *buf, size_t len) {
+    for (size_t i = 0; i + 4 <= len; i++) {
+        if (memcmp(buf + i, "\r\n\r\n", 4) == 0) return buf + i;
+    }
+    return NULL;
+}
+
+// --- Connections ---
+
+static void connection_close(Connection *c) {
+    close(c->fd);
+    free(c->pending);
+    free(c);
+}
+
+static void connections_close(Connection *c) {
+    while (c) {
+        Connection *next = c->next;
+        connection_close(c);
+        c = next;
+    }
+}
+
+static void poller_wake(Server *s) {
+    // A full pipe already wakes the poller
+    ssize_t n = write(s->wake[1], "", 1);
+    (void)n;
+}
+
+// Queue a connection with data for the workers
+static void hand_to_worker(Server *s, Connection *c) {
+    c->next = NULL;
+    pthread_mutex_lock(&s->conn_lock);
+    if (s->ready_last) {
+        s->ready_last->next = c;
+    } else {
+        s->ready = c;
+    }
+    s->ready_last = c;
+    pthread_cond_signal(&s->conn_ready);
+    pthread_mutex_unlock(&s->conn_lock);
+}
+
+// The next connection with data, or NULL once the server is stopping
+static Connection *take_ready(Server *s) {
+    pthread_mutex_lock(&s->conn_lock);
+    while (!s->ready && !__atomic_load_n(&s->stopping, __ATOMIC_ACQUIRE)) {
+        pthread_cond_wait(&s->conn_ready, &s->conn_lock);
+    }
+    Connection *c = NULL;
+    if (!__atomic_load_n(&s->stopping, __ATOMIC_ACQUIRE)) {
+        c = s->ready;
+        s->ready = c->next;
+        if (!s->ready) s->ready_last = NULL;
+    }
+    pthread_mutex_unlock(&s->conn_lock);
+    return c;
+}
+
+// Give a connection back to the poller to wait for its next request
+static void hand_to_poller(Server *s, Connection *c) {
+    c->idle_since_ns = now_ns();
+    pthread_mutex_lock(&s->conn_lock);
+    c->next = s->returned;
+    s->returned = c;
+    pthread_mutex_unlock(&s->conn_lock);
+    poller_wake(s);
+}
+
+// Connections the poller waits on, with a pollfd for each after the
+// listening socket and the wake pipe
+typedef struct {
+    Connection **conns;
+    struct pollfd *fds;
+    size_t count;
+    size_t capacity;
+} IdleSet;
+
+static void idle_add(IdleSet *set, Connection *c) {
+    if (set->count == set->capacity) {
+        set->capacity = set->capacity ? 2 * set->capacity : 64;
+        set->conns = realloc(set->conns, checked_mul(set->capacity, sizeof(Connection *)));
+        set->fds = realloc(set->fds, checked_mul(set->capacity + 2, sizeof(struct pollfd)));
+        if (!set->conns || !set->fds) {
+            fprintf(stderr, "Error: Out of memory\n");
+            exit(1);
+        }
+    }
+    set->conns[set->count++] = c;
+}
+
+// Accept every pending connection into the set. Returns when accept would
+// wait, or when the server runs out of descriptors; then the backlog is
+// left alone until *accept_after.
+static void accept_connections(Server *s, IdleSet *set, int64_t *accept_after) {
+    for (;;) {
+        int fd = accept(s->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) *accept_after = now_ns() + (int64_t)SERVE_POLL_MS * 1000000;
+            return;
+        }
+        // Headers and body go out as separate sends
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        Connection *c = checked_calloc(1, sizeof(Connection));
+        c->fd = fd;
+        c->idle_since_ns = now_ns();
+        idle_add(set, c);
+    }
+}
+
+// Poll the listening socket and every idle connection. New connections
+// join the set, connections with data go to the workers, and connections
+// idle for too long are closed.
+static void *poller_main(void *arg) {
+    Server *s = arg;
+    IdleSet set = {checked_alloc(64, sizeof(Connection *)), checked_alloc(64 + 2, sizeof(struct pollfd)), 0, 64};
+    int64_t accept_after = 0;
+    while (!__atomic_load_n(&s->stopping, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(&s->conn_lock);
+        Connection *back = s->returned;
+        s->returned = NULL;
+        pthread_mutex_unlock(&s->conn_lock);
+        while (back) {
+            Connection *next = back->next;
+            idle_add(&set, back);
+            back = next;
+        }
+
+        // poll skips negative descriptors
+        set.fds[0] = (struct pollfd){now_ns() >= accept_after ? s->listen_fd : -1, POLLIN, 0};
+        set.fds[1] = (struct pollfd){s->wake[0], POLLIN, 0};
+        for (size_t i = 0; i < set.count; i++) {
+            set.fds[i + 2] = (struct pollfd){set.conns[i]->fd, POLLIN, 0};
+        }
+        if (poll(set.fds, (nfds_t)(set.count + 2), SERVE_POLL_MS) < 0) continue;
+
+        if (set.fds[1].revents) {
+            char drain[64];
+            while (read(s->wake[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        int64_t now = now_ns();
+        size_t kept = 0;
+        for (size_t i = 0; i < set.count; i++) {
+            Connection *c = set.conns[i];
+            if (set.fds[i + 2].revents) {
+                hand_to_worker(s, c);
+            } else if (now - c->idle_since_ns >= (int64_t)SERVE_IDLE_MS * 1000000) {
+                connection_close(c);
+            } else {
+                set.conns[kept++] = c;
+            }
+        }
+        set.count = kept;
+        if (set.fds[0].revents) accept_connections(s, &set, &accept_after);
+    }
+    for (size_t i = 0; i < set.count; i++) {
+        connection_close(set.conns[i]);
+    }
+    free(set.conns);
+    free(set.fds);
+    return NULL;
+}
+
+// Read what the client sent and answer every complete request in it.
+// False when the connection is to be closed.
+static bool serve_connection(Worker *wk, Connection *c) {
+    char *buf = wk->request;
+    size_t len = c->pending_len;
+    if (len > 0) memcpy(buf, c->pending, len);
+    free(c->pending);
+    c->pending = NULL;
+    c->pending_len = 0;
+    // The poller saw data, so this does not wait. The buffer always has
+    // room, since a full one is either answered or refused below.
+    ssize_t n;
+    do {
+        n = recv(c->fd, buf + len, SERVE_REQUEST_MAX - len, MSG_DONTWAIT);
+    } while (n < 0 && errno == EINTR);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) return false;
+    if (n > 0) len += (size_t)n;
+
+    for (;;) {
+        // Headers, then the body they announce
+        char *blank = find_blank_line(buf, len);
+        if (!blank) {
+            if (len == SERVE_REQUEST_MAX) {
+                respond(wk, c->fd, fail(&wk->json, 413, "request_too_large"), 0, false);
+                return false;
+            }
+            break;
+        }
+        size_t headers_len = (size_t)(blank - buf) + 4;
+        size_t value_len;
+        const char *value = header_value(buf, headers_len, "Content-Length", &value_len);
+        size_t body_len = value ? (size_t)strtoull(value, NULL, 10) : 0;
+        if (body_len > SERVE_REQUEST_MAX - headers_len) {
+            respond(wk, c->fd, fail(&wk->json, 413, "request_too_large"), 0, false);
+            return false;
+        }
+        if (len < headers_len + body_len) break;
+
+        // Request line: method, target, version
+        const char *target = memchr(buf, ' ', headers_len);
+        const char *target_end = target ? memchr(target + 1, ' ', headers_len - (size_t)(target + 1 - buf)) : NULL;
+        if (!target_end) {
+            respond(wk, c->fd, fail(&wk->json, 400, "invalid_request"), 0, false);
+            return false;
+        }
+        target++;
+        bool keep_alive = strncmp(target_end, " HTTP/1.1", 9) == 0;
+        value = header_value(buf, headers_len, "Connection", &value_len);
+        if (value && value_len == 5 && strncasecmp(value, "close", 5) == 0) keep_alive = false;
+
+        Params params;
+        memset(&params, 0, sizeof(params));
+        const char *query = memchr(target, '?', (size_t)(target_end - target));
+        const char *path_end = query ? query : target_end;
+        if (query) parse_params(query + 1, (size_t)(target_end - query - 1), &params);
+        value = header_value(buf, headers_len, "Content-Type", &value_len);
+        if (body_len > 0 && (!value || strncasecmp(value, "application/x-www-form-urlencoded", 33) == 0)) {
+            parse_params(buf + headers_len, body_len, &params);
+        }
+
+        int retry_after = 0;
+        int status = dispatch(wk, target, (size_t)(path_end - target), &params, &retry_after);
+        respond(wk, c->fd, status, retry_after, keep_alive);
+        if (!keep_alive) return false;
+
+        // Keep what the client sent after this request
+        size_t used = headers_len + body_len;
+        memmove(buf, buf + used, len - used);
+        len -= used;
+    }
+    if (len > 0) {
+        c->pending = checked_alloc((int64_t)len, 1);
+        memcpy(c->pending, buf, len);
+        c->pending_len = len;
+    }
+    return true;
+}
+
+static void *serve_main(void *arg) {
+    Worker *wk = arg;
+    Server *s = wk->server;
+    Connection *c;
+    while ((c = take_ready(s)) != NULL) {
+        if (serve_connection(wk, c)) {
+            hand_to_poller(s, c);
+        } else {
+            connection_close(c);
+        }
+    }
+    return NULL;
+}
+
+// --- Lifecycle ---
+
+static int listen_local(int port, int *bound) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 64) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &addr_len) != 0) {
+        fprintf(stderr, "Error: Cannot serve on port %d: %s\n", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    *bound = ntohs(addr.sin_port);
+    return fd;
+}
+
+Server *serve_start(const ServeOptions *opts, const ServeData *data) {
+    Server *s = checked_calloc(1, sizeof(Server));
+    s->data = *data;
+    s->opts = *opts;
+    if (s->opts.workers < 1) s->opts.workers = 1;
+    s->listen_fd = listen_local(opts->port, &s->port);
+    if (s->listen_fd < 0) {
+        free(s);
+        return NULL;
+    }
+    // The poller accepts and reads until it would wait
+    if (pipe(s->wake) != 0) {
+        perror("pipe");
+        close(s->listen_fd);
+        free(s);
+        return NULL;
+    }
+    fcntl(s->listen_fd, F_SETFL, fcntl(s->listen_fd, F_GETFL) | O_NONBLOCK);
+    fcntl(s->wake[0], F_SETFL, fcntl(s->wake[0], F_GETFL) | O_NONBLOCK);
+    fcntl(s->wake[1], F_SETFL, fcntl(s->wake[1], F_GETFL) | O_NONBLOCK);
+    pthread_mutex_init(&s->conn_lock, NULL);
+    pthread_cond_init(&s->conn_ready, NULL);
+    pthread_mutex_init(&s->limit_lock, NULL);
+    int64_t now = now_ns();
+    for (int i = 0; i < API_METHODS; i++) {
+        s->buckets[i].tokens = opts->rate_limit;
+        s->buckets[i].updated_ns = now;
+    }
+
+    s->workers = checked_calloc(s->opts.workers, sizeof(Worker));
+    for (int i = 0; i < s->opts.workers; i++) {
+        Worker *wk = &s->workers[i];
+        wk->server = s;
+        history_reader_init(&wk->reader);
+        json_writer_init(&wk->json, 1 << 16);
+        wk->request = checked_alloc(SERVE_REQUEST_MAX, 1);
+        if (pthread_create(&wk->thread, NULL, serve_main, wk) != 0) {
+            fprintf(stderr, "Error: Cannot start server thread\n");
+            serve_stop(s);
+            return NULL;
+        }
+        wk->started = true;
+    }
+    if (pthread_create(&s->poller, NULL, poller_main, s) != 0) {
+        fprintf(stderr, "Error: Cannot start server thread\n");
+        serve_stop(s);
+        return NULL;
+    }
+    s->poller_started = true;
+    return s;
+}
+
+int serve_port(const Server *server) {
+    return server->port;
+}
+
+int64_t serve_stop(Server *s) {
+    // Workers finish the requests they are answering; waiting connections
+    // are closed unanswered
+    pthread_mutex_lock(&s->conn_lock);
+    __atomic_store_n(&s->stopping, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&s->conn_ready);
+    pthread_mutex_unlock(&s->conn_lock);
+    poller_wake(s);
+    if (s->poller_started) pthread_join(s->poller, NULL);
+    for (int i = 0; i < s->opts.workers; i++) {
+        Worker *wk = &s->workers[i];
+        if (wk->started) pthread_join(wk->thread, NULL);
+        if (wk->server) {
+            history_reader_free(&wk->reader);
+            json_writer_free(&wk->json);
+            reply_users_free(&wk->ru);
+            free(wk->request);
+        }
+    }
+    connections_close(s->ready);
+    connections_close(s->returned);
+    close(s->listen_fd);
+    close(s->wake[0]);
+    close(s->wake[1]);
+    pthread_mutex_destroy(&s->conn_lock);
+    pthread_cond_destroy(&s->conn_ready);
+    pthread_mutex_destroy(&s->limit_lock);
+    int64_t requests = s->requests;
+    free(s->workers);
+    free(s);
+    return requests;
+}
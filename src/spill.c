@@ -0,0 +1,278 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "spill.h"
+#include "radix_sort.h"
+#include "big_alloc.h"
+
+// Runs merged at once; more than this are first merged in groups, which
+// keeps file descriptors and per-run read buffers bounded.
+#define SPILL_MAX_FANIN 64
+#define SPILL_MIN_RECORDS 1024
+#define SPILL_MIN_BLOCK (64 * 1024)
+
+struct SpillRun {
+    FILE *file;
+    char *buf;
+    size_t block;          // Buffer size in bytes, a multiple of the record size
+    size_t len;            // Bytes in buf
+    size_t pos;            // Offset of the current record
+};
+
+FILE *spill_temp_file(const char *dir) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/syngen_spill_XXXXXX", dir ? dir : ".");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        exit(1);
+    }
+    unlink(path);
+    FILE *file = fdopen(fd, "w+b");
+    if (!file) {
+        perror("fdopen");
+        exit(1);
+    }
+    return file;
+}
+
+static void spill_write(FILE *file, const void *data, size_t size) {
+    if (fwrite(data, 1, size, file) != size) {
+        perror("Failed to write spill file");
+        exit(1);
+    }
+}
+
+static uint64_t record_key(const char *record) {
+    uint64_t key;
+    memcpy(&key, record, sizeof(key));
+    return key;
+}
+
+void spill_sorter_init(SpillSorter *sorter, size_t record_size, size_t memory, const char *dir, int workers) {
+    memset(sorter, 0, sizeof(*sorter));
+    sorter->record_size = record_size;
+    sorter->memory = memory;
+    sorter->dir = dir;
+    sorter->workers = workers;
+    
+    // Each buffered record also needs a key and an index, twice over while
+    // the radix sort runs
+    sorter->capacity = memory / (record_size + 2 * (sizeof(uint64_t) + sizeof(int64_t)));
+    if (sorter->capacity < SPILL_MIN_RECORDS) sorter->capacity = SPILL_MIN_RECORDS;
+    sorter->buffer = big_alloc((int64_t)sorter->capacity, record_size);
+}
+
+// Sorted order of the buffered records
+static int64_t *sort_buffer(SpillSorter *sorter) {
+    size_t n = sorter->count;
+    uint64_t *keys = big_alloc((int64_t)n, sizeof(uint64_t));
+    int64_t *order = big_alloc((int64_t)n, sizeof(int64_t));
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = record_key(sorter->buffer + i * sorter->record_size);
+        order[i] = (int64_t)i;
+    }
+    radix_sort_pairs(keys, order, n, sorter->workers);
+    big_free(keys);
+    return order;
+}
+
+static SpillRun *new_run(SpillSorter *sorter) {
+    if (sorter->run_count == sorter->run_capacity) {
+        sorter->run_capacity = sorter->run_capacity ? sorter->run_capacity * 2 : 16;
+        sorter->runs = realloc(sorter->runs, sizeof(SpillRun) * sorter->run_capacity);
+        if (!sorter->runs) {
+            fprintf(stderr, "Failed to allocate spill runs\n");
+            exit(1);
+        }
+    }
+    SpillRun *run = &sorter->runs[sorter->run_count++];
+    memset(run, 0, sizeof(*run));
+    run->file = spill_temp_file(sorter->dir);
+    return run;
+}
+
+static void flush_run(SpillSorter *sorter) {
+    int64_t *order = sort_buffer(sorter);
+    SpillRun *run = new_run(sorter);
+    size_t rs = sorter->record_size;
+    for (size_t i = 0; i < sorter->count; i++) {
+        spill_write(run->file, sorter->buffer + (size_t)order[i] * rs, rs);
+    }
+    big_free(order);
+    sorter->count = 0;
+}
+
+void spill_sorter_add(SpillSorter *sorter, const void *record) {
+    if (sorter->count == sorter->capacity) {
+        flush_run(sorter);
+    }
+    memcpy(sorter->buffer + sorter->count * sorter->record_size, record, sorter->record_size);
+    sorter->count++;
+}
+
+static void run_fill(SpillRun *run) {
+    run->len = fread(run->buf, 1, run->block, run->file);
+    run->pos = 0;
+}
+
+// Rewind a run for reading with a buffer of about block bytes
+static void run_open(SpillRun *run, size_t block, size_t record_size) {
+    block -= block % record_size;
+    if (block < record_size) block = record_size;
+    run->block = block;
+    run->buf = malloc(block);
+    if (!run->buf) {
+        fprintf(stderr, "Failed to allocate spill read buffer\n");
+        exit(1);
+    }
+    rewind(run->file);
+    run_fill(run);
+}
+
+static void run_close(SpillRun *run) {
+    fclose(run->file);
+    free(run->buf);
+    run->file = NULL;
+    run->buf = NULL;
+}
+
+static bool heap_less(const SpillRun *runs, size_t a, size_t b) {
+    uint64_t ka = record_key(runs[a].buf + runs[a].pos);
+    uint64_t kb = record_key(runs[b].buf + runs[b].pos);
+    return ka < kb || (ka == kb && a < b);
+}
+
+static void heap_sift_down(const SpillRun *runs, size_t *heap, size_t size, size_t i) {
+    for (;;) {
+        size_t left = 2 * i + 1;
+        if (left >= size) return;
+        size_t child = left;
+        if (left + 1 < size && heap_less(runs, heap[left + 1], heap[left])) child = left + 1;
+        if (!heap_less(runs, heap[child], heap[i])) return;
+        size_t t = heap[i];
+        heap[i] = heap[child];
+        heap[child] = t;
+        i = child;
+    }
+}
+
+// Open runs[0 .. n-1] and heapify the non-empty ones
+static size_t merge_start(SpillRun *runs, size_t n, size_t *heap, size_t block, size_t record_size) {
+    size_t size = 0;
+    for (size_t r = 0; r < n; r++) {
+        run_open(&runs[r], block, record_size);
+        if (runs[r].len > 0) heap[size++] = r;
+    }
+    for (size_t i = size / 2; i-- > 0; ) {
+        heap_sift_down(runs, heap, size, i);
+    }
+    return size;
+}
+
+// Emit the smallest head into out and advance its run
+static bool merge_pop(SpillRun *runs, size_t *heap, size_t *size, size_t record_size, void *out) {
+    if (*size == 0) return false;
+    SpillRun *run = &runs[heap[0]];
+    memcpy(out, run->buf + run->pos, record_size);
+    run->pos += record_size;
+    if (run->pos == run->len) {
+        run_fill(run);
+        if (run->len == 0) {
+            heap[0] = heap[--*size];
+        }
+    }
+    heap_sift_down(runs, heap, *size, 0);
+    return true;
+}
+
+// Merge consecutive groups of runs until at most SPILL_MAX_FANIN remain.
+// Groups keep their relative order, so equal keys stay in insertion order.
+static void merge_down(SpillSorter *sorter) {
+    size_t rs = sorter->record_size;
+    char *record = malloc(rs);
+    size_t *heap = malloc(sizeof(size_t) * SPILL_MAX_FANIN);
+    
+    while (sorter->run_count > SPILL_MAX_FANIN) {
+        SpillRun *old = sorter->runs;
+        size_t old_count = sorter->run_count;
+        sorter->runs = NULL;
+        sorter->run_count = 0;
+        sorter->run_capacity = 0;
+        
+        for (size_t first = 0; first < old_count; first += SPILL_MAX_FANIN) {
+            size_t n = old_count - first < SPILL_MAX_FANIN ? old_count - first : SPILL_MAX_FANIN;
+            size_t block = sorter->memory / (n + 1);
+            if (block < SPILL_MIN_BLOCK) block = SPILL_MIN_BLOCK;
+            
+            SpillRun *out = new_run(sorter);
+            size_t size = merge_start(old + first, n, heap, block, rs);
+            while (merge_pop(old + first, heap, &size, rs, record)) {
+                spill_write(out->file, record, rs);
+            }
+            for (size_t r = 0; r < n; r++) run_close(&old[first + r]);
+        }
+        free(old);
+    }
+    
+    free(heap);
+    free(record);
+}
+
+void spill_sorter_finish(SpillSorter *sorter) {
+    if (sorter->run_count == 0) {
+        // Everything fit: serve the buffer in sorted order
+        sorter->order = sort_buffer(sorter);
+        sorter->next = 0;
+        return;
+    }
+    
+    if (sorter->count > 0) flush_run(sorter);
+    big_free(sorter->buffer);
+    sorter->buffer = NULL;
+    
+    merge_down(sorter);
+    
+    size_t block = sorter->memory / sorter->run_count;
+    if (block < SPILL_MIN_BLOCK) block = SPILL_MIN_BLOCK;
+    sorter->heap = malloc(sizeof(size_t) * sorter->run_count);
+    sorter->heap_size = merge_start(sorter->runs, sorter->run_count, sorter->heap, block, sorter->record_size);
+}
+
+bool spill_sorter_next(SpillSorter *sorter, void *out) {
+    if (sorter->order) {
+        if (sorter->next == sorter->count) return false;
+        size_t i = (size_t)sorter->order[sorter->next++];
+        memcpy(out, sorter->buffer + i * sorter->record_size, sorter->record_size);
+        return true;
+    }
+    return merge_pop(sorter->runs, sorter->heap, &sorter->heap_size, sorter->record_size, out);
+}
+
+bool spill_sorter_peek(const SpillSorter *sorter, uint64_t *key) {
+    if (sorter->order) {
+        if (sorter->next == sorter->count) return false;
+        *key = record_key(sorter->buffer + (size_t)sorter->order[sorter->next] * sorter->record_size);
+        return true;
+    }
+    if (sorter->heap_size == 0) return false;
+    const SpillRun *run = &sorter->runs[sorter->heap[0]];
+    *key = record_key(run->buf + run->pos);
+    return true;
+}
+
+size_t spill_sorter_runs(const SpillSorter *sorter) {
+    return sorter->run_count;
+}
+
+void spill_sorter_free(SpillSorter *sorter) {
+    for (size_t r = 0; r < sorter->run_count; r++) {
+        if (sorter->runs[r].file) run_close(&sorter->runs[r]);
+    }
+    free(sorter->runs);
+    free(sorter->heap);
+    big_free(sorter->order);
+    big_free(sorter->buffer);
+    memset(sorter, 0, sizeof(*sorter));
+}
@@ -0,0 +1,394 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "syngen.h"
+#include "checked.h"
+#include "estimate.h"
+#include "progress.h"
+
+// Messages drawn beyond the calibrated count under target_bytes, as a
+// share of it, for the exporter to thin
+#define SYNGEN_TARGET_HEADROOM 0.05
+
+struct Syngen {
+    SyngenConfig config;        // With model.text pointing at the fields below
+    Vocabulary vocab;
+    Corpus corpus;
+    bool corpus_open;
+    ExportTarget target;
+    int64_t keep;               // Messages to keep under target_bytes
+    bool ran;
+    // While serving
+    Server *server;
+    IdKeys ids;
+    User *users;
+    Channel *channels;
+    History history;
+};
+
+void syngen_config_defaults(SyngenConfig *config) {
+    memset(config, 0, sizeof(*config));
+    config->users = 10;
+    config->channels = 25;
+    config->messages = 1000;
+    conversation_model_defaults(&config->model);
+    config->zipf = 1.0;
+    config->corpus_unit = CORPUS_LINES;
+    config->spill_dir = ".";
+    config->io = EXPORT_IO_AUTO;
+}
+
+static EstimateParams estimate_params(const Syngen *s) {
+    const SyngenConfig *c = &s->config;
+    EstimateParams params = {
+        .users = c->users,
+        .channels = c->channels,
+        .messages = c->target_bytes > 0 ? s->keep : c->messages,
+        .model = &c->model,
+        .max_memory = c->max_memory,
+        .unpacked = c->unpacked,
+        .seed = c->seed,
+        .log = c->log
+    };
+    return params;
+}
+
+Syngen *syngen_open(const SyngenConfig *config) {
+    if (config->users <= 0 || config->channels <= 0 || config->messages <= 0) {
+        fprintf(stderr, "Error: Counts must be positive integers.\n");
+        return NULL;
+    }
+    if (config->target_archive && (config->target_bytes == 0 || config->unpacked)) {
+        fprintf(stderr, "Error: --target-archive needs --target-bytes and a ZIP output\n");
+        return NULL;
+    }
+
+    Syngen *s = checked_calloc(1, sizeof(Syngen));
+    s->config = *config;
+    FILE *log = config->log;
+
+    // The vocabulary is keyed by a fixed seed so the same size always yields
+    // the same dictionary across runs.
+    if (config->vocab_size > 0) {
+        if (vocab_init(&s->vocab, config->vocab_size, config->zipf, 0) != 0) {
+            fprintf(stderr, "Error: Vocabulary size must be between 1 and %lld\n", VOCAB_MAX_SIZE);
+            free(s);
+            return NULL;
+        }
+        s->config.model.text.vocab = &s->vocab;
+        if (log) fprintf(log, "  Vocab:    %lld words (zipf %.2f)\n", (long long)config->vocab_size, config->zipf);
+    }
+    if (config->corpus_path) {
+        if (corpus_open(&s->corpus, config->corpus_path, config->corpus_unit) != 0) {
+            free(s);
+            return NULL;
+        }
+        s->corpus_open = true;
+        s->config.model.text.corpus = &s->corpus;
+        if (log) {
+            fprintf(log, "  Corpus:   %s (%llu %s)\n", config->corpus_path, (unsigned long long)s->corpus.count,
+                    config->corpus_unit == CORPUS_LINES ? "lines" : "sentences");
+        }
+    }
+
+    if (config->target_bytes > 0) {
+        // Calibrate on a sample, then draw some more messages than that so
+        // the exporter can land on the size by dropping threads
+        s->target.bytes = config->target_bytes;
+        s->target.archive = config->target_archive;
+        s->keep = config->messages;
+        EstimateParams params = estimate_params(s);
+        int64_t needed = estimate_messages_for(&params, &s->target);
+        if (needed < 0) {
+            fprintf(stderr, "Error: The users and channels alone exceed the target size\n");
+            syngen_close(s);
+            return NULL;
+        }
+        s->keep = needed;
+        s->config.messages = needed + (int64_t)((double)needed * SYNGEN_TARGET_HEADROOM) + 1;
+        s->target.keep = (double)needed / (double)s->config.messages;
+        if (log) {
+            fprintf(log, "  Messages: %lld drawn to keep about %lld\n", (long long)s->config.messages, (long long)needed);
+        }
+    }
+    return s;
+}
+
+int64_t syngen_messages(const Syngen *s) {
+    return s->config.messages;
+}
+
+void syngen_estimate(const Syngen *s, FILE *out) {
+    EstimateParams params = estimate_params(s);
+    estimate_print(&params, out);
+}
+
+uint64_t syngen_reached(const Syngen *s) {
+    return s->target.reached;
+}
+
+// --- Entity sinks ---
+
+// Messages copied out of a source until a batch is full. Text and reply
+// pointers are fixed up at delivery, since the buffers may still move.
+typedef struct {
+    StreamedMessage *messages;
+    size_t *text_offsets;
+    size_t *reply_offsets;
+    int64_t count;
+    char *text;
+    size_t text_len, text_capacity;
+    ReplyRef *replies;
+    size_t reply_len, reply_capacity;
+} MessageBatch;
+
+static void *grow_to(void *buf, size_t *capacity, size_t need, size_t size) {
+    if (need <= *capacity) return buf;
+    size_t cap = *capacity ? *capacity : 4096;
+    while (cap < need) cap = checked_mul(cap, 2);
+    void *grown = realloc(buf, checked_mul(cap, size));
+    if (!grown) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    *capacity = cap;
+    return grown;
+}
+
+static void batch_add(MessageBatch *b, const StreamedMessage *sm) {
+    const Message *m = &sm->msg;
+    size_t replies = (size_t)m->reply_count;
+    b->text = grow_to(b->text, &b->text_capacity, b->text_len + m->text_len, 1);
+    b->replies = grow_to(b->replies, &b->reply_capacity, b->reply_len + replies, sizeof(ReplyRef));
+    memcpy(b->text + b->text_len, m->text, m->text_len);
+    if (replies > 0) memcpy(b->replies + b->reply_len, sm->replies, replies * sizeof(ReplyRef));
+    b->messages[b->count] = *sm;
+    b->text_offsets[b->count] = b->text_len;
+    b->reply_offsets[b->count] = b->reply_len;
+    b->count++;
+    b->text_len += m->text_len;
+    b->reply_len += replies;
+}
+
+static int batch_flush(MessageBatch *b, const SyngenSink *sink) {
+    if (b->count == 0) return 0;
+    for (int64_t i = 0; i < b->count; i++) {
+        b->messages[i].msg.text = b->text + b->text_offsets[i];
+        b->messages[i].replies = b->replies + b->reply_offsets[i];
+    }
+    int status = sink->messages(sink->ctx, b->messages, b->count);
+    b->count = 0;
+    b->text_len = 0;
+    b->reply_len = 0;
+    return status;
+}
+
+static int deliver_entities(const SyngenSink *sink, const User *users, int64_t user_count,
+                            const Channel *channels, int64_t channel_count, MessageSource next, void *source) {
+    for (int64_t i = 0; sink->users && i < user_count; i += SYNGEN_BATCH) {
+        int64_t n = user_count - i < SYNGEN_BATCH ? user_count - i : SYNGEN_BATCH;
+        if (sink->users(sink->ctx, users + i, i, n) != 0) return -1;
+    }
+    for (int64_t i = 0; sink->channels && i < channel_count; i += SYNGEN_BATCH) {
+        int64_t n = channel_count - i < SYNGEN_BATCH ? channel_count - i : SYNGEN_BATCH;
+        if (sink->channels(sink->ctx, channels + i, i, n) != 0) return -1;
+    }
+    if (!sink->messages) return 0;
+
+    MessageBatch b;
+    memset(&b, 0, sizeof(b));
+    b.messages = checked_alloc(SYNGEN_BATCH, sizeof(StreamedMessage));
+    b.text_offsets = checked_alloc(SYNGEN_BATCH, sizeof(size_t));
+    b.reply_offsets = checked_alloc(SYNGEN_BATCH, sizeof(size_t));
+    StreamedMessage sm;
+    int status = 0;
+    while (status == 0 && next(source, &sm)) {
+        batch_add(&b, &sm);
+        progress_add(PROGRESS_EXPORTED, 1);
+        if (b.count == SYNGEN_BATCH) status = batch_flush(&b, sink);
+    }
+    if (status == 0) status = batch_flush(&b, sink);
+    free(b.messages);
+    free(b.text_offsets);
+    free(b.reply_offsets);
+    free(b.text);
+    free(b.replies);
+    return status != 0 ? -1 : 0;
+}
+
+// --- Runs ---
+
+// MessageSource adapter for the spill reader
+static bool next_spilled_message(void *source, StreamedMessage *out) {
+    return message_spill_next((MessageSpill *)source, out);
+}
+
+int syngen_run(Syngen *s, const SyngenSink *sink) {
+    const SyngenConfig *c = &s->config;
+    bool entities = sink && (sink->users || sink->channels || sink->messages);
+    bool files = sink && (sink->files.begin || sink->files.data || sink->files.end);
+    if (s->ran) {
+        fprintf(stderr, "Error: A syngen run cannot be repeated\n");
+        return -1;
+    }
+    if (entities && files) {
+        fprintf(stderr, "Error: A sink takes entities or files, not both\n");
+        return -1;
+    }
+    if (files && !(sink->files.begin && sink->files.data && sink->files.end)) {
+        fprintf(stderr, "Error: A file sink needs begin, data and end callbacks\n");
+        return -1;
+    }
+    if (entities && c->target_bytes > 0) {
+        fprintf(stderr, "Error: A size target applies to files, not entities\n");
+        return -1;
+    }
+    if (files && c->target_archive) {
+        fprintf(stderr, "Error: A file sink has no archive to size\n");
+        return -1;
+    }
+    if (!sink && !c->output) {
+        fprintf(stderr, "Error: Missing output filename.\n");
+        return -1;
+    }
+    s->ran = true;
+
+    Rng rng;
+    rng_seed(&rng, c->seed);
+    IdKeys ids;
+    id_keys_init(&ids, c->seed);
+
+    // Spill only when the messages would not fit the budget in memory
+    int64_t m_count = c->messages;
+    bool spill_messages = c->max_memory > 0 &&
+        (uint64_t)m_count > c->max_memory / GENERATOR_BYTES_PER_MESSAGE;
+
+    User *users = generate_users(&rng, c->users, &ids);
+    Channel *channels = generate_channels(&rng, c->channels, c->users, &ids);
+    TextArena text_arena;
+    text_arena_init(&text_arena, 0);
+    Message *messages = NULL;
+    ThreadIndex threads = {0};
+    MessageSpill *spill = NULL;
+    if (spill_messages) {
+        spill = generate_messages_spilled(&rng, m_count, channels, c->channels, c->users, &c->model,
+                                          c->max_memory, c->spill_dir);
+        if (!spill) {
+            free_channels(channels, c->channels);
+            free_users(users, c->users);
+            return -1;
+        }
+        if (c->log) {
+            progress_clear();
+            fprintf(c->log, "  Spilled:  %zu sorted runs\n", message_spill_runs(spill));
+        }
+    } else {
+        messages = generate_messages(&rng, m_count, channels, c->channels, c->users, &c->model, &text_arena);
+        generate_thread_index(messages, m_count, &threads);
+    }
+
+    ExportFileSink file_sink;
+    if (files) {
+        file_sink = sink->files;
+        file_sink.ctx = sink->ctx;
+    }
+    ExportOptions export_opts = {
+        .output = c->output,
+        .unpacked = c->unpacked,
+        .sync = c->sync,
+        .io = c->io,
+        .workers = c->model.workers,
+        .message_count = m_count,
+        .files = files ? &file_sink : NULL,
+        .target = c->target_bytes > 0 ? &s->target : NULL,
+        .log = c->log
+    };
+    MessageSource next = next_spilled_message;
+    void *source = spill;
+    SortedMessages sorted;
+    if (!spill) {
+        sorted_messages_init(&sorted, messages, m_count, &threads, c->model.workers);
+        next = sorted_messages_next;
+        source = &sorted;
+    }
+    int status;
+    if (entities) {
+        progress_phase(PROGRESS_PHASE_EXPORT, m_count);
+        status = deliver_entities(sink, users, c->users, channels, c->channels, next, source);
+    } else {
+        status = export_write(&export_opts, users, c->users, channels, c->channels, &ids, next, source);
+    }
+    if (!spill) sorted_messages_free(&sorted);
+
+    message_spill_free(spill);
+    free_thread_index(&threads);
+    free_messages(messages, m_count);
+    text_arena_free(&text_arena);
+    free_channels(channels, c->channels);
+    free_users(users, c->users);
+    return status;
+}
+
+// --- Serving ---
+
+int syngen_serve(Syngen *s, int port, int rate_limit) {
+    const SyngenConfig *c = &s->config;
+    if (s->ran) {
+        fprintf(stderr, "Error: A syngen run cannot be repeated\n");
+        return -1;
+    }
+    if (c->target_bytes > 0) {
+        fprintf(stderr, "Error: A size target applies to files, not to serving\n");
+        return -1;
+    }
+    s->ran = true;
+
+    // The same users and channels as an export of this seed
+    Rng rng;
+    rng_seed(&rng, c->seed);
+    id_keys_init(&s->ids, c->seed);
+    s->users = generate_users(&rng, c->users, &s->ids);
+    s->channels = generate_channels(&rng, c->channels, c->users, &s->ids);
+    history_init(&s->history, c->seed, c->messages, s->channels, c->channels, c->users, &c->model, time(NULL));
+
+    ServeOptions opts = {
+        .port = port,
+        .workers = c->model.workers,
+        .rate_limit = rate_limit
+    };
+    ServeData data = {
+        .users = s->users,
+        .user_count = c->users,
+        .channels = s->channels,
+        .channel_count = c->channels,
+        .ids = &s->ids,
+        .history = &s->history
+    };
+    s->server = serve_start(&opts, &data);
+    if (!s->server) return -1;
+    if (c->log) {
+        fprintf(c->log, "  History:  %lld top-level messages, %.2f replies each\n",
+                (long long)history_total(&s->history), s->history.replies_per_message);
+    }
+    return serve_port(s->server);
+}
+
+int64_t syngen_serve_stop(Syngen *s) {
+    if (!s->server) return 0;
+    int64_t requests = serve_stop(s->server);
+    s->server = NULL;
+    return requests;
+}
+
+void syngen_close(Syngen *s) {
+    if (!s) return;
+    syngen_serve_stop(s);
+    if (s->users) {
+        history_free(&s->history);
+        free_channels(s->channels, s->config.channels);
+        free_users(s->users, s->config.users);
+    }
+    if (s->corpus_open) corpus_close(&s->corpus);
+    free(s);
+}
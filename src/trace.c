@@ -0,0 +1,181 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "trace.h"
+
+#define TRACE_CHUNK_EVENTS 1024
+#define TRACE_DETAIL 56
+
+typedef struct {
+    const char *name;
+    int64_t begin;              // Nanoseconds on CLOCK_MONOTONIC
+    int64_t end;
+    char detail[TRACE_DETAIL];
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk *next;
+    int count;
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+typedef struct TraceBuffer {
+    struct TraceBuffer *next;   // Global list, pushed by compare-and-swap
+    int tid;
+    char name[32];
+    TraceChunk *head;           // Oldest chunk, for writing out
+    TraceChunk *tail;           // Chunk being filled
+} TraceBuffer;
+
+static FILE *trace_file = NULL;
+static bool trace_on = false;
+static int64_t trace_start = 0;
+static TraceBuffer *buffers = NULL;
+static int next_tid = 0;
+static __thread TraceBuffer *my_buffer = NULL;
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void *trace_alloc(size_t size) {
+    void *p = calloc(1, size);
+    if (!p) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+static TraceBuffer *thread_buffer(void) {
+    if (my_buffer) return my_buffer;
+    TraceBuffer *b = trace_alloc(sizeof(TraceBuffer));
+    b->tid = __atomic_add_fetch(&next_tid, 1, __ATOMIC_RELAXED);
+    b->head = b->tail = trace_alloc(sizeof(TraceChunk));
+    b->next = __atomic_load_n(&buffers, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&buffers, &b->next, b, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+    my_buffer = b;
+    return b;
+}
+
+int trace_open(const char *path) {
+    trace_file = fopen(path, "w");
+    if (!trace_file) {
+        perror(path);
+        return -1;
+    }
+    trace_start = now_ns();
+    trace_on = true;
+    trace_thread_name("main");
+    return 0;
+}
+
+void trace_thread_name(const char *fmt, ...) {
+    if (!trace_on) return;
+    TraceBuffer *b = thread_buffer();
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(b->name, sizeof(b->name), fmt, ap);
+    va_end(ap);
+}
+
+int64_t trace_clock(void) {
+    return trace_on ? now_ns() : 0;
+}
+
+void trace_span(const char *name, int64_t begin, const char *detail_fmt, ...) {
+    if (!trace_on) return;
+    TraceBuffer *b = thread_buffer();
+    if (b->tail->count == TRACE_CHUNK_EVENTS) {
+        TraceChunk *chunk = trace_alloc(sizeof(TraceChunk));
+        b->tail->next = chunk;
+        b->tail = chunk;
+    }
+    TraceEvent *e = &b->tail->events[b->tail->count++];
+    e->name = name;
+    e->begin = begin;
+    e->end = now_ns();
+    e->detail[0] = '\0';
+    if (detail_fmt) {
+        va_list ap;
+        va_start(ap, detail_fmt);
+        vsnprintf(e->detail, sizeof(e->detail), detail_fmt, ap);
+        va_end(ap);
+    }
+}
+
+// Details are file and channel names; escape what JSON requires anyway
+static void write_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', f);
+            fputc(c, f);
+        } else if (c < 0x20) {
+            fprintf(f, "\\u%04x", c);
+        } else {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+void trace_close(void) {
+    if (!trace_on) return;
+    trace_on = false;
+    FILE *f = trace_file;
+    int pid = (int)getpid();
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    bool first = true;
+    TraceBuffer *b = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE);
+    while (b) {
+        if (b->name[0]) {
+            fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                    first ? "" : ",\n", pid, b->tid);
+            write_string(f, b->name);
+            fputs("}}", f);
+            // Sort tracks in creation order, main first
+            fprintf(f, ",\n{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":%d,\"tid\":%d,\"args\":{\"sort_index\":%d}}",
+                    pid, b->tid, b->tid);
+            first = false;
+        }
+        for (TraceChunk *chunk = b->head; chunk; chunk = chunk->next) {
+            for (int i = 0; i < chunk->count; i++) {
+                const TraceEvent *e = &chunk->events[i];
+                // Microseconds since the trace started
+                fprintf(f, "%s{\"ph\":\"X\",\"name\":\"%s\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                        first ? "" : ",\n", e->name, pid, b->tid,
+                        (double)(e->begin - trace_start) / 1e3, (double)(e->end - e->begin) / 1e3);
+                if (e->detail[0]) {
+                    fputs(",\"args\":{\"detail\":", f);
+                    write_string(f, e->detail);
+                    fputc('}', f);
+                }
+                fputc('}', f);
+                first = false;
+            }
+        }
+        TraceBuffer *next = b->next;
+        while (b->head) {
+            TraceChunk *chunk = b->head;
+            b->head = chunk->next;
+            free(chunk);
+        }
+        free(b);
+        b = next;
+    }
+    fputs("\n]}\n", f);
+    if (fclose(f) != 0) perror("trace");
+    trace_file = NULL;
+    buffers = NULL;
+    my_buffer = NULL;
+}
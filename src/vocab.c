@@ -0,0 +1,112 @@
+#include <math.h>
+#include "vocab.h"
+
+// 20 consonants x 5 vowels = 100 two-letter syllables, so a word of k
+// syllables encodes a base-100 number of k digits.
+static const char vocab_consonants[] = "bcdfghjklmnprstvwxyz";
+static const char vocab_vowels[] = "aeiou";
+static const char vocab_codas[] = "nrstlmkd";
+
+#define VOCAB_SYLLABLES 100
+
+// Words with k syllables occupy ranks [class_start[k], class_start[k + 1])
+static const int64_t vocab_class_start[6] = {
+    0, 0, 100, 10100, 1010100, 101010100
+};
+static const int64_t vocab_class_size[5] = {
+    0, 100, 10000, 1000000, 100000000
+};
+
+// (exp(x) - 1) / x, accurate near 0
+static double helper2(double x) {
+    if (fabs(x) > 1e-8) return expm1(x) / x;
+    return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+// log(1 + x) / x, accurate near 0
+static double helper1(double x) {
+    if (fabs(x) > 1e-8) return log1p(x) / x;
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+// Integral of x^-s, shifted so the s == 1 case (log x) needs no special path
+static double h_integral(double s, double x) {
+    double log_x = log(x);
+    return helper2((1.0 - s) * log_x) * log_x;
+}
+
+static double h(double s, double x) {
+    return exp(-s * log(x));
+}
+
+static double h_integral_inverse(double s, double x) {
+    double t = x * (1.0 - s);
+    if (t < -1.0) t = -1.0; // Limit the argument to the domain of log1p
+    return exp(helper1(t) * x);
+}
+
+int vocab_init(Vocabulary *vocab, int64_t size, double exponent, uint64_t seed) {
+    if (size < 1 || size > VOCAB_MAX_SIZE || !(exponent > 0.0)) return -1;
+    
+    vocab->size = size;
+    vocab->exponent = exponent;
+    
+    // Affine permutations of each length class scatter consecutive ranks
+    // across the syllable space. The multiplier must be coprime to 100.
+    uint64_t x = seed;
+    for (int k = 1; k <= 4; k++) {
+        uint64_t m = (uint64_t)vocab_class_size[k];
+        uint64_t a = (rng_splitmix64(&x) % m) | 1;
+        if (a % 5 == 0) a = (a + 2) % m;
+        vocab->perm_mul[k] = a;
+        vocab->perm_add[k] = rng_splitmix64(&x) % m;
+    }
+    vocab->perm_mul[0] = vocab->perm_add[0] = 0;
+    
+    // Rejection-inversion sampling (Hormann & Derflinger) over ranks 1..size
+    double n = (double)size;
+    vocab->h_integral_x1 = h_integral(exponent, 1.5) - 1.0;
+    vocab->h_integral_n = h_integral(exponent, n + 0.5);
+    vocab->s = 2.0 - h_integral_inverse(exponent, h_integral(exponent, 2.5) - h(exponent, 2.0));
+    return 0;
+}
+
+int64_t vocab_sample(const Vocabulary *vocab, Rng *rng) {
+    double s = vocab->exponent;
+    for (;;) {
+        double u = vocab->h_integral_n + rng_uniform(rng) * (vocab->h_integral_x1 - vocab->h_integral_n);
+        double x = h_integral_inverse(s, u);
+        int64_t k = (int64_t)(x + 0.5);
+        if (k < 1) k = 1;
+        else if (k > vocab->size) k = vocab->size;
+        
+        if ((double)k - x <= vocab->s || u >= h_integral(s, (double)k + 0.5) - h(s, (double)k)) {
+            return k - 1;
+        }
+    }
+}
+
+size_t vocab_word(const Vocabulary *vocab, int64_t rank, char *out) {
+    int k = 1;
+    while (rank >= vocab_class_start[k + 1]) k++;
+    
+    uint64_t m = (uint64_t)vocab_class_size[k];
+    uint64_t idx = ((uint64_t)(rank - vocab_class_start[k]) * vocab->perm_mul[k] + vocab->perm_add[k]) % m;
+    
+    size_t len = 0;
+    uint64_t digits = idx;
+    for (int i = 0; i < k; i++) {
+        unsigned int syl = (unsigned int)(digits % VOCAB_SYLLABLES);
+        digits /= VOCAB_SYLLABLES;
+        out[len++] = vocab_consonants[syl / 5];
+        out[len++] = vocab_vowels[syl % 5];
+    }
+    
+    // Three in eight words end in a consonant. A coda makes the length odd
+    // (2k + 1), so it can never collide with a word from another class.
+    uint64_t mix = idx * 0x9E3779B97F4A7C15ULL;
+    if ((mix >> 61) < 3) {
+        out[len++] = vocab_codas[(mix >> 40) % (sizeof(vocab_codas) - 1)];
+    }
+    return len;
+}
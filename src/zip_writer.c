@@ -0,0 +1,281 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zlib.h>
+#include "zip_writer.h"
+
+#define ZIP_LOCAL_SIG 0x04034b50u
+#define ZIP_DESCRIPTOR_SIG 0x08074b50u
+#define ZIP_CENTRAL_SIG 0x02014b50u
+#define ZIP_END_SIG 0x06054b50u
+#define ZIP64_END_SIG 0x06064b50u
+#define ZIP64_LOCATOR_SIG 0x07064b50u
+
+#define ZIP_FLAG_DESCRIPTOR 0x0008
+#define ZIP_METHOD_STORED 0
+#define ZIP_METHOD_DEFLATED 8
+#define ZIP_MADE_BY_UNIX (3 << 8)
+
+// --- Little-endian output ---
+
+static void flush_buffer(ZipWriter *zw) {
+    export_file_write(zw->dir, zw->file, zw->buf, zw->buf_len);
+    zw->buf_len = 0;
+}
+
+static void put_bytes(ZipWriter *zw, const void *data, size_t len) {
+    if (zw->buf_len + len > EXPORT_IO_BUFFER) {
+        flush_buffer(zw);
+        if (len >= EXPORT_IO_BUFFER) {
+            // Large pieces go straight to the file
+            export_file_write(zw->dir, zw->file, data, len);
+            zw->offset += len;
+            return;
+        }
+    }
+    memcpy(zw->buf + zw->buf_len, data, len);
+    zw->buf_len += len;
+    zw->offset += len;
+}
+
+static void put16(ZipWriter *zw, uint32_t v) {
+    unsigned char b[2] = {(unsigned char)v, (unsigned char)(v >> 8)};
+    put_bytes(zw, b, 2);
+}
+
+static void put32(ZipWriter *zw, uint32_t v) {
+    unsigned char b[4] = {(unsigned char)v, (unsigned char)(v >> 8), (unsigned char)(v >> 16), (unsigned char)(v >> 24)};
+    put_bytes(zw, b, 4);
+}
+
+static void put64(ZipWriter *zw, uint64_t v) {
+    put32(zw, (uint32_t)v);
+    put32(zw, (uint32_t)(v >> 32));
+}
+
+// --- Members ---
+
+int zip_writer_open(ZipWriter *zw, ExportDir *dir, const char *path) {
+    memset(zw, 0, sizeof(*zw));
+    zw->dir = dir;
+    zw->file = export_file_create(dir, dir->fd, path);
+    if (!zw->file) return -1;
+    zw->buf = malloc(EXPORT_IO_BUFFER);
+    if (!zw->buf) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    text_arena_init(&zw->names, 0);
+
+    // Every member gets the archive's creation time
+    time_t now = time(NULL);
+    struct tm tm;
+    localtime_r(&now, &tm);
+    zw->dos_time = (uint16_t)(tm.tm_hour << 11 | tm.tm_min << 5 | tm.tm_sec / 2);
+    zw->dos_date = (uint16_t)((tm.tm_year - 80) << 9 | (tm.tm_mon + 1) << 5 | tm.tm_mday);
+    return 0;
+}
+
+static ZipEntry *add_entry(ZipWriter *zw, const char *name, bool directory) {
+    if (zw->count == zw->capacity) {
+        zw->capacity = zw->capacity ? zw->capacity * 2 : 1024;
+        zw->entries = realloc(zw->entries, sizeof(ZipEntry) * zw->capacity);
+        if (!zw->entries) {
+            fprintf(stderr, "Error: Out of memory\n");
+            exit(1);
+        }
+    }
+    size_t len = strlen(name);
+    char *copy = text_arena_reserve(&zw->names, len + 1);
+    memcpy(copy, name, len + 1);
+    text_arena_commit(&zw->names, len + 1);
+
+    ZipEntry *e = &zw->entries[zw->count++];
+    memset(e, 0, sizeof(*e));
+    e->name = copy;
+    e->offset = zw->offset;
+    e->directory = directory;
+    // Matches put_central_entry
+    zw->central_size += 46 + len + (e->offset >= UINT32_MAX ? 12 : 0);
+    return e;
+}
+
+static void put_local_header(ZipWriter *zw, const ZipEntry *e) {
+    size_t name_len = strlen(e->name);
+    put32(zw, ZIP_LOCAL_SIG);
+    put16(zw, 20);                                  // Version needed
+    put16(zw, e->directory ? 0 : ZIP_FLAG_DESCRIPTOR);
+    put16(zw, e->directory ? ZIP_METHOD_STORED : ZIP_METHOD_DEFLATED);
+    put16(zw, zw->dos_time);
+    put16(zw, zw->dos_date);
+    put32(zw, 0);                                   // CRC, sizes: in the descriptor
+    put32(zw, 0);
+    put32(zw, 0);
+    put16(zw, (uint32_t)name_len);
+    put16(zw, 0);                                   // Extra field length
+    put_bytes(zw, e->name, name_len);
+}
+
+void zip_begin_file(ZipWriter *zw, const char *name) {
+    const ZipEntry *e = add_entry(zw, name, false);
+    put_local_header(zw, e);
+    zw->crc = 0;
+    zw->packed_size = 0;
+    zw->size = 0;
+}
+
+void zip_file_data(ZipWriter *zw, const char *packed, size_t packed_len, uint32_t crc, size_t size) {
+    put_bytes(zw, packed, packed_len);
+    zw->crc = (uint32_t)crc32_combine(zw->crc, crc, (z_off_t)size);
+    zw->packed_size += packed_len;
+    zw->size += size;
+}
+
+void zip_end_file(ZipWriter *zw) {
+    ZipEntry *e = &zw->entries[zw->count - 1];
+    if (zw->size > UINT32_MAX || zw->packed_size > UINT32_MAX) {
+        fprintf(stderr, "Error: %s is larger than 4 GiB\n", e->name);
+        exit(1);
+    }
+    e->crc = zw->crc;
+    e->packed_size = (uint32_t)zw->packed_size;
+    e->size = (uint32_t)zw->size;
+    put32(zw, ZIP_DESCRIPTOR_SIG);
+    put32(zw, e->crc);
+    put32(zw, e->packed_size);
+    put32(zw, e->size);
+}
+
+void zip_add_directory(ZipWriter *zw, const char *name) {
+    const ZipEntry *e = add_entry(zw, name, true);
+    put_local_header(zw, e);
+}
+
+// --- Central directory ---
+
+static void put_central_entry(ZipWriter *zw, const ZipEntry *e) {
+    size_t name_len = strlen(e->name);
+    bool far = e->offset >= UINT32_MAX;
+    uint32_t version = far ? 45 : 20;
+    put32(zw, ZIP_CENTRAL_SIG);
+    put16(zw, ZIP_MADE_BY_UNIX | version);
+    put16(zw, version);
+    put16(zw, e->directory ? 0 : ZIP_FLAG_DESCRIPTOR);
+    put16(zw, e->directory ? ZIP_METHOD_STORED : ZIP_METHOD_DEFLATED);
+    put16(zw, zw->dos_time);
+    put16(zw, zw->dos_date);
+    put32(zw, e->crc);
+    put32(zw, e->packed_size);
+    put32(zw, e->size);
+    put16(zw, (uint32_t)name_len);
+    put16(zw, far ? 12 : 0);                        // Extra field length
+    put16(zw, 0);                                   // Comment length
+    put16(zw, 0);                                   // Disk number
+    put16(zw, 0);                                   // Internal attributes
+    // Unix mode in the high half, MS-DOS directory bit in the low
+    put32(zw, e->directory ? (040755u << 16 | 0x10) : 0100644u << 16);
+    put32(zw, far ? UINT32_MAX : (uint32_t)e->offset);
+    put_bytes(zw, e->name, name_len);
+    if (far) {
+        put16(zw, 0x0001);                          // Zip64 extended information
+        put16(zw, 8);
+        put64(zw, e->offset);
+    }
+}
+
+uint64_t zip_writer_size(const ZipWriter *zw) {
+    uint64_t central_offset = zw->offset;
+    uint64_t size = central_offset + zw->central_size + 22;
+    if (zw->count >= 0xFFFF || central_offset >= UINT32_MAX || zw->central_size >= UINT32_MAX) {
+        size += 56 + 20;                            // Zip64 end record and locator
+    }
+    return size;
+}
+
+void zip_writer_close(ZipWriter *zw) {
+    uint64_t central_offset = zw->offset;
+    for (size_t i = 0; i < zw->count; i++) {
+        put_central_entry(zw, &zw->entries[i]);
+    }
+    uint64_t central_size = zw->offset - central_offset;
+
+    bool zip64 = zw->count >= 0xFFFF || central_offset >= UINT32_MAX || central_size >= UINT32_MAX;
+    if (zip64) {
+        uint64_t end64_offset = zw->offset;
+        put32(zw, ZIP64_END_SIG);
+        put64(zw, 44);                              // Size of the rest of the record
+        put16(zw, ZIP_MADE_BY_UNIX | 45);
+        put16(zw, 45);
+        put32(zw, 0);                               // This disk
+        put32(zw, 0);                               // Disk with the central directory
+        put64(zw, zw->count);
+        put64(zw, zw->count);
+        put64(zw, central_size);
+        put64(zw, central_offset);
+
+        put32(zw, ZIP64_LOCATOR_SIG);
+        put32(zw, 0);
+        put64(zw, end64_offset);
+        put32(zw, 1);                               // Total disks
+    }
+
+    put32(zw, ZIP_END_SIG);
+    put16(zw, 0);
+    put16(zw, 0);
+    put16(zw, zip64 ? 0xFFFF : (uint32_t)zw->count);
+    put16(zw, zip64 ? 0xFFFF : (uint32_t)zw->count);
+    put32(zw, zip64 ? UINT32_MAX : (uint32_t)central_size);
+    put32(zw, zip64 ? UINT32_MAX : (uint32_t)central_offset);
+    put16(zw, 0);                                   // Comment length
+
+    flush_buffer(zw);
+    export_file_close(zw->dir, zw->file);
+    free(zw->buf);
+    free(zw->entries);
+    text_arena_free(&zw->names);
+}
+
+// --- Compression ---
+
+void *zip_deflate_new(void) {
+    z_stream *z = calloc(1, sizeof(z_stream));
+    if (!z || deflateInit2(z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        fprintf(stderr, "Error: Cannot initialise zlib\n");
+        exit(1);
+    }
+    return z;
+}
+
+void zip_deflate_free(void *stream) {
+    deflateEnd(stream);
+    free(stream);
+}
+
+size_t zip_deflate(void *stream, const char *data, size_t len, bool last, char **out, size_t *out_capacity, uint32_t *crc) {
+    z_stream *z = stream;
+    *crc = (uint32_t)crc32(0, (const Bytef *)data, (uInt)len);
+    deflateReset(z);
+    // deflateBound covers Z_FINISH; a sync flush adds an empty stored block
+    size_t bound = deflateBound(z, (uLong)len) + 16;
+    if (bound > *out_capacity) {
+        free(*out);
+        *out = malloc(bound);
+        if (!*out) {
+            fprintf(stderr, "Error: Out of memory\n");
+            exit(1);
+        }
+        *out_capacity = bound;
+    }
+    z->next_in = (Bytef *)(uintptr_t)data;
+    z->avail_in = (uInt)len;
+    z->next_out = (Bytef *)*out;
+    z->avail_out = (uInt)bound;
+    int ret = deflate(z, last ? Z_FINISH : Z_SYNC_FLUSH);
+    if (ret == Z_STREAM_ERROR || z->avail_in != 0 || (last && ret != Z_STREAM_END)) {
+        fprintf(stderr, "Error: Compression failed\n");
+        exit(1);
+    }
+    return bound - z->avail_out;
+}
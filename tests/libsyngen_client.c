@@ -0,0 +1,90 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "syngen.h"
+
+// Embeds libsyngen: counts the entities of one run, then writes the files
+// of a second run into a directory through the file sink.
+// Usage: libsyngen_client <dir> <channels> <messages> <users> <seed>
+
+typedef struct {
+    const char *dir;
+    FILE *file;
+    int64_t users;
+    int64_t messages;
+} Client;
+
+static int count_users(void *ctx, const User *users, int64_t first, int64_t count) {
+    (void)users;
+    Client *c = ctx;
+    if (first != c->users) return -1;
+    c->users += count;
+    return 0;
+}
+
+static int count_messages(void *ctx, const StreamedMessage *messages, int64_t count) {
+    Client *c = ctx;
+    for (int64_t i = 0; i < count; i++) {
+        if (messages[i].msg.user_idx < 0 || messages[i].msg.user_idx >= c->users) return -1;
+    }
+    c->messages += count;
+    return 0;
+}
+
+static int file_begin(void *ctx, const char *path) {
+    Client *c = ctx;
+    char full[512];
+    snprintf(full, sizeof(full), "%s/%s", c->dir, path);
+    char *slash = strrchr(full, '/');
+    *slash = '\0';
+    mkdir(full, 0755);
+    *slash = '/';
+    c->file = fopen(full, "w");
+    return c->file ? 0 : -1;
+}
+
+static int file_data(void *ctx, const char *data, size_t len) {
+    Client *c = ctx;
+    return fwrite(data, 1, len, c->file) == len ? 0 : -1;
+}
+
+static int file_end(void *ctx) {
+    Client *c = ctx;
+    return fclose(c->file) == 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 6) {
+        fprintf(stderr, "Usage: %s <dir> <channels> <messages> <users> <seed>\n", argv[0]);
+        return 1;
+    }
+    SyngenConfig config;
+    syngen_config_defaults(&config);
+    config.channels = atoll(argv[2]);
+    config.messages = atoll(argv[3]);
+    config.users = atoll(argv[4]);
+    config.seed = strtoull(argv[5], NULL, 0);
+
+    Client client = {argv[1], NULL, 0, 0};
+    SyngenSink entities = {0};
+    entities.ctx = &client;
+    entities.users = count_users;
+    entities.messages = count_messages;
+    Syngen *run = syngen_open(&config);
+    if (!run || syngen_run(run, &entities) != 0) return 1;
+    syngen_close(run);
+    printf("%lld users, %lld messages\n", (long long)client.users, (long long)client.messages);
+
+    mkdir(client.dir, 0755);
+    SyngenSink files = {0};
+    files.ctx = &client;
+    files.files.begin = file_begin;
+    files.files.data = file_data;
+    files.files.end = file_end;
+    run = syngen_open(&config);
+    if (!run || syngen_run(run, &files) != 0) return 1;
+    syngen_close(run);
+    return 0;
+}
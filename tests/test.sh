@@ -85,6 +85,264 @@ fi
 # to have at least one thread or reply if generator works. 
 # But with small sample size, might be 0.
 
+# 4. Spill path: a tiny memory budget forces sorted runs on disk
+echo "Running syngen with --max-memory..."
+rm -f $OUTPUT_ZIP
+rm -rf $EXTRACT_DIR
+$BINARY -c 5 -m 20000 -u 8 -s 1 --max-memory 64K $OUTPUT_ZIP > /dev/null
+if [ $? -ne 0 ]; then
+    echo "Error: syngen execution with --max-memory failed."
+    exit 1
+fi
+unzip -q $OUTPUT_ZIP -d $EXTRACT_DIR
+SPILLED_COUNT=$(find "$EXTRACT_DIR" -mindepth 2 -name "*.json" -exec grep -h "\"type\":" {} + | wc -l)
+echo "Found $SPILLED_COUNT spilled messages (expected 20000)"
+if [ "$SPILLED_COUNT" -ne 20000 ]; then
+    echo "Error: Spilled message count mismatch."
+    exit 1
+fi
+# Hex output is pinned: every build must give seed 1 the same avatars
+if ! grep -q '"avatar_hash":.*"a7a366c27b1c2e647336239ae2487ab2"' "$EXTRACT_DIR/users.json"; then
+    echo "Error: Seed 1 no longer yields the known avatar hash."
+    exit 1
+fi
+
+# An estimate prints its figures and writes nothing
+echo "Running syngen with --estimate..."
+rm -f test_estimate.zip
+if ! $BINARY -c 5 -m 20000 -u 8 -s 1 --estimate test_estimate.zip | grep -q "^  Archive: "; then
+    echo "Error: --estimate printed no estimate."
+    exit 1
+fi
+if [ -e test_estimate.zip ]; then
+    echo "Error: --estimate wrote output."
+    exit 1
+fi
+
+echo "Running syngen with --target-bytes..."
+rm -f test_target.zip
+$BINARY -c 5 -u 8 -s 1 --target-bytes 2M --target-archive test_target.zip > /dev/null
+if [ $? -ne 0 ]; then
+    echo "Error: syngen execution with --target-bytes failed."
+    exit 1
+fi
+TARGET_SIZE=$(wc -c < test_target.zip)
+if [ "$TARGET_SIZE" -lt 2076180 ] || [ "$TARGET_SIZE" -gt 2118124 ]; then
+    echo "Error: --target-bytes 2M produced $TARGET_SIZE bytes."
+    exit 1
+fi
+rm -f test_target.zip
+
+# 5. Unpacked output holds the same files as the archive
+echo "Running syngen with --unpacked..."
+UNPACKED_DIR="test_unpacked"
+rm -rf $UNPACKED_DIR
+$BINARY -c 5 -m 20000 -u 8 -s 1 --max-memory 64K --unpacked $UNPACKED_DIR > /dev/null
+if [ $? -ne 0 ]; then
+    echo "Error: syngen execution with --unpacked failed."
+    exit 1
+fi
+if [ "$(cd $EXTRACT_DIR && find . | sort)" != "$(cd $UNPACKED_DIR && find . | sort)" ]; then
+    echo "Error: Unpacked output differs from the archive."
+    exit 1
+fi
+rm -rf $UNPACKED_DIR
+
+# The pwrite thread pool (the fallback without io_uring) and synchronous
+# writes produce the same files
+for IO in "threads --fsync" "sync"; do
+    echo "Running syngen with --io $IO..."
+    $BINARY -c 5 -m 20000 -u 8 -s 1 --io $IO --unpacked $UNPACKED_DIR > /dev/null
+    if [ $? -ne 0 ]; then
+        echo "Error: syngen execution with --io $IO failed."
+        exit 1
+    fi
+    if [ "$(cd $EXTRACT_DIR && find . | sort)" != "$(cd $UNPACKED_DIR && find . | sort)" ]; then
+        echo "Error: --io $IO output differs from the archive."
+        exit 1
+    fi
+    rm -rf $UNPACKED_DIR
+done
+
+# Failed writes must fail the run, with every backend: a full disk, and a
+# file that cannot be created because a directory holds its name
+for IO in uring threads sync; do
+    echo "Running syngen with --io $IO on a full disk..."
+    if $BINARY -c 5 -m 20000 -u 8 -s 1 --io $IO /dev/full > /dev/null 2>&1; then
+        echo "Error: Writing to a full disk with --io $IO reported success."
+        exit 1
+    fi
+done
+mkdir -p $UNPACKED_DIR/users.json
+if $BINARY -c 5 -m 20000 -u 8 -s 1 --unpacked $UNPACKED_DIR > /dev/null 2>&1; then
+    echo "Error: An export missing users.json reported success."
+    exit 1
+fi
+rm -rf $UNPACKED_DIR
+
+# Synthetic vocabulary: every message gets text from it
+echo "Running syngen with --vocab-size and --zipf..."
+VOCAB_DIR="test_vocab"
+rm -rf $VOCAB_DIR
+$BINARY -c 3 -m 2000 -u 5 -s 1 --vocab-size 500 --zipf 1.2 --unpacked $VOCAB_DIR > /dev/null
+if [ $? -ne 0 ]; then
+    echo "Error: syngen execution with --vocab-size failed."
+    exit 1
+fi
+VOCAB_MESSAGES=$(find $VOCAB_DIR -mindepth 2 -name "*.json" -exec grep -h '"type":' {} + | wc -l)
+VOCAB_TEXTS=$(find $VOCAB_DIR -mindepth 2 -name "*.json" -exec grep -h '"text":[[:space:]]*"[^"]' {} + | wc -l)
+if [ "$VOCAB_MESSAGES" -ne 2000 ] || [ "$VOCAB_TEXTS" -ne 2000 ]; then
+    echo "Error: --vocab-size gave $VOCAB_TEXTS texts for $VOCAB_MESSAGES messages."
+    exit 1
+fi
+rm -rf $VOCAB_DIR
+if $BINARY -c 3 -m 100 -u 5 --vocab-size 0 $VOCAB_DIR > /dev/null 2>&1 ||
+   $BINARY -c 3 -m 100 -u 5 --zipf 0 $VOCAB_DIR > /dev/null 2>&1; then
+    echo "Error: --vocab-size 0 or --zipf 0 was accepted."
+    exit 1
+fi
+
+# Corpus text: messages quote whole lines, or whole sentences
+echo "Running syngen with --corpus..."
+CORPUS_DIR="test_corpus"
+corpus_texts() {
+    find $CORPUS_DIR -mindepth 2 -name "*.json" -exec sed -n 's/.*"text":[[:space:]]*"\(.*\)",\{0,1\}$/\1/p' {} +
+}
+rm -rf $CORPUS_DIR
+$BINARY -c 3 -m 300 -u 5 -s 1 --corpus tests/corpus.txt --unpacked $CORPUS_DIR > /dev/null
+if [ $? -ne 0 ] || [ "$(corpus_texts | wc -l)" -ne 300 ] || corpus_texts | grep -qvxF -f <(grep . tests/corpus.txt); then
+    echo "Error: --corpus texts are not the corpus lines."
+    exit 1
+fi
+rm -rf $CORPUS_DIR
+CORPUS_SENTENCES=$(printf '%s\n' "Deploy finished on staging." "Smoke tests are green." "Who owns the billing dashboard?" \
+    "Rolling back the last release!" "Error rates doubled." "Lunch order closes at noon.")
+$BINARY -c 3 -m 300 -u 5 -s 1 --corpus tests/corpus.txt --corpus-sentences --unpacked $CORPUS_DIR > /dev/null
+if [ $? -ne 0 ] || [ "$(corpus_texts | wc -l)" -ne 300 ] || corpus_texts | grep -qvxF "$CORPUS_SENTENCES"; then
+    echo "Error: --corpus-sentences texts are not the corpus sentences."
+    exit 1
+fi
+rm -rf $CORPUS_DIR
+if $BINARY -c 3 -m 100 -u 5 --corpus tests/missing_corpus.txt $CORPUS_DIR > /dev/null 2>&1 || [ -e $CORPUS_DIR ]; then
+    echo "Error: A missing corpus file did not fail cleanly."
+    exit 1
+fi
+
+echo "Running a libsyngen client..."
+CLIENT=./test_libsyngen_client
+CLIENT_DIR="test_libsyngen"
+rm -rf $CLIENT_DIR
+${CC:-cc} -std=c99 -Iinclude -o $CLIENT tests/libsyngen_client.c lib/libsyngen.a -lm -lz -pthread
+if [ $? -ne 0 ]; then
+    echo "Error: Cannot build against libsyngen."
+    exit 1
+fi
+if [ "$($CLIENT $CLIENT_DIR 5 20000 8 1)" != "8 users, 20000 messages" ]; then
+    echo "Error: Entity sink missed users or messages."
+    exit 1
+fi
+if [ "$(cd $EXTRACT_DIR && find . -type f | sort)" != "$(cd $CLIENT_DIR && find . -type f | sort)" ]; then
+    echo "Error: File sink output differs from the archive."
+    exit 1
+fi
+rm -rf $CLIENT $CLIENT_DIR
+
+echo "Running syngen with --progress, --trace and --metrics-file..."
+PROGRESS_ZIP="test_progress.zip"
+TRACE_FILE="test_trace.json"
+METRICS_FILE="test_metrics.prom"
+PROGRESS_LOG=$($BINARY -c 5 -m 20000 -u 8 -s 1 --progress 0.05 --trace $TRACE_FILE --metrics-file $METRICS_FILE $PROGRESS_ZIP 2>&1 > /dev/null)
+if ! echo "$PROGRESS_LOG" | grep -q '"event":"done".*"done":20000,"total":20000'; then
+    echo "Error: Final progress report missing or incomplete."
+    exit 1
+fi
+if ! grep -q '"name":"serialise"' $TRACE_FILE; then
+    echo "Error: Trace has no serialisation spans."
+    exit 1
+fi
+if ! grep -q '^syngen_messages_exported_total 20000$' $METRICS_FILE; then
+    echo "Error: Metrics file missing the exported message count."
+    exit 1
+fi
+rm -f $PROGRESS_ZIP $TRACE_FILE $METRICS_FILE
+
+# Calibrating a size target on samples must not count towards the metrics
+$BINARY -c 5 -u 8 -s 1 --target-bytes 2M --metrics-file $METRICS_FILE $PROGRESS_ZIP > /dev/null
+TARGET_MESSAGES=$(unzip -p $PROGRESS_ZIP '*/*.json' | grep -c '"type":')
+TARGET_FILES=$(unzip -Z1 $PROGRESS_ZIP | grep -vc '/$')
+if ! grep -q "^syngen_messages_exported_total $TARGET_MESSAGES\$" $METRICS_FILE || \
+   ! grep -q "^syngen_files_written_total $TARGET_FILES\$" $METRICS_FILE || \
+   ! grep -q '^syngen_users_generated_total 8$' $METRICS_FILE; then
+    echo "Error: Metrics of a --target-bytes run count more than its output."
+    exit 1
+fi
+rm -f $PROGRESS_ZIP $METRICS_FILE
+
+echo "Serving the Slack Web API..."
+SERVE_LOG="test_serve.log"
+$BINARY serve -c 5 -m 20000 -u 8 -s 1 -j 1 --port 0 > $SERVE_LOG &
+SERVE_PID=$!
+for i in $(seq 100); do
+    grep -q '^Serving' $SERVE_LOG && break
+    sleep 0.1
+done
+API=$(sed -n 's/^Serving: \([^ ]*\) .*/\1/p' $SERVE_LOG)
+if [ -z "$API" ]; then
+    echo "Error: syngen serve did not start."
+    kill $SERVE_PID
+    exit 1
+fi
+# An idle keep-alive connection must not hold the only server thread
+exec 3<>/dev/tcp/127.0.0.1/$(echo "$API" | sed 's/.*:\([0-9]*\)\/.*/\1/')
+printf 'GET /api/users.list?limit=1 HTTP/1.1\r\nHost: localhost\r\n\r\n' >&3
+IDLE_STATUS=$(timeout 5 head -1 <&3)
+BUSY_STATUS=$(curl -s -m 5 -o /dev/null -w '%{http_code}' "${API}users.list?limit=1")
+if [ "$IDLE_STATUS" != $'HTTP/1.1 200 OK\r' ] || [ "$BUSY_STATUS" != "200" ]; then
+    echo "Error: A second client was not served while a keep-alive connection sat idle."
+    exec 3<&-
+    kill $SERVE_PID
+    exit 1
+fi
+exec 3<&-
+# Walk a paginated method, printing each page
+api_pages() {
+    local cursor=""
+    while :; do
+        local page=$(curl -s "$API$1&cursor=${cursor//+/%2B}")
+        echo "$page"
+        cursor=$(echo "$page" | sed -n 's/.*"next_cursor":[[:space:]]*"\(.*\)".*/\1/p')
+        [ -n "$cursor" ] || break
+    done
+}
+SERVED_USERS=$(api_pages "users.list?limit=3" | grep -c '"team_id":')
+SERVED_MESSAGES=0
+for CHANNEL in $(api_pages "conversations.list?limit=2" | sed -n 's/.*"id":[[:space:]]*"\(C[^"]*\)".*/\1/p'); do
+    COUNT=$(api_pages "conversations.history?channel=$CHANNEL&limit=400" | grep -c '"type":')
+    SERVED_MESSAGES=$((SERVED_MESSAGES + COUNT))
+    THREAD_TS=${THREAD_TS:-$(curl -s "${API}conversations.history?channel=$CHANNEL&limit=1000" | grep -B6 '"reply_count":' | sed -n 's/.*"thread_ts":[[:space:]]*"\(.*\)".*/\1/p' | head -1)}
+    THREAD_CHANNEL=${THREAD_CHANNEL:-$CHANNEL}
+done
+TOP_LEVEL=$(sed -n 's/^  History:  \([0-9]*\) .*/\1/p' $SERVE_LOG)
+THREAD=$(api_pages "conversations.replies?channel=$THREAD_CHANNEL&ts=$THREAD_TS&limit=2")
+REPLY_COUNT=$(echo "$THREAD" | sed -n 's/.*"reply_count":[[:space:]]*\([0-9]*\).*/\1/p' | head -1)
+UNKNOWN=$(curl -s -o /dev/null -w '%{http_code}' "${API}chat.postMessage")
+kill -INT $SERVE_PID
+wait $SERVE_PID
+echo "Served $SERVED_USERS users and $SERVED_MESSAGES of $TOP_LEVEL top-level messages"
+if [ "$SERVED_USERS" -ne 8 ] || [ "$SERVED_MESSAGES" -ne "$TOP_LEVEL" ]; then
+    echo "Error: Paginated listings missed users or messages."
+    exit 1
+fi
+if [ -z "$REPLY_COUNT" ] || [ "$(echo "$THREAD" | grep -c '"parent_user_id":')" -ne "$REPLY_COUNT" ]; then
+    echo "Error: conversations.replies does not match the thread's reply_count."
+    exit 1
+fi
+if [ "$UNKNOWN" != "404" ] || ! grep -q '^Stopped after' $SERVE_LOG; then
+    echo "Error: syngen serve mishandled an unknown method or shutdown."
+    exit 1
+fi
+rm -f $SERVE_LOG
+
 echo "Integration test passed!"
 
 # Clean up